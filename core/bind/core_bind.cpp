@@ -3545,13 +3545,29 @@ Variant JSONParseResult::get_result() const {
 
 void _JSON::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("print", "value", "indent", "sort_keys"), &_JSON::print, DEFVAL(String()), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("print_utf8", "value", "indent", "sort_keys"), &_JSON::print_utf8, DEFVAL(String()), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("parse", "json"), &_JSON::parse);
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json"), &_JSON::parse_utf8);
 }
 
 String _JSON::print(const Variant &p_value, const String &p_indent, bool p_sort_keys) {
 	return JSON::print(p_value, p_indent, p_sort_keys);
 }
 
+PoolVector<uint8_t> _JSON::print_utf8(const Variant &p_value, const String &p_indent, bool p_sort_keys) {
+	JSONWriter writer(p_indent);
+	writer.write_variant(p_value, p_sort_keys);
+
+	const LocalVector<uint8_t> &buffer = writer.get_buffer();
+	PoolVector<uint8_t> ret;
+	ret.resize(buffer.size());
+	if (buffer.size()) {
+		PoolVector<uint8_t>::Write w = ret.write();
+		memcpy(w.ptr(), buffer.ptr(), buffer.size());
+	}
+	return ret;
+}
+
 Ref<JSONParseResult> _JSON::parse(const String &p_json) {
 	Ref<JSONParseResult> result;
 	result.instance();
@@ -3564,6 +3580,19 @@ Ref<JSONParseResult> _JSON::parse(const String &p_json) {
 	return result;
 }
 
+Ref<JSONParseResult> _JSON::parse_utf8(const PoolVector<uint8_t> &p_json) {
+	Ref<JSONParseResult> result;
+	result.instance();
+
+	PoolVector<uint8_t>::Read r = p_json.read();
+	result->error = JSON::parse_utf8(r.ptr(), p_json.size(), result->result, result->error_string, result->error_line);
+
+	if (result->error != OK) {
+		ERR_PRINT(vformat("Error parsing JSON at line %s: %s", result->error_line, result->error_string));
+	}
+	return result;
+}
+
 _JSON *_JSON::singleton = nullptr;
 
 _JSON::_JSON() {
@@ -20,8 +20,7 @@ class PagedAllocator {
 	uint32_t page_size = 0;
 	SpinLock spin_lock;
 
-public:
-	T *alloc() {
+	_FORCE_INLINE_ T *_alloc_mem() {
 		if (thread_safe) {
 			spin_lock.lock();
 		}
@@ -46,20 +45,32 @@ public:
 		if (thread_safe) {
 			spin_lock.unlock();
 		}
+		return alloc;
+	}
+
+public:
+	T *alloc() {
+		T *alloc = _alloc_mem();
 		memnew_placement(alloc, T);
 		return alloc;
 	}
 
+	T *alloc(const T &p_value) {
+		T *alloc = _alloc_mem();
+		memnew_placement(alloc, T(p_value));
+		return alloc;
+	}
+
 	void free(T *p_mem) {
 		if (thread_safe) {
 			spin_lock.lock();
 		}
 		p_mem->~T();
 		available_pool[allocs_available >> page_shift][allocs_available & page_mask] = p_mem;
+		allocs_available++;
 		if (thread_safe) {
 			spin_lock.unlock();
 		}
-		allocs_available++;
 	}
 
 	void reset(bool p_allow_unfreed = false) {
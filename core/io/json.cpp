@@ -4,6 +4,7 @@
 
 #include "json.h"
 
+#include "core/os/file_access.h"
 #include "core/string/print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -19,93 +20,365 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-static String _make_indent(const String &p_indent, int p_size) {
-	String indent_text = "";
-	if (!p_indent.empty()) {
-		for (int i = 0; i < p_size; i++) {
-			indent_text += p_indent;
-		}
+static _FORCE_INLINE_ int _encode_utf8(uint32_t p_code, char *r_dst) {
+	if (p_code < 0x80) {
+		r_dst[0] = p_code;
+		return 1;
+	} else if (p_code < 0x800) {
+		r_dst[0] = 0xC0 | (p_code >> 6);
+		r_dst[1] = 0x80 | (p_code & 0x3F);
+		return 2;
+	} else if (p_code < 0x10000) {
+		r_dst[0] = 0xE0 | (p_code >> 12);
+		r_dst[1] = 0x80 | ((p_code >> 6) & 0x3F);
+		r_dst[2] = 0x80 | (p_code & 0x3F);
+		return 3;
+	} else {
+		r_dst[0] = 0xF0 | ((p_code >> 18) & 0x07);
+		r_dst[1] = 0x80 | ((p_code >> 12) & 0x3F);
+		r_dst[2] = 0x80 | ((p_code >> 6) & 0x3F);
+		r_dst[3] = 0x80 | (p_code & 0x3F);
+		return 4;
 	}
-	return indent_text;
 }
 
-String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, RBSet<const void *> &p_markers) {
-	String colon = ":";
-	String end_statement = "";
+//flush to the file once this much output is buffered
+#define JSON_WRITER_FILE_CHUNK 65536
 
-	if (!p_indent.empty()) {
-		colon += " ";
-		end_statement += "\n";
+void JSONWriter::_write(const char *p_data, int p_len) {
+	uint32_t from = buffer.size();
+	buffer.resize(from + p_len);
+	memcpy(buffer.ptr() + from, p_data, p_len);
+
+	if (file && buffer.size() >= JSON_WRITER_FILE_CHUNK) {
+		flush();
 	}
+}
 
-	switch (p_var.get_type()) {
-		case Variant::NIL:
-			return "null";
-		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
-		case Variant::INT:
-			return itos(p_var);
-		case Variant::REAL:
-			return rtos(p_var);
-		case Variant::POOL_INT_ARRAY:
-		case Variant::POOL_REAL_ARRAY:
-		case Variant::POOL_STRING_ARRAY:
-		case Variant::ARRAY: {
-			String s = "[";
-			s += end_statement;
-			Array a = p_var;
+void JSONWriter::_write_char(char p_char) {
+	buffer.push_back(p_char);
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
-			p_markers.insert(a.id());
+	if (file && buffer.size() >= JSON_WRITER_FILE_CHUNK) {
+		flush();
+	}
+}
 
-			for (int i = 0; i < a.size(); i++) {
-				if (i > 0) {
-					s += ",";
-					s += end_statement;
+void JSONWriter::_write_ascii(const String &p_str) {
+	//numbers only, so no conversion needed
+	const CharType *src = p_str.ptr();
+	int len = p_str.length();
+	uint32_t from = buffer.size();
+	buffer.resize(from + len);
+	uint8_t *dst = buffer.ptr() + from;
+	for (int i = 0; i < len; i++) {
+		dst[i] = src[i];
+	}
+
+	if (file && buffer.size() >= JSON_WRITER_FILE_CHUNK) {
+		flush();
+	}
+}
+
+void JSONWriter::_write_escaped(const String &p_str) {
+	//same escapes as String::json_escape(), encoded straight to UTF-8
+	const CharType *src = p_str.ptr();
+	int len = p_str.length();
+
+	_write_char('"');
+	for (int i = 0; i < len; i++) {
+		CharType c = src[i];
+		switch (c) {
+			case '\\':
+				_write("\\\\", 2);
+				break;
+			case '\b':
+				_write("\\b", 2);
+				break;
+			case '\f':
+				_write("\\f", 2);
+				break;
+			case '\n':
+				_write("\\n", 2);
+				break;
+			case '\r':
+				_write("\\r", 2);
+				break;
+			case '\t':
+				_write("\\t", 2);
+				break;
+			case '\v':
+				_write("\\v", 2);
+				break;
+			case '"':
+				_write("\\\"", 2);
+				break;
+			default: {
+				if (c < 0x80) {
+					buffer.push_back(c);
+				} else {
+					char utf8[4];
+					_write(utf8, _encode_utf8(c, utf8));
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			p_markers.erase(a.id());
-			return s;
-		};
-		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
-			Dictionary d = p_var;
+		}
+	}
+	_write_char('"');
+}
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
-			p_markers.insert(d.id());
+void JSONWriter::_write_line_and_indent(int p_depth) {
+	if (indent.length() == 0) {
+		return;
+	}
+	_write_char('\n');
+	for (int i = 0; i < p_depth; i++) {
+		_write(indent.get_data(), indent.length());
+	}
+}
 
-			List<Variant> keys;
-			d.get_key_list(&keys);
+void JSONWriter::_begin_value() {
+	if (after_key) {
+		after_key = false;
+		return;
+	}
+	if (levels.empty()) {
+		return;
+	}
 
-			if (p_sort_keys) {
-				keys.sort();
+	Level &level = levels[levels.size() - 1];
+	ERR_FAIL_COND_MSG(level.object, "Expected a key before a value inside a JSON object.");
+	if (level.count > 0) {
+		_write_char(',');
+	}
+	level.count++;
+	_write_line_and_indent(levels.size());
+}
+
+void JSONWriter::_begin_container(bool p_object, char p_char) {
+	_begin_value();
+	_write_char(p_char);
+	Level level;
+	level.object = p_object;
+	level.count = 0;
+	levels.push_back(level);
+}
+
+void JSONWriter::_end_container(bool p_object, char p_char) {
+	ERR_FAIL_COND(levels.empty() || levels[levels.size() - 1].object != p_object || after_key);
+	bool empty = levels[levels.size() - 1].count == 0;
+	levels.resize(levels.size() - 1);
+	if (empty && indent.length()) {
+		//empty containers still get an empty line, as JSON::print() always did
+		_write_char('\n');
+	}
+	_write_line_and_indent(levels.size());
+	_write_char(p_char);
+}
+
+void JSONWriter::begin_object() {
+	_begin_container(true, '{');
+}
+
+void JSONWriter::end_object() {
+	_end_container(true, '}');
+}
+
+void JSONWriter::begin_array() {
+	_begin_container(false, '[');
+}
+
+void JSONWriter::end_array() {
+	_end_container(false, ']');
+}
+
+void JSONWriter::key(const String &p_key) {
+	ERR_FAIL_COND_MSG(levels.empty() || !levels[levels.size() - 1].object || after_key, "A JSON key can only be written inside an object.");
+	Level &level = levels[levels.size() - 1];
+	if (level.count > 0) {
+		_write_char(',');
+	}
+	level.count++;
+	_write_line_and_indent(levels.size());
+	_write_escaped(p_key);
+	if (indent.length()) {
+		_write(": ", 2);
+	} else {
+		_write_char(':');
+	}
+	after_key = true;
+}
+
+void JSONWriter::write_null() {
+	_begin_value();
+	_write("null", 4);
+}
+
+void JSONWriter::write_bool(bool p_value) {
+	_begin_value();
+	if (p_value) {
+		_write("true", 4);
+	} else {
+		_write("false", 5);
+	}
+}
+
+void JSONWriter::write_int(int64_t p_value) {
+	_begin_value();
+
+	char digits[24];
+	int pos = sizeof(digits);
+	uint64_t value = p_value < 0 ? -(uint64_t)p_value : p_value;
+	do {
+		digits[--pos] = '0' + (value % 10);
+		value /= 10;
+	} while (value);
+	if (p_value < 0) {
+		digits[--pos] = '-';
+	}
+	_write(digits + pos, sizeof(digits) - pos);
+}
+
+void JSONWriter::write_real(double p_value) {
+	_begin_value();
+	_write_ascii(rtos(p_value));
+}
+
+void JSONWriter::write_string(const String &p_value) {
+	_begin_value();
+	_write_escaped(p_value);
+}
+
+void JSONWriter::write_variant(const Variant &p_value, bool p_sort_keys) {
+	switch (p_value.get_type()) {
+		case Variant::NIL: {
+			write_null();
+		} break;
+		case Variant::BOOL: {
+			write_bool(p_value);
+		} break;
+		case Variant::INT: {
+			write_int(p_value);
+		} break;
+		case Variant::REAL: {
+			write_real(p_value);
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			PoolVector<int> array = p_value;
+			PoolVector<int>::Read r = array.read();
+			begin_array();
+			for (int i = 0; i < array.size(); i++) {
+				write_int(r[i]);
+			}
+			end_array();
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			PoolVector<real_t> array = p_value;
+			PoolVector<real_t>::Read r = array.read();
+			begin_array();
+			for (int i = 0; i < array.size(); i++) {
+				write_real(r[i]);
+			}
+			end_array();
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+			PoolVector<String> array = p_value;
+			PoolVector<String>::Read r = array.read();
+			begin_array();
+			for (int i = 0; i < array.size(); i++) {
+				write_string(r[i]);
 			}
+			end_array();
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			if (markers.find(array.id()) != -1) {
+				write_string("[...]");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			markers.push_back(array.id());
 
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-				if (E != keys.front()) {
-					s += ",";
-					s += end_statement;
+			begin_array();
+			for (int i = 0; i < array.size(); i++) {
+				write_variant(array[i], p_sort_keys);
+			}
+			end_array();
+
+			markers.resize(markers.size() - 1);
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			if (markers.find(dict.id()) != -1) {
+				write_string("{...}");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			markers.push_back(dict.id());
+
+			begin_object();
+			if (p_sort_keys) {
+				LocalVector<Variant> keys;
+				keys.reserve(dict.size());
+				for (const Variant *k = dict.next(); k; k = dict.next(k)) {
+					keys.push_back(*k);
+				}
+				keys.sort();
+				for (uint32_t i = 0; i < keys.size(); i++) {
+					key(keys[i]);
+					write_variant(*dict.getptr(keys[i]), p_sort_keys);
+				}
+			} else {
+				for (const Variant *k = dict.next(); k; k = dict.next(k)) {
+					key(*k);
+					write_variant(*dict.getptr(*k), p_sort_keys);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _print_var(d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
+			end_object();
+
+			markers.resize(markers.size() - 1);
+		} break;
+		default: {
+			write_string(p_value);
+		}
+	}
+}
+
+String JSONWriter::get_string() const {
+	return String::utf8((const char *)buffer.ptr(), buffer.size());
+}
+
+void JSONWriter::clear() {
+	buffer.clear();
+	levels.clear();
+	markers.clear();
+	after_key = false;
+}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			p_markers.erase(d.id());
-			return s;
-		};
-		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+void JSONWriter::flush() {
+	if (!file || buffer.empty()) {
+		return;
 	}
+	file->store_buffer(buffer.ptr(), buffer.size());
+	buffer.clear();
+}
+
+JSONWriter::JSONWriter(const String &p_indent) {
+	file = nullptr;
+	indent = p_indent.utf8();
+	after_key = false;
+}
+
+JSONWriter::JSONWriter(FileAccess *p_file, const String &p_indent) {
+	file = p_file;
+	indent = p_indent.utf8();
+	after_key = false;
+}
+
+JSONWriter::~JSONWriter() {
+	flush();
 }
 
 String JSON::print(const Variant &p_var, const String &p_indent, bool p_sort_keys) {
-	RBSet<const void *> markers;
-	return _print_var(p_var, p_indent, 0, p_sort_keys, markers);
+	JSONWriter writer(p_indent);
+	writer.write_variant(p_var, p_sort_keys);
+	return writer.get_string();
 }
 
 Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
@@ -452,3 +725,426 @@ Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &
 
 	return err;
 }
+
+// Tokenizer of the UTF-8 parser, same tokens and leniency as _get_token().
+struct JSONUTF8Reader {
+	const uint8_t *ptr;
+	const uint8_t *end;
+	int line;
+	LocalVector<char> scratch;
+
+	static _FORCE_INLINE_ int _hex_value(uint8_t p_char) {
+		if (p_char >= '0' && p_char <= '9') {
+			return p_char - '0';
+		} else if (p_char >= 'a' && p_char <= 'f') {
+			return p_char - 'a' + 10;
+		} else if (p_char >= 'A' && p_char <= 'F') {
+			return p_char - 'A' + 10;
+		}
+		return -1;
+	}
+
+	Error _parse_hex(uint32_t &r_code, String &r_err_str) {
+		r_code = 0;
+		for (int j = 0; j < 4; j++) {
+			if (ptr + j >= end || ptr[j] == 0) {
+				r_err_str = "Unterminated String";
+				return ERR_PARSE_ERROR;
+			}
+			int v = _hex_value(ptr[j]);
+			if (v < 0) {
+				r_err_str = "Malformed hex constant in string";
+				return ERR_PARSE_ERROR;
+			}
+			r_code = (r_code << 4) | v;
+		}
+		ptr += 4;
+		return OK;
+	}
+
+	Error _parse_string(String &r_str, String &r_err_str) {
+		const uint8_t *start = ptr;
+
+		//fast path, strings without escapes are decoded in place
+		while (ptr < end && *ptr != '"' && *ptr != '\\' && *ptr != 0) {
+			if (*ptr == '\n') {
+				line++;
+			}
+			ptr++;
+		}
+		if (ptr < end && *ptr == '"') {
+			if (r_str.parse_utf8((const char *)start, ptr - start) != OK) {
+				r_err_str = "Invalid UTF-8 in string";
+				return ERR_PARSE_ERROR;
+			}
+			ptr++;
+			return OK;
+		}
+
+		scratch.resize(ptr - start);
+		memcpy(scratch.ptr(), start, ptr - start);
+
+		while (true) {
+			if (ptr >= end || *ptr == 0) {
+				r_err_str = "Unterminated String";
+				return ERR_PARSE_ERROR;
+			}
+			uint8_t c = *ptr;
+			ptr++;
+
+			if (c == '"') {
+				break;
+			} else if (c != '\\') {
+				if (c == '\n') {
+					line++;
+				}
+				scratch.push_back(c);
+				continue;
+			}
+
+			//escaped characters...
+			if (ptr >= end || *ptr == 0) {
+				r_err_str = "Unterminated String";
+				return ERR_PARSE_ERROR;
+			}
+			uint8_t next = *ptr;
+			ptr++;
+
+			switch (next) {
+				case 'b':
+					scratch.push_back(8);
+					break;
+				case 't':
+					scratch.push_back(9);
+					break;
+				case 'n':
+					scratch.push_back(10);
+					break;
+				case 'f':
+					scratch.push_back(12);
+					break;
+				case 'r':
+					scratch.push_back(13);
+					break;
+				case 'u': {
+					uint32_t code;
+					Error err = _parse_hex(code, r_err_str);
+					if (err != OK) {
+						return err;
+					}
+					if (code >= 0xD800 && code <= 0xDBFF) {
+						//surrogate pair, combined into a single code point
+						uint32_t low = 0;
+						String unused;
+						if (end - ptr >= 6 && ptr[0] == '\\' && ptr[1] == 'u') {
+							const uint8_t *pair = ptr;
+							ptr += 2;
+							if (_parse_hex(low, unused) != OK || low < 0xDC00 || low > 0xDFFF) {
+								ptr = pair;
+								low = 0;
+							}
+						}
+						code = low ? 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00) : 0xFFFD;
+					} else if (code >= 0xDC00 && code <= 0xDFFF) {
+						code = 0xFFFD;
+					}
+
+					char utf8[4];
+					int len = _encode_utf8(code, utf8);
+					for (int j = 0; j < len; j++) {
+						scratch.push_back(utf8[j]);
+					}
+				} break;
+				default: {
+					scratch.push_back(next);
+				} break;
+			}
+		}
+
+		if (r_str.parse_utf8(scratch.ptr(), scratch.size()) != OK) {
+			r_err_str = "Invalid UTF-8 in string";
+			return ERR_PARSE_ERROR;
+		}
+		return OK;
+	}
+
+	Error get_token(JSON::Token &r_token, String &r_err_str) {
+		while (true) {
+			if (ptr >= end || *ptr == 0) {
+				r_token.type = JSON::TK_EOF;
+				return OK;
+			}
+
+			switch (*ptr) {
+				case '\n': {
+					line++;
+					ptr++;
+				} break;
+				case '{': {
+					r_token.type = JSON::TK_CURLY_BRACKET_OPEN;
+					ptr++;
+					return OK;
+				};
+				case '}': {
+					r_token.type = JSON::TK_CURLY_BRACKET_CLOSE;
+					ptr++;
+					return OK;
+				};
+				case '[': {
+					r_token.type = JSON::TK_BRACKET_OPEN;
+					ptr++;
+					return OK;
+				};
+				case ']': {
+					r_token.type = JSON::TK_BRACKET_CLOSE;
+					ptr++;
+					return OK;
+				};
+				case ':': {
+					r_token.type = JSON::TK_COLON;
+					ptr++;
+					return OK;
+				};
+				case ',': {
+					r_token.type = JSON::TK_COMMA;
+					ptr++;
+					return OK;
+				};
+				case '"': {
+					ptr++;
+					String str;
+					Error err = _parse_string(str, r_err_str);
+					if (err != OK) {
+						return err;
+					}
+					r_token.type = JSON::TK_STRING;
+					r_token.value = str;
+					return OK;
+				};
+				default: {
+					uint8_t c = *ptr;
+					if (c <= 32) {
+						ptr++;
+						break;
+					}
+
+					if (c == '-' || (c >= '0' && c <= '9')) {
+						//a number, copied so it can be null terminated for to_double()
+						const uint8_t *start = ptr;
+						while (ptr < end && ((*ptr >= '0' && *ptr <= '9') || *ptr == '-' || *ptr == '+' || *ptr == '.' || *ptr == 'e' || *ptr == 'E')) {
+							ptr++;
+						}
+						scratch.resize(ptr - start + 1);
+						memcpy(scratch.ptr(), start, ptr - start);
+						scratch[ptr - start] = 0;
+
+						r_token.type = JSON::TK_NUMBER;
+						r_token.value = String::to_double(scratch.ptr());
+						return OK;
+
+					} else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+						const uint8_t *start = ptr;
+						while (ptr < end && ((*ptr >= 'A' && *ptr <= 'Z') || (*ptr >= 'a' && *ptr <= 'z'))) {
+							ptr++;
+						}
+
+						r_token.type = JSON::TK_IDENTIFIER;
+						r_token.value = String::utf8((const char *)start, ptr - start);
+						return OK;
+					} else {
+						r_err_str = "Unexpected character.";
+						return ERR_PARSE_ERROR;
+					}
+				}
+			}
+		}
+	}
+};
+
+Error JSON::parse_utf8(const uint8_t *p_data, int p_len, Handler *p_handler, String &r_err_str, int &r_err_line) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_len < 0, ERR_INVALID_PARAMETER);
+
+	JSONUTF8Reader reader;
+	reader.ptr = p_data;
+	reader.end = p_data + p_len;
+	reader.line = 0;
+
+	//skip the byte order mark, if any
+	if (p_len >= 3 && p_data[0] == 0xEF && p_data[1] == 0xBB && p_data[2] == 0xBF) {
+		reader.ptr += 3;
+	}
+
+	enum State {
+		STATE_VALUE,
+		STATE_KEY,
+		STATE_COLON,
+		STATE_NEXT,
+	};
+
+	//one entry per open container, true for objects
+	LocalVector<bool> stack;
+	State state = STATE_VALUE;
+	Token token;
+	Error err = OK;
+
+	while (true) {
+		err = reader.get_token(token, r_err_str);
+		if (err != OK) {
+			break;
+		}
+
+		bool in_object = !stack.empty() && stack[stack.size() - 1];
+		bool close = false;
+
+		switch (state) {
+			case STATE_VALUE: {
+				if (token.type == TK_BRACKET_CLOSE && !stack.empty() && !in_object) {
+					close = true;
+				} else if (token.type == TK_CURLY_BRACKET_OPEN) {
+					err = p_handler->begin_object();
+					stack.push_back(true);
+					state = STATE_KEY;
+				} else if (token.type == TK_BRACKET_OPEN) {
+					err = p_handler->begin_array();
+					stack.push_back(false);
+				} else if (token.type == TK_IDENTIFIER) {
+					String id = token.value;
+					if (id == "true") {
+						err = p_handler->value(true);
+					} else if (id == "false") {
+						err = p_handler->value(false);
+					} else if (id == "null") {
+						err = p_handler->value(Variant());
+					} else {
+						r_err_str = "Expected 'true','false' or 'null', got '" + id + "'.";
+						err = ERR_PARSE_ERROR;
+					}
+					state = STATE_NEXT;
+				} else if (token.type == TK_NUMBER || token.type == TK_STRING) {
+					err = p_handler->value(token.value);
+					state = STATE_NEXT;
+				} else {
+					r_err_str = "Expected value, got " + String(tk_name[token.type]) + ".";
+					err = ERR_PARSE_ERROR;
+				}
+			} break;
+			case STATE_KEY: {
+				if (token.type == TK_CURLY_BRACKET_CLOSE) {
+					close = true;
+				} else if (token.type == TK_STRING) {
+					err = p_handler->key(token.value);
+					state = STATE_COLON;
+				} else {
+					r_err_str = "Expected key";
+					err = ERR_PARSE_ERROR;
+				}
+			} break;
+			case STATE_COLON: {
+				if (token.type == TK_COLON) {
+					state = STATE_VALUE;
+				} else {
+					r_err_str = "Expected ':'";
+					err = ERR_PARSE_ERROR;
+				}
+			} break;
+			case STATE_NEXT: {
+				if (stack.empty()) {
+					if (token.type != TK_EOF) {
+						r_err_str = "Expected 'EOF'";
+						err = ERR_PARSE_ERROR;
+					}
+					r_err_line = reader.line;
+					return err;
+				}
+
+				if (token.type == TK_COMMA) {
+					state = in_object ? STATE_KEY : STATE_VALUE;
+				} else if (token.type == (in_object ? TK_CURLY_BRACKET_CLOSE : TK_BRACKET_CLOSE)) {
+					close = true;
+				} else {
+					r_err_str = in_object ? "Expected '}' or ','" : "Expected ','";
+					err = ERR_PARSE_ERROR;
+				}
+			} break;
+		}
+
+		if (close) {
+			err = in_object ? p_handler->end_object() : p_handler->end_array();
+			stack.resize(stack.size() - 1);
+			state = STATE_NEXT;
+		}
+
+		if (err != OK) {
+			break;
+		}
+	}
+
+	r_err_line = reader.line;
+	return err;
+}
+
+// Builds the same Variant tree as parse() from the streaming events.
+class JSONVariantBuilder : public JSON::Handler {
+	LocalVector<bool> stack;
+	LocalVector<Array> arrays;
+	LocalVector<Dictionary> dicts;
+	String pending_key;
+
+	void _add(const Variant &p_value) {
+		if (stack.empty()) {
+			root = p_value;
+		} else if (stack[stack.size() - 1]) {
+			dicts[dicts.size() - 1][pending_key] = p_value;
+		} else {
+			arrays[arrays.size() - 1].push_back(p_value);
+		}
+	}
+
+public:
+	Variant root;
+
+	virtual Error begin_object() {
+		Dictionary d;
+		_add(d);
+		dicts.push_back(d);
+		stack.push_back(true);
+		return OK;
+	}
+	virtual Error end_object() {
+		dicts.resize(dicts.size() - 1);
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error begin_array() {
+		Array a;
+		_add(a);
+		arrays.push_back(a);
+		stack.push_back(false);
+		return OK;
+	}
+	virtual Error end_array() {
+		arrays.resize(arrays.size() - 1);
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error key(const String &p_key) {
+		pending_key = p_key;
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) {
+		_add(p_value);
+		return OK;
+	}
+};
+
+Error JSON::parse_utf8(const uint8_t *p_data, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONVariantBuilder builder;
+	Error err = parse_utf8(p_data, p_len, &builder, r_err_str, r_err_line);
+	if (err != OK) {
+		r_ret = Variant();
+		return err;
+	}
+	r_ret = builder.root;
+	return OK;
+}
@@ -4,9 +4,14 @@
 /*  json.h                                                               */
 
 
+#include "core/containers/local_vector.h"
 #include "core/variant/variant.h"
 
+class FileAccess;
+
 class JSON {
+	friend struct JSONUTF8Reader;
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -36,16 +41,84 @@ class JSON {
 
 	static const char *tk_name[TK_MAX];
 
-	static String _print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, RBSet<const void *> &p_markers);
-
 	static Error _get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
 	static Error _parse_array(Array &array, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
 	static Error _parse_object(Dictionary &object, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
 
 public:
+	// Receives the events of the streaming parser, in document order.
+	// Returning anything but OK from a callback stops parsing with that error.
+	class Handler {
+	public:
+		virtual Error begin_object() = 0;
+		virtual Error end_object() = 0;
+		virtual Error begin_array() = 0;
+		virtual Error end_array() = 0;
+		virtual Error key(const String &p_key) = 0;
+		// Scalars: null, bool, number (always REAL, like parse()) or String.
+		virtual Error value(const Variant &p_value) = 0;
+
+		virtual ~Handler() {}
+	};
+
 	static String print(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true);
 	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+
+	// Parse UTF-8 input directly, without converting it to a String first.
+	static Error parse_utf8(const uint8_t *p_data, int p_len, Handler *p_handler, String &r_err_str, int &r_err_line);
+	static Error parse_utf8(const uint8_t *p_data, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
+};
+
+// Writes JSON as UTF-8 into a growable buffer, or streams it to a file.
+// Formatting matches JSON::print(), which is implemented with it.
+class JSONWriter {
+	struct Level {
+		bool object;
+		int count;
+	};
+
+	LocalVector<uint8_t> buffer;
+	FileAccess *file;
+	CharString indent;
+	LocalVector<Level> levels;
+	bool after_key;
+	LocalVector<const void *> markers;
+
+	void _write(const char *p_data, int p_len);
+	void _write_char(char p_char);
+	void _write_ascii(const String &p_str);
+	void _write_escaped(const String &p_str);
+	void _write_line_and_indent(int p_depth);
+	void _begin_value();
+	void _begin_container(bool p_object, char p_char);
+	void _end_container(bool p_object, char p_char);
+
+public:
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+	void key(const String &p_key);
+
+	void write_null();
+	void write_bool(bool p_value);
+	void write_int(int64_t p_value);
+	void write_real(double p_value);
+	void write_string(const String &p_value);
+	void write_variant(const Variant &p_value, bool p_sort_keys = true);
+
+	// Only meaningful when not streaming to a file.
+	const LocalVector<uint8_t> &get_buffer() const { return buffer; }
+	String get_string() const;
+	void clear();
+
+	// Write buffered output to the file, this is also done when the writer is destroyed.
+	void flush();
+
+	JSONWriter(const String &p_indent = "");
+	JSONWriter(FileAccess *p_file, const String &p_indent = "");
+	~JSONWriter();
 };
 
 #endif // JSON_H
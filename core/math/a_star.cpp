@@ -32,11 +32,10 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		pt->index = point_list.size();
 		points.set(p_id, pt);
+		point_list.push_back(pt);
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
@@ -97,6 +96,12 @@ void AStar::remove_point(int p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	// Keep point_list dense, the last point takes the removed one's place.
+	Point *last = point_list[point_list.size() - 1];
+	point_list[p->index] = last;
+	last->index = p->index;
+	point_list.resize(point_list.size() - 1);
+
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -223,6 +228,7 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_list.clear();
 }
 
 int AStar::get_point_count() const {
@@ -237,6 +243,7 @@ void AStar::reserve_space(int p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, vformat("New capacity must be greater than 0, new was: %d.", p_num_nodes));
 	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < points.get_capacity(), vformat("New capacity must be greater than current capacity: %d, new was: %d.", points.get_capacity(), p_num_nodes));
 	points.reserve(p_num_nodes);
+	point_list.reserve(p_num_nodes);
 }
 
 int AStar::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
@@ -293,66 +300,123 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
-	pass++;
+AStar::SearchState *AStar::_begin_search() {
+	SearchState *state;
+	{
+		MutexLock lock(search_states_mutex);
+		if (free_search_states.size()) {
+			state = free_search_states[free_search_states.size() - 1];
+			free_search_states.resize(free_search_states.size() - 1);
+		} else {
+			state = memnew(SearchState);
+			state->pass = 0;
+		}
+	}
+
+	uint32_t old_size = state->nodes.size();
+	if (old_size < point_list.size()) {
+		state->nodes.resize(point_list.size());
+		for (uint32_t i = old_size; i < state->nodes.size(); i++) {
+			state->nodes[i].open_pass = 0;
+			state->nodes[i].closed_pass = 0;
+		}
+	}
+
+	state->pass++;
+	if (state->pass == 0) { // Wrapped around, old marks could be mistaken for the new pass.
+		for (uint32_t i = 0; i < state->nodes.size(); i++) {
+			state->nodes[i].open_pass = 0;
+			state->nodes[i].closed_pass = 0;
+		}
+		state->pass = 1;
+	}
+
+	return state;
+}
+
+void AStar::_end_search(SearchState *p_state) {
+	MutexLock lock(search_states_mutex);
+	free_search_states.push_back(p_state);
+}
 
+template <class T>
+bool AStar::_solve(T *p_costs, SearchState &r_state, Point *begin_point, Point *end_point) {
 	if (!end_point->enabled) {
 		return false;
 	}
 
-	bool found_route = false;
+	// Only go through the (virtual, possibly scripted) cost methods when a script or a C++ subclass may override them.
+	bool native_override = p_costs->get_class_name() != StringName(T::get_class_static());
+	ScriptInstance *script = p_costs->get_script_instance();
+	bool custom_estimate = native_override || (script && script->has_method(SceneStringNames::get_singleton()->_estimate_cost));
+	bool custom_compute = native_override || (script && script->has_method(SceneStringNames::get_singleton()->_compute_cost));
+
+	uint32_t pass = r_state.pass;
+	SearchNode *nodes = r_state.nodes.ptr();
+	LocalVector<OpenEntry> &open_list = r_state.open_list;
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	open_list.clear();
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	SearchNode &begin_node = nodes[begin_point->index];
+	begin_node.prev_point = nullptr;
+	begin_node.g_score = 0;
+	begin_node.open_pass = pass;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	OpenEntry begin_entry;
+	begin_entry.point = begin_point;
+	begin_entry.g_score = 0;
+	begin_entry.f_score = custom_estimate ? p_costs->_estimate_cost(begin_point->id, end_point->id) : begin_point->pos.distance_to(end_point->pos);
+	open_list.push_back(begin_entry);
 
 	while (!open_list.empty()) {
-		Point *p = open_list[0]; // The currently processed point
+		OpenEntry current = open_list[0]; // The currently processed point
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list
+		open_list.resize(open_list.size() - 1);
+
+		Point *p = current.point;
+		SearchNode &p_node = nodes[p->index];
+
+		// Points are pushed again when a better path to them is found, instead of being
+		// moved inside the heap, so skip the outdated entries.
+		if (p_node.closed_pass == pass || current.g_score > p_node.g_score) {
+			continue;
+		}
 
 		if (p == end_point) {
-			found_route = true;
-			break;
+			return true;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed
+		p_node.closed_pass = pass; // Mark the point as closed
 
 		for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
 			Point *e = *(it.value); // The neighbour point
+			SearchNode &e_node = nodes[e->index];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || e_node.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
+			real_t cost = custom_compute ? p_costs->_compute_cost(p->id, e->id) : p->pos.distance_to(e->pos);
+			real_t tentative_g_score = p_node.g_score + cost * e->weight_scale;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			if (e_node.open_pass == pass && tentative_g_score >= e_node.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
+			e_node.open_pass = pass;
+			e_node.prev_point = p;
+			e_node.g_score = tentative_g_score;
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
+			OpenEntry entry;
+			entry.point = e;
+			entry.g_score = tentative_g_score;
+			entry.f_score = tentative_g_score + (custom_estimate ? p_costs->_estimate_cost(e->id, end_point->id) : e->pos.distance_to(end_point->pos));
+			open_list.push_back(entry);
+			sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
 		}
 	}
 
-	return found_route;
+	return false;
 }
 
 real_t AStar::_estimate_cost(int p_from_id, int p_to_id) {
@@ -405,16 +469,19 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchState *state = _begin_search();
+	bool found_route = _solve(this, *state, begin_point, end_point);
 	if (!found_route) {
+		_end_search(state);
 		return PoolVector<Vector3>();
 	}
+	const SearchNode *nodes = state->nodes.ptr();
 
 	Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = nodes[p->index].prev_point;
 	}
 
 	PoolVector<Vector3> path;
@@ -427,12 +494,13 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			p2 = nodes[p2->index].prev_point;
 		}
 
 		w[0] = p2->pos; // Assign first
 	}
 
+	_end_search(state);
 	return path;
 }
 
@@ -454,16 +522,19 @@ PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchState *state = _begin_search();
+	bool found_route = _solve(this, *state, begin_point, end_point);
 	if (!found_route) {
+		_end_search(state);
 		return PoolVector<int>();
 	}
+	const SearchNode *nodes = state->nodes.ptr();
 
 	Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = nodes[p->index].prev_point;
 	}
 
 	PoolVector<int> path;
@@ -476,12 +547,13 @@ PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = nodes[p->index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
 	}
 
+	_end_search(state);
 	return path;
 }
 
@@ -537,11 +609,13 @@ void AStar::_bind_methods() {
 
 AStar::AStar() {
 	last_free_id = 0;
-	pass = 1;
 }
 
 AStar::~AStar() {
 	clear();
+	for (uint32_t i = 0; i < free_search_states.size(); i++) {
+		memdelete(free_search_states[i]);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -682,16 +756,19 @@ PoolVector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 	AStar::Point *begin_point = a;
 	AStar::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchState *state = astar._begin_search();
+	bool found_route = astar._solve(this, *state, begin_point, end_point);
 	if (!found_route) {
+		astar._end_search(state);
 		return PoolVector<Vector2>();
 	}
+	const AStar::SearchNode *nodes = state->nodes.ptr();
 
 	AStar::Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = nodes[p->index].prev_point;
 	}
 
 	PoolVector<Vector2> path;
@@ -704,12 +781,13 @@ PoolVector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+			p2 = nodes[p2->index].prev_point;
 		}
 
 		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
 	}
 
+	astar._end_search(state);
 	return path;
 }
 
@@ -731,16 +809,19 @@ PoolVector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 	AStar::Point *begin_point = a;
 	AStar::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchState *state = astar._begin_search();
+	bool found_route = astar._solve(this, *state, begin_point, end_point);
 	if (!found_route) {
+		astar._end_search(state);
 		return PoolVector<int>();
 	}
+	const AStar::SearchNode *nodes = state->nodes.ptr();
 
 	AStar::Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = nodes[p->index].prev_point;
 	}
 
 	PoolVector<int> path;
@@ -753,77 +834,16 @@ PoolVector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = nodes[p->index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
 	}
 
+	astar._end_search(state);
 	return path;
 }
 
-bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
-	astar.pass++;
-
-	if (!end_point->enabled) {
-		return false;
-	}
-
-	bool found_route = false;
-
-	Vector<AStar::Point *> open_list;
-	SortArray<AStar::Point *, AStar::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.empty()) {
-		AStar::Point *p = open_list[0]; // The currently processed point
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed
-
-		for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-			AStar::Point *e = *(it.value); // The neighbour point
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
-		}
-	}
-
-	return found_route;
-}
-
 void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_available_point_id"), &AStar2D::get_available_point_id);
 	ClassDB::bind_method(D_METHOD("add_point", "id", "position", "weight_scale"), &AStar2D::add_point, DEFVAL(1.0));
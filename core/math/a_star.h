@@ -4,8 +4,10 @@
 /*  a_star.h                                                             */
 
 
+#include "core/containers/local_vector.h"
 #include "core/containers/oa_hash_map.h"
 #include "core/object/reference.h"
+#include "core/os/mutex.h"
 
 /**
 	A* pathfinding algorithm
@@ -23,33 +25,48 @@ class AStar : public Reference {
 				unlinked_neighbours(4u) {}
 
 		int id;
+		uint32_t index; // Position in point_list, used to find the point's search node.
 		Vector3 pos;
 		real_t weight_scale;
 		bool enabled;
 
 		OAHashMap<int, Point *> neighbours;
 		OAHashMap<int, Point *> unlinked_neighbours;
+	};
 
-		// Used for pathfinding.
+	// Pathfinding state of a point, kept per query instead of inside the shared points,
+	// so that path queries don't write to the graph and can run concurrently.
+	struct SearchNode {
 		Point *prev_point;
 		real_t g_score;
+		uint32_t open_pass;
+		uint32_t closed_pass;
+	};
+
+	struct OpenEntry {
+		Point *point;
 		real_t f_score;
-		uint64_t open_pass;
-		uint64_t closed_pass;
+		real_t g_score;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+	struct SortOpenEntries {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const { // Returns true when the entry A is worse than entry B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	struct SearchState {
+		LocalVector<SearchNode> nodes; // Indexed by Point::index.
+		LocalVector<OpenEntry> open_list;
+		uint32_t pass;
+	};
+
 	struct Segment {
 		union {
 			struct {
@@ -86,12 +103,19 @@ class AStar : public Reference {
 	};
 
 	int last_free_id;
-	uint64_t pass;
 
 	OAHashMap<int, Point *> points;
+	LocalVector<Point *> point_list;
 	RBSet<Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	Mutex search_states_mutex;
+	LocalVector<SearchState *> free_search_states;
+
+	SearchState *_begin_search();
+	void _end_search(SearchState *p_state);
+
+	template <class T>
+	bool _solve(T *p_costs, SearchState &r_state, Point *begin_point, Point *end_point);
 
 protected:
 	static void _bind_methods();
@@ -136,9 +160,9 @@ public:
 
 class AStar2D : public Reference {
 	GDCLASS(AStar2D, Reference);
-	AStar astar;
+	friend class AStar;
 
-	bool _solve(AStar::Point *begin_point, AStar::Point *end_point);
+	AStar astar;
 
 protected:
 	static void _bind_methods();
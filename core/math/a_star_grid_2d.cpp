@@ -0,0 +1,559 @@
+
+/*  a_star_grid_2d.cpp                                                   */
+
+
+#include "a_star_grid_2d.h"
+
+#include "core/containers/sort_array.h"
+
+static _FORCE_INLINE_ int _sign(int p_value) {
+	return (p_value > 0) - (p_value < 0);
+}
+
+bool AStarGrid2D::_can_move(int p_x, int p_y, int p_dx, int p_dy) const {
+	if (!_is_walkable(p_x + p_dx, p_y + p_dy)) {
+		return false;
+	}
+	if (!p_dx || !p_dy) {
+		return true;
+	}
+
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+			return true;
+		case DIAGONAL_MODE_NEVER:
+			return false;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+			return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES:
+			return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+		default:
+			return false;
+	}
+}
+
+real_t AStarGrid2D::_estimate(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const {
+	real_t dx = ABS(p_to_x - p_from_x) * cell_size.x;
+	real_t dy = ABS(p_to_y - p_from_y) * cell_size.y;
+
+	switch (default_heuristic) {
+		case HEURISTIC_MANHATTAN:
+			return dx + dy;
+		case HEURISTIC_OCTILE: {
+			static const real_t F = Math_SQRT2 - 1;
+			return (dx < dy) ? F * dx + dy : F * dy + dx;
+		}
+		case HEURISTIC_CHEBYSHEV:
+			return MAX(dx, dy);
+		default:
+			return Math::sqrt(dx * dx + dy * dy);
+	}
+}
+
+real_t AStarGrid2D::_compute_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const {
+	return Vector2((p_to_x - p_from_x) * cell_size.x, (p_to_y - p_from_y) * cell_size.y).length();
+}
+
+// Jump point search, for grids where diagonal moves can't cut corners
+// (DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES). Walks from (p_x, p_y) in direction (p_dx, p_dy)
+// until it reaches the end, a cell with a forced neighbour, or an obstacle.
+bool AStarGrid2D::_jump(int p_x, int p_y, int p_dx, int p_dy, int p_end_x, int p_end_y, int &r_x, int &r_y) const {
+	int x = p_x;
+	int y = p_y;
+
+	while (true) {
+		if (!_is_walkable(x, y)) {
+			return false;
+		}
+
+		bool jump_point = x == p_end_x && y == p_end_y;
+		if (!jump_point) {
+			if (p_dx && p_dy) {
+				// A diagonal move stops where a straight move from it would find a jump point.
+				int jx, jy;
+				jump_point = _jump(x + p_dx, y, p_dx, 0, p_end_x, p_end_y, jx, jy) || _jump(x, y + p_dy, 0, p_dy, p_end_x, p_end_y, jx, jy);
+			} else if (p_dx) {
+				jump_point = (_is_walkable(x, y - 1) && !_is_walkable(x - p_dx, y - 1)) || (_is_walkable(x, y + 1) && !_is_walkable(x - p_dx, y + 1));
+			} else {
+				jump_point = (_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - p_dy)) || (_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - p_dy));
+			}
+		}
+
+		if (jump_point) {
+			r_x = x;
+			r_y = y;
+			return true;
+		}
+
+		if (!_is_walkable(x + p_dx, y) || !_is_walkable(x, y + p_dy)) {
+			return false;
+		}
+		x += p_dx;
+		y += p_dy;
+	}
+}
+
+// Neighbours worth jumping to, given the direction the cell was reached from (zero for the start).
+int AStarGrid2D::_get_jump_neighbours(int p_x, int p_y, int p_dx, int p_dy, Vector2i *r_neighbours) const {
+	int count = 0;
+
+	if (!p_dx && !p_dy) {
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				if ((dx || dy) && _is_walkable(p_x + dx, p_y + dy) && (!dx || !dy || (_is_walkable(p_x + dx, p_y) && _is_walkable(p_x, p_y + dy)))) {
+					r_neighbours[count++] = Vector2i(p_x + dx, p_y + dy);
+				}
+			}
+		}
+	} else if (p_dx && p_dy) {
+		bool vertical = _is_walkable(p_x, p_y + p_dy);
+		bool horizontal = _is_walkable(p_x + p_dx, p_y);
+		if (vertical) {
+			r_neighbours[count++] = Vector2i(p_x, p_y + p_dy);
+		}
+		if (horizontal) {
+			r_neighbours[count++] = Vector2i(p_x + p_dx, p_y);
+		}
+		if (vertical && horizontal) {
+			r_neighbours[count++] = Vector2i(p_x + p_dx, p_y + p_dy);
+		}
+	} else if (p_dx) {
+		bool next = _is_walkable(p_x + p_dx, p_y);
+		bool top = _is_walkable(p_x, p_y + 1);
+		bool bottom = _is_walkable(p_x, p_y - 1);
+		if (next) {
+			r_neighbours[count++] = Vector2i(p_x + p_dx, p_y);
+			if (top) {
+				r_neighbours[count++] = Vector2i(p_x + p_dx, p_y + 1);
+			}
+			if (bottom) {
+				r_neighbours[count++] = Vector2i(p_x + p_dx, p_y - 1);
+			}
+		}
+		if (top) {
+			r_neighbours[count++] = Vector2i(p_x, p_y + 1);
+		}
+		if (bottom) {
+			r_neighbours[count++] = Vector2i(p_x, p_y - 1);
+		}
+	} else {
+		bool next = _is_walkable(p_x, p_y + p_dy);
+		bool right = _is_walkable(p_x + 1, p_y);
+		bool left = _is_walkable(p_x - 1, p_y);
+		if (next) {
+			r_neighbours[count++] = Vector2i(p_x, p_y + p_dy);
+			if (right) {
+				r_neighbours[count++] = Vector2i(p_x + 1, p_y + p_dy);
+			}
+			if (left) {
+				r_neighbours[count++] = Vector2i(p_x - 1, p_y + p_dy);
+			}
+		}
+		if (right) {
+			r_neighbours[count++] = Vector2i(p_x + 1, p_y);
+		}
+		if (left) {
+			r_neighbours[count++] = Vector2i(p_x - 1, p_y);
+		}
+	}
+
+	return count;
+}
+
+AStarGrid2D::SearchState *AStarGrid2D::_begin_search() {
+	SearchState *state;
+	{
+		MutexLock lock(search_states_mutex);
+		if (free_search_states.size()) {
+			state = free_search_states[free_search_states.size() - 1];
+			free_search_states.resize(free_search_states.size() - 1);
+		} else {
+			state = memnew(SearchState);
+			state->pass = 0;
+		}
+	}
+
+	uint32_t cell_count = size.x * size.y;
+	uint32_t old_size = state->nodes.size();
+	if (old_size < cell_count) {
+		state->nodes.resize(cell_count);
+		for (uint32_t i = old_size; i < cell_count; i++) {
+			state->nodes[i].open_pass = 0;
+			state->nodes[i].closed_pass = 0;
+		}
+	}
+
+	state->pass++;
+	if (state->pass == 0) { // Wrapped around, old marks could be mistaken for the new pass.
+		for (uint32_t i = 0; i < state->nodes.size(); i++) {
+			state->nodes[i].open_pass = 0;
+			state->nodes[i].closed_pass = 0;
+		}
+		state->pass = 1;
+	}
+
+	return state;
+}
+
+void AStarGrid2D::_end_search(SearchState *p_state) {
+	MutexLock lock(search_states_mutex);
+	free_search_states.push_back(p_state);
+}
+
+bool AStarGrid2D::_solve(SearchState &r_state, const Vector2i &p_from, const Vector2i &p_to) {
+	if (!_is_walkable(p_from.x, p_from.y) || !_is_walkable(p_to.x, p_to.y)) {
+		return false;
+	}
+
+	bool jumping = jumping_enabled && diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES;
+	uint32_t width = size.x;
+	uint32_t begin_cell = p_from.y * width + p_from.x;
+	uint32_t end_cell = p_to.y * width + p_to.x;
+
+	uint32_t pass = r_state.pass;
+	SearchNode *nodes = r_state.nodes.ptr();
+	LocalVector<OpenEntry> &open_list = r_state.open_list;
+	SortArray<OpenEntry, SortOpenEntries> sorter;
+	open_list.clear();
+
+	SearchNode &begin_node = nodes[begin_cell];
+	begin_node.prev_cell = begin_cell;
+	begin_node.g_score = 0;
+	begin_node.open_pass = pass;
+
+	OpenEntry begin_entry;
+	begin_entry.cell = begin_cell;
+	begin_entry.g_score = 0;
+	begin_entry.f_score = _estimate(p_from.x, p_from.y, p_to.x, p_to.y);
+	open_list.push_back(begin_entry);
+
+	Vector2i targets[8];
+
+	while (!open_list.empty()) {
+		OpenEntry current = open_list[0]; // The currently processed cell
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.resize(open_list.size() - 1);
+
+		SearchNode &node = nodes[current.cell];
+		if (node.closed_pass == pass || current.g_score > node.g_score) {
+			continue; // Outdated entry, a better path to the cell was found after it was pushed.
+		}
+
+		if (current.cell == end_cell) {
+			return true;
+		}
+
+		node.closed_pass = pass;
+
+		int x = current.cell % width;
+		int y = current.cell / width;
+		int target_count = 0;
+
+		if (jumping) {
+			int dx = _sign(x - int(node.prev_cell % width));
+			int dy = _sign(y - int(node.prev_cell / width));
+
+			Vector2i neighbours[8];
+			int neighbour_count = _get_jump_neighbours(x, y, dx, dy, neighbours);
+			for (int i = 0; i < neighbour_count; i++) {
+				int jx, jy;
+				if (_jump(neighbours[i].x, neighbours[i].y, neighbours[i].x - x, neighbours[i].y - y, p_to.x, p_to.y, jx, jy)) {
+					targets[target_count++] = Vector2i(jx, jy);
+				}
+			}
+		} else {
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					if ((dx || dy) && _can_move(x, y, dx, dy)) {
+						targets[target_count++] = Vector2i(x + dx, y + dy);
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < target_count; i++) {
+			uint32_t target_cell = targets[i].y * width + targets[i].x;
+			SearchNode &target_node = nodes[target_cell];
+			if (target_node.closed_pass == pass) {
+				continue;
+			}
+
+			real_t tentative_g_score = node.g_score + _compute_cost(x, y, targets[i].x, targets[i].y);
+			if (target_node.open_pass == pass && tentative_g_score >= target_node.g_score) { // The new path is worse than the previous.
+				continue;
+			}
+
+			target_node.open_pass = pass;
+			target_node.prev_cell = current.cell;
+			target_node.g_score = tentative_g_score;
+
+			OpenEntry entry;
+			entry.cell = target_cell;
+			entry.g_score = tentative_g_score;
+			entry.f_score = tentative_g_score + _estimate(targets[i].x, targets[i].y, p_to.x, p_to.y);
+			open_list.push_back(entry);
+			sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
+		}
+	}
+
+	return false;
+}
+
+// Returns the number of cells in the solved path, and writes them to r_cells when given.
+// Jump points are expanded, so the path always goes through adjacent cells.
+int AStarGrid2D::_get_path_cells(const SearchState &p_state, const Vector2i &p_from, const Vector2i &p_to, Vector2i *r_cells) const {
+	const SearchNode *nodes = p_state.nodes.ptr();
+	uint32_t width = size.x;
+	uint32_t begin_cell = p_from.y * width + p_from.x;
+	uint32_t end_cell = p_to.y * width + p_to.x;
+
+	int count = 1; // Begin cell
+	for (uint32_t cell = end_cell; cell != begin_cell; cell = nodes[cell].prev_cell) {
+		uint32_t prev = nodes[cell].prev_cell;
+		count += MAX(ABS(int(prev % width) - int(cell % width)), ABS(int(prev / width) - int(cell / width)));
+	}
+
+	if (!r_cells) {
+		return count;
+	}
+
+	int idx = count - 1;
+	r_cells[idx] = p_to;
+	for (uint32_t cell = end_cell; cell != begin_cell; cell = nodes[cell].prev_cell) {
+		uint32_t prev = nodes[cell].prev_cell;
+		int x = cell % width;
+		int y = cell / width;
+		int sx = _sign(int(prev % width) - x);
+		int sy = _sign(int(prev / width) - y);
+		int steps = MAX(ABS(int(prev % width) - x), ABS(int(prev / width) - y));
+		for (int i = 1; i <= steps; i++) {
+			r_cells[--idx] = Vector2i(x + sx * i, y + sy * i);
+		}
+	}
+
+	return count;
+}
+
+void AStarGrid2D::set_size(const Vector2i &p_size) {
+	ERR_FAIL_COND_MSG(p_size.x < 0 || p_size.y < 0, "Grid size can't be negative.");
+	ERR_FAIL_COND_MSG(int64_t(p_size.x) * p_size.y > INT32_MAX, "Grid is too big.");
+
+	size = p_size;
+	uint32_t cell_count = size.x * size.y;
+	solid.resize((cell_count + 63) / 64);
+	for (uint32_t i = 0; i < solid.size(); i++) {
+		solid[i] = 0;
+	}
+}
+
+Vector2i AStarGrid2D::get_size() const {
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+	cell_size = p_cell_size;
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+	return cell_size;
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	return jumping_enabled;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
+	default_heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+	return default_heuristic;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	return diagonal_mode;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+	return p_x >= 0 && p_y >= 0 && p_x < size.x && p_y < size.y;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+	return is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is solid. Point out of bounds: %s.", p_id));
+
+	uint32_t cell = p_id.y * size.x + p_id.x;
+	if (p_solid) {
+		solid[cell >> 6] |= uint64_t(1) << (cell & 63);
+	} else {
+		solid[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+	}
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is solid. Point out of bounds: %s.", p_id));
+
+	return !_is_walkable(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
+	Rect2i region = p_region.clip(Rect2i(Vector2i(), size));
+
+	for (int y = region.position.y; y < region.position.y + region.size.y; y++) {
+		for (int x = region.position.x; x < region.position.x + region.size.x; x++) {
+			set_point_solid(Vector2i(x, y), p_solid);
+		}
+	}
+}
+
+Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point out of bounds: %s.", p_id));
+
+	return offset + Vector2(p_id.x * cell_size.x, p_id.y * cell_size.y);
+}
+
+void AStarGrid2D::clear() {
+	size = Vector2i();
+	solid.clear();
+}
+
+PoolVector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), PoolVector<Vector2>(), vformat("Can't get point path. Point out of bounds: %s.", p_from_id));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), PoolVector<Vector2>(), vformat("Can't get point path. Point out of bounds: %s.", p_to_id));
+
+	if (p_from_id == p_to_id) {
+		PoolVector<Vector2> ret;
+		ret.push_back(get_point_position(p_from_id));
+		return ret;
+	}
+
+	SearchState *state = _begin_search();
+	bool found_route = _solve(*state, p_from_id, p_to_id);
+	if (!found_route) {
+		_end_search(state);
+		return PoolVector<Vector2>();
+	}
+
+	LocalVector<Vector2i> cells;
+	cells.resize(_get_path_cells(*state, p_from_id, p_to_id, nullptr));
+	_get_path_cells(*state, p_from_id, p_to_id, cells.ptr());
+	_end_search(state);
+
+	PoolVector<Vector2> path;
+	path.resize(cells.size());
+	{
+		PoolVector<Vector2>::Write w = path.write();
+		for (uint32_t i = 0; i < cells.size(); i++) {
+			w[i] = offset + Vector2(cells[i].x * cell_size.x, cells[i].y * cell_size.y);
+		}
+	}
+
+	return path;
+}
+
+PoolVector<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), PoolVector<Vector2i>(), vformat("Can't get id path. Point out of bounds: %s.", p_from_id));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), PoolVector<Vector2i>(), vformat("Can't get id path. Point out of bounds: %s.", p_to_id));
+
+	if (p_from_id == p_to_id) {
+		PoolVector<Vector2i> ret;
+		ret.push_back(p_from_id);
+		return ret;
+	}
+
+	SearchState *state = _begin_search();
+	bool found_route = _solve(*state, p_from_id, p_to_id);
+	if (!found_route) {
+		_end_search(state);
+		return PoolVector<Vector2i>();
+	}
+
+	PoolVector<Vector2i> path;
+	path.resize(_get_path_cells(*state, p_from_id, p_to_id, nullptr));
+	{
+		PoolVector<Vector2i>::Write w = path.write();
+		_get_path_cells(*state, p_from_id, p_to_id, w.ptr());
+	}
+	_end_search(state);
+
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("fill_solid_region", "region", "solid"), &AStarGrid2D::fill_solid_region, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
+
+AStarGrid2D::AStarGrid2D() {
+	cell_size = Vector2(1, 1);
+	jumping_enabled = false;
+	default_heuristic = HEURISTIC_EUCLIDEAN;
+	diagonal_mode = DIAGONAL_MODE_ALWAYS;
+}
+
+AStarGrid2D::~AStarGrid2D() {
+	for (uint32_t i = 0; i < free_search_states.size(); i++) {
+		memdelete(free_search_states[i]);
+	}
+}
@@ -0,0 +1,146 @@
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+/*  a_star_grid_2d.h                                                     */
+
+
+#include "core/containers/local_vector.h"
+#include "core/object/reference.h"
+#include "core/os/mutex.h"
+
+/**
+	A* pathfinding on a dense 2D grid.
+
+	Cells are addressed by their coordinates, solidity is stored in a bitset and the
+	search state lives in per-query scratch buffers, so path queries can run from
+	several threads at once as long as the grid isn't modified meanwhile.
+*/
+
+class AStarGrid2D : public Reference {
+	GDCLASS(AStarGrid2D, Reference);
+
+public:
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX,
+	};
+
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+private:
+	struct SearchNode {
+		uint32_t prev_cell;
+		real_t g_score;
+		uint32_t open_pass;
+		uint32_t closed_pass;
+	};
+
+	struct OpenEntry {
+		uint32_t cell;
+		real_t f_score;
+		real_t g_score;
+	};
+
+	struct SortOpenEntries {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const { // Returns true when the entry A is worse than entry B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the cells that are further away from the start.
+			}
+		}
+	};
+
+	struct SearchState {
+		LocalVector<SearchNode> nodes; // One per cell, row major.
+		LocalVector<OpenEntry> open_list;
+		uint32_t pass;
+	};
+
+	Vector2i size;
+	Vector2 offset;
+	Vector2 cell_size;
+	bool jumping_enabled;
+	Heuristic default_heuristic;
+	DiagonalMode diagonal_mode;
+
+	LocalVector<uint64_t> solid; // One bit per cell, row major.
+
+	Mutex search_states_mutex;
+	LocalVector<SearchState *> free_search_states;
+
+	_FORCE_INLINE_ bool _is_walkable(int p_x, int p_y) const {
+		if (p_x < 0 || p_y < 0 || p_x >= size.x || p_y >= size.y) {
+			return false;
+		}
+		uint32_t cell = p_y * size.x + p_x;
+		return !(solid[cell >> 6] & (uint64_t(1) << (cell & 63)));
+	}
+
+	bool _can_move(int p_x, int p_y, int p_dx, int p_dy) const;
+	real_t _estimate(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const;
+	real_t _compute_cost(int p_from_x, int p_from_y, int p_to_x, int p_to_y) const;
+
+	bool _jump(int p_x, int p_y, int p_dx, int p_dy, int p_end_x, int p_end_y, int &r_x, int &r_y) const;
+	int _get_jump_neighbours(int p_x, int p_y, int p_dx, int p_dy, Vector2i *r_neighbours) const;
+
+	SearchState *_begin_search();
+	void _end_search(SearchState *p_state);
+	bool _solve(SearchState &r_state, const Vector2i &p_from, const Vector2i &p_to);
+	int _get_path_cells(const SearchState &p_state, const Vector2i &p_from, const Vector2i &p_to, Vector2i *r_cells) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Vector2i &p_size);
+	Vector2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+	void fill_solid_region(const Rect2i &p_region, bool p_solid = true);
+
+	Vector2 get_point_position(const Vector2i &p_id) const;
+
+	void clear();
+
+	PoolVector<Vector2> get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	PoolVector<Vector2i> get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+
+	AStarGrid2D();
+	~AStarGrid2D();
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic);
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+
+#endif // A_STAR_GRID_2D_H
@@ -6,6 +6,7 @@
 
 #include "core/error/error_macros.h"
 #include "core/os/safe_refcount.h"
+#include "core/os/thread_cache_allocator.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -39,6 +40,60 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+
+// The allocator needs the size back on free, so every block has the size header here.
+// Usage is counted per thread by the allocator, no global counter is touched.
+
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	uint8_t *mem = (uint8_t *)ThreadCacheAllocator::alloc(p_bytes + PAD_ALIGN);
+	ERR_FAIL_COND_V(!mem, nullptr);
+
+	*(uint64_t *)mem = p_bytes;
+	return mem + PAD_ALIGN;
+}
+
+void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
+	if (p_memory == nullptr) {
+		return alloc_static(p_bytes, p_pad_align);
+	}
+
+	uint8_t *mem = (uint8_t *)p_memory - PAD_ALIGN;
+	uint64_t old_bytes = *(uint64_t *)mem;
+
+	if (p_bytes == 0) {
+		ThreadCacheAllocator::free(mem, old_bytes + PAD_ALIGN);
+		return nullptr;
+	}
+
+	mem = (uint8_t *)ThreadCacheAllocator::realloc(mem, old_bytes + PAD_ALIGN, p_bytes + PAD_ALIGN);
+	ERR_FAIL_COND_V(!mem, nullptr);
+
+	*(uint64_t *)mem = p_bytes;
+	return mem + PAD_ALIGN;
+}
+
+void Memory::free_static(void *p_ptr, bool p_pad_align) {
+	ERR_FAIL_COND(p_ptr == nullptr);
+
+	uint8_t *mem = (uint8_t *)p_ptr - PAD_ALIGN;
+	ThreadCacheAllocator::free(mem, *(uint64_t *)mem + PAD_ALIGN);
+}
+
+uint64_t Memory::get_mem_available() {
+	return -1; // 0xFFFF...
+}
+
+uint64_t Memory::get_mem_usage() {
+	return ThreadCacheAllocator::get_mem_usage();
+}
+
+uint64_t Memory::get_mem_max_usage() {
+	return ThreadCacheAllocator::get_mem_max_usage();
+}
+
+#else
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -165,6 +220,8 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+#endif // THREAD_CACHE_ALLOCATOR_ENABLED
+
 _GlobalNil::_GlobalNil() {
 	color = 1;
 	left = this;
@@ -995,7 +995,8 @@ void OS::benchmark_dump() {
 	if (!benchmark_file.empty()) {
 		FileAccess *f = FileAccess::open(benchmark_file, FileAccess::WRITE);
 		if (f) {
-			f->store_string(JSON::print(startup_benchmark_json, "\t", false));
+			JSONWriter writer(f, "\t");
+			writer.write_variant(startup_benchmark_json, false);
 		}
 	} else {
 		List<Variant> keys;
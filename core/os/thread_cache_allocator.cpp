@@ -0,0 +1,301 @@
+
+/*  thread_cache_allocator.cpp                                           */
+
+
+#include "thread_cache_allocator.h"
+
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+
+// Nothing in here may go through Memory (no memnew, no error macros), it is what Memory calls.
+
+struct ThreadCacheFreeBlock {
+	ThreadCacheFreeBlock *next;
+};
+
+struct ThreadCacheCentralList {
+	SpinLock lock;
+	ThreadCacheFreeBlock *blocks;
+};
+
+struct ThreadCache {
+	ThreadCacheFreeBlock *blocks[ThreadCacheAllocator::SIZE_CLASS_COUNT];
+	uint32_t block_counts[ThreadCacheAllocator::SIZE_CLASS_COUNT];
+
+	std::atomic<int64_t> mem_usage; // Only written by the owner thread, can go below zero when it frees memory allocated elsewhere.
+
+	ThreadCache *prev;
+	ThreadCache *next;
+	bool registered;
+	bool retired; // The thread is exiting, go to the central lists directly from now on.
+};
+
+struct ThreadCacheGuard {
+	bool used = false;
+	~ThreadCacheGuard();
+};
+
+static ThreadCacheCentralList central_lists[ThreadCacheAllocator::SIZE_CLASS_COUNT];
+
+static SpinLock registry_lock;
+static ThreadCache *registry = nullptr;
+static std::atomic<int64_t> retired_mem_usage(0);
+static std::atomic<uint64_t> max_mem_usage(0);
+
+// Plain data, so it is usable at any time during the thread lifetime. The guard flushes it when the thread exits.
+static thread_local ThreadCache thread_cache;
+static thread_local ThreadCacheGuard thread_cache_guard;
+
+static _FORCE_INLINE_ uint32_t _get_size_class(size_t p_bytes) {
+	return p_bytes ? (p_bytes - 1) / ThreadCacheAllocator::SIZE_CLASS_GRANULARITY : 0;
+}
+
+static _FORCE_INLINE_ size_t _get_block_size(uint32_t p_size_class) {
+	return (p_size_class + 1) * ThreadCacheAllocator::SIZE_CLASS_GRANULARITY;
+}
+
+static ThreadCache *_get_thread_cache() {
+	ThreadCache *cache = &thread_cache;
+
+	if (unlikely(cache->retired)) {
+		return nullptr;
+	}
+
+	if (unlikely(!cache->registered)) {
+		cache->registered = true;
+		thread_cache_guard.used = true; // Makes sure the guard gets destroyed, hence the cache flushed, when the thread exits.
+
+		registry_lock.lock();
+		cache->prev = nullptr;
+		cache->next = registry;
+		if (registry) {
+			registry->prev = cache;
+		}
+		registry = cache;
+		registry_lock.unlock();
+	}
+
+	return cache;
+}
+
+static _FORCE_INLINE_ void _add_mem_usage(ThreadCache *p_cache, int64_t p_bytes) {
+	if (likely(p_cache)) {
+		p_cache->mem_usage.store(p_cache->mem_usage.load(std::memory_order_relaxed) + p_bytes, std::memory_order_relaxed);
+	} else {
+		retired_mem_usage.fetch_add(p_bytes, std::memory_order_relaxed);
+	}
+}
+
+// Takes up to p_count blocks from the central list, carving a new chunk if it is empty.
+static ThreadCacheFreeBlock *_fetch_blocks(uint32_t p_size_class, uint32_t p_count, uint32_t &r_fetched) {
+	ThreadCacheCentralList &central = central_lists[p_size_class];
+	r_fetched = 0;
+
+	central.lock.lock();
+
+	if (!central.blocks) {
+		size_t block_size = _get_block_size(p_size_class);
+		uint8_t *chunk = (uint8_t *)malloc(ThreadCacheAllocator::CHUNK_SIZE);
+		if (!chunk) {
+			central.lock.unlock();
+			return nullptr;
+		}
+
+		uint32_t block_count = ThreadCacheAllocator::CHUNK_SIZE / block_size;
+		for (uint32_t i = 0; i < block_count; i++) {
+			ThreadCacheFreeBlock *block = (ThreadCacheFreeBlock *)(chunk + i * block_size);
+			block->next = (i + 1 < block_count) ? (ThreadCacheFreeBlock *)(chunk + (i + 1) * block_size) : nullptr;
+		}
+		central.blocks = (ThreadCacheFreeBlock *)chunk;
+	}
+
+	ThreadCacheFreeBlock *first = central.blocks;
+	ThreadCacheFreeBlock *last = first;
+	r_fetched = 1;
+	while (r_fetched < p_count && last->next) {
+		last = last->next;
+		r_fetched++;
+	}
+
+	central.blocks = last->next;
+	last->next = nullptr;
+
+	central.lock.unlock();
+
+	return first;
+}
+
+static void _release_blocks(uint32_t p_size_class, ThreadCacheFreeBlock *p_first, ThreadCacheFreeBlock *p_last) {
+	ThreadCacheCentralList &central = central_lists[p_size_class];
+
+	central.lock.lock();
+	p_last->next = central.blocks;
+	central.blocks = p_first;
+	central.lock.unlock();
+}
+
+// Gives the first p_count blocks of the thread cache back to the central list.
+static void _spill_blocks(ThreadCache *p_cache, uint32_t p_size_class, uint32_t p_count) {
+	ThreadCacheFreeBlock *first = p_cache->blocks[p_size_class];
+	if (!first || !p_count) {
+		return;
+	}
+
+	ThreadCacheFreeBlock *last = first;
+	uint32_t count = 1;
+	while (count < p_count && last->next) {
+		last = last->next;
+		count++;
+	}
+
+	p_cache->blocks[p_size_class] = last->next;
+	p_cache->block_counts[p_size_class] -= count;
+
+	_release_blocks(p_size_class, first, last);
+}
+
+ThreadCacheGuard::~ThreadCacheGuard() {
+	ThreadCache *cache = &thread_cache;
+	if (!cache->registered) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < ThreadCacheAllocator::SIZE_CLASS_COUNT; i++) {
+		_spill_blocks(cache, i, cache->block_counts[i]);
+	}
+
+	registry_lock.lock();
+	if (cache->prev) {
+		cache->prev->next = cache->next;
+	} else {
+		registry = cache->next;
+	}
+	if (cache->next) {
+		cache->next->prev = cache->prev;
+	}
+	retired_mem_usage.fetch_add(cache->mem_usage.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	registry_lock.unlock();
+
+	cache->registered = false;
+	cache->retired = true;
+}
+
+void *ThreadCacheAllocator::alloc(size_t p_bytes) {
+	ThreadCache *cache = _get_thread_cache();
+
+	if (p_bytes > SMALL_SIZE_MAX) {
+		void *mem = malloc(p_bytes);
+		if (mem) {
+			_add_mem_usage(cache, p_bytes);
+		}
+		return mem;
+	}
+
+	uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCacheFreeBlock *block;
+
+	if (likely(cache)) {
+		if (unlikely(!cache->blocks[size_class])) {
+			cache->blocks[size_class] = _fetch_blocks(size_class, TRANSFER_BATCH_SIZE, cache->block_counts[size_class]);
+			if (!cache->blocks[size_class]) {
+				return nullptr;
+			}
+		}
+
+		block = cache->blocks[size_class];
+		cache->blocks[size_class] = block->next;
+		cache->block_counts[size_class]--;
+	} else {
+		uint32_t fetched;
+		block = _fetch_blocks(size_class, 1, fetched);
+		if (!block) {
+			return nullptr;
+		}
+	}
+
+	_add_mem_usage(cache, p_bytes);
+	return block;
+}
+
+void *ThreadCacheAllocator::realloc(void *p_mem, size_t p_old_bytes, size_t p_bytes) {
+	if (p_old_bytes > SMALL_SIZE_MAX && p_bytes > SMALL_SIZE_MAX) {
+		void *mem = ::realloc(p_mem, p_bytes);
+		if (mem) {
+			_add_mem_usage(_get_thread_cache(), (int64_t)p_bytes - (int64_t)p_old_bytes);
+		}
+		return mem;
+	}
+
+	if (p_old_bytes <= SMALL_SIZE_MAX && p_bytes <= SMALL_SIZE_MAX && _get_size_class(p_old_bytes) == _get_size_class(p_bytes)) {
+		// The block is big enough already.
+		_add_mem_usage(_get_thread_cache(), (int64_t)p_bytes - (int64_t)p_old_bytes);
+		return p_mem;
+	}
+
+	void *mem = alloc(p_bytes);
+	if (!mem) {
+		return nullptr;
+	}
+
+	memcpy(mem, p_mem, MIN(p_old_bytes, p_bytes));
+	free(p_mem, p_old_bytes);
+	return mem;
+}
+
+void ThreadCacheAllocator::free(void *p_mem, size_t p_bytes) {
+	ThreadCache *cache = _get_thread_cache();
+	_add_mem_usage(cache, -(int64_t)p_bytes);
+
+	if (p_bytes > SMALL_SIZE_MAX) {
+		::free(p_mem);
+		return;
+	}
+
+	uint32_t size_class = _get_size_class(p_bytes);
+	ThreadCacheFreeBlock *block = (ThreadCacheFreeBlock *)p_mem;
+
+	if (likely(cache)) {
+		block->next = cache->blocks[size_class];
+		cache->blocks[size_class] = block;
+		cache->block_counts[size_class]++;
+
+		if (unlikely(cache->block_counts[size_class] > THREAD_CACHE_BLOCKS_MAX)) {
+			_spill_blocks(cache, size_class, TRANSFER_BATCH_SIZE);
+		}
+	} else {
+		block->next = nullptr;
+		_release_blocks(size_class, block, block);
+	}
+}
+
+uint64_t ThreadCacheAllocator::get_mem_usage() {
+	registry_lock.lock();
+	int64_t usage = retired_mem_usage.load(std::memory_order_relaxed);
+	for (ThreadCache *E = registry; E; E = E->next) {
+		usage += E->mem_usage.load(std::memory_order_relaxed);
+	}
+	registry_lock.unlock();
+
+	if (usage < 0) {
+		usage = 0; // The counters of each thread aren't read at the exact same time.
+	}
+
+	uint64_t max_usage = max_mem_usage.load(std::memory_order_relaxed);
+	while ((uint64_t)usage > max_usage && !max_mem_usage.compare_exchange_weak(max_usage, usage, std::memory_order_relaxed)) {
+	}
+
+	return usage;
+}
+
+uint64_t ThreadCacheAllocator::get_mem_max_usage() {
+	get_mem_usage();
+	return max_mem_usage.load(std::memory_order_relaxed);
+}
+
+#endif // THREAD_CACHE_ALLOCATOR_ENABLED
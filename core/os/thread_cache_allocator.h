@@ -0,0 +1,43 @@
+#ifndef THREAD_CACHE_ALLOCATOR_H
+#define THREAD_CACHE_ALLOCATOR_H
+
+/*  thread_cache_allocator.h                                             */
+
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+/**
+	Small object allocator used by Memory when built with thread_cache_allocator=yes.
+
+	Small blocks are served from per-thread free lists, one per size class, so the common
+	alloc / free pair touches no lock and no shared cache line. The thread caches refill
+	from and spill back to a central list per size class in batches. Bigger blocks go to
+	malloc directly.
+
+	Memory usage is counted per thread and only summed up when asked for, so the peak
+	usage is the highest sum seen by get_mem_usage() / get_mem_max_usage().
+*/
+
+class ThreadCacheAllocator {
+public:
+	enum {
+		SIZE_CLASS_GRANULARITY = 16, // Also the alignment of the blocks.
+		SMALL_SIZE_MAX = 1024,
+		SIZE_CLASS_COUNT = SMALL_SIZE_MAX / SIZE_CLASS_GRANULARITY,
+		TRANSFER_BATCH_SIZE = 32, // Blocks moved at once between a thread cache and the central list.
+		THREAD_CACHE_BLOCKS_MAX = TRANSFER_BATCH_SIZE * 2, // Per size class.
+		CHUNK_SIZE = 64 * 1024,
+	};
+
+	// Sizes must be passed back on free and realloc, the allocator doesn't store them.
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_mem, size_t p_old_bytes, size_t p_bytes);
+	static void free(void *p_mem, size_t p_bytes);
+
+	static uint64_t get_mem_usage();
+	static uint64_t get_mem_max_usage();
+};
+
+#endif // THREAD_CACHE_ALLOCATOR_H
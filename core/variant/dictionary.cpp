@@ -4,30 +4,269 @@
 
 #include "dictionary.h"
 
-#include "core/containers/ordered_hash_map.h"
+#include "core/containers/hashfuncs.h"
+#include "core/os/memory.h"
 #include "core/os/safe_refcount.h"
 #include "core/variant/variant.h"
 
+// Entries are stored in insertion order in a sequence of pages, page N holding
+// DICTIONARY_PAGE_SIZE << N entries. Entries never move, so pointers returned by getptr()
+// and operator[] stay valid while other keys are inserted or erased. Erased entries are
+// left in place (with their key and value released) and only reclaimed by clear(), or
+// once the last entry is erased; index rebuilds leave them out. Small dictionaries are searched
+// with a linear scan of the stored hashes; past DICTIONARY_PAGE_SIZE entries an open
+// addressed (linear probing) index of entry pointers is added.
+#define DICTIONARY_PAGE_SIZE 8u
+#define DICTIONARY_MAX_PAGES 28
+
 struct DictionaryPrivate {
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash;
+		bool erased;
+	};
+
+	// Walks the entries that were not erased, in insertion order.
+	struct Iterator {
+		const DictionaryPrivate *dict;
+		uint32_t page;
+		uint32_t offset;
+		uint32_t pos;
+		Entry *entry;
+
+		void settle() {
+			while (pos < dict->used) {
+				if (offset == (DICTIONARY_PAGE_SIZE << page)) {
+					page++;
+					offset = 0;
+					continue;
+				}
+				Entry *e = &dict->pages[page][offset];
+				if (!e->erased) {
+					entry = e;
+					return;
+				}
+				offset++;
+				pos++;
+			}
+			entry = nullptr;
+		}
+
+		_FORCE_INLINE_ void next() {
+			offset++;
+			pos++;
+			settle();
+		}
+	};
+
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
-};
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.empty()) {
-		return;
+	Entry *pages[DICTIONARY_MAX_PAGES];
+	uint32_t page_count;
+	uint32_t used; //entries in the pages, including erased ones
+	uint32_t count; //entries not erased
+	uint32_t tail_page; //where the next entry goes
+	uint32_t tail_offset;
+
+	Entry **index;
+	uint32_t index_mask;
+
+	_FORCE_INLINE_ Iterator begin() const {
+		Iterator it;
+		it.dict = this;
+		it.page = 0;
+		it.offset = 0;
+		it.pos = 0;
+		it.settle();
+		return it;
+	}
+
+	// Positions an iterator on the entry whose key is p_key, if it points into the pages.
+	bool iterator_at(const Variant *p_key, Iterator &r_it) const {
+		uint32_t page_pos = 0;
+		for (uint32_t i = 0; i < page_count; i++) {
+			uint32_t capacity = DICTIONARY_PAGE_SIZE << i;
+			const uint8_t *from = (const uint8_t *)pages[i];
+			const uint8_t *to = (const uint8_t *)(pages[i] + capacity);
+			if ((const uint8_t *)p_key >= from && (const uint8_t *)p_key < to) {
+				uint32_t offset = ((const uint8_t *)p_key - from) / sizeof(Entry);
+				if (&pages[i][offset].key != p_key || page_pos + offset >= used) {
+					return false;
+				}
+				r_it.dict = this;
+				r_it.page = i;
+				r_it.offset = offset;
+				r_it.pos = page_pos + offset;
+				r_it.entry = &pages[i][offset];
+				return true;
+			}
+			page_pos += capacity;
+		}
+		return false;
+	}
+
+	_FORCE_INLINE_ static uint32_t _slot(uint32_t p_hash) {
+		return hash_fmix32(p_hash);
+	}
+
+	Entry *find(const Variant &p_key, uint32_t p_hash) const {
+		if (index) {
+			uint32_t slot = _slot(p_hash) & index_mask;
+			while (Entry *e = index[slot]) {
+				if (e->hash == p_hash && !e->erased && VariantComparator::compare(e->key, p_key)) {
+					return e;
+				}
+				slot = (slot + 1) & index_mask;
+			}
+			return nullptr;
+		}
+
+		//without index all entries fit in the first page
+		for (uint32_t i = 0; i < used; i++) {
+			Entry *e = &pages[0][i];
+			if (e->hash == p_hash && !e->erased && VariantComparator::compare(e->key, p_key)) {
+				return e;
+			}
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ Entry *find(const Variant &p_key) const {
+		return find(p_key, VariantHasher::hash(p_key));
+	}
+
+	void _index_insert(Entry *p_entry) {
+		uint32_t slot = _slot(p_entry->hash) & index_mask;
+		while (index[slot]) {
+			slot = (slot + 1) & index_mask;
+		}
+		index[slot] = p_entry;
+	}
+
+	// Rebuilds the index for at least p_entries entries, leaving erased ones out.
+	void _rebuild_index(uint32_t p_entries) {
+		if (index) {
+			memfree(index);
+		}
+		uint32_t capacity = next_power_of_2(MAX(p_entries, (uint32_t)DICTIONARY_PAGE_SIZE) * 2);
+		index = (Entry **)memalloc(sizeof(Entry *) * capacity);
+		memset(index, 0, sizeof(Entry *) * capacity);
+		index_mask = capacity - 1;
+
+		for (Iterator it = begin(); it.entry; it.next()) {
+			_index_insert(it.entry);
+		}
+	}
+
+	Entry *append(const Variant &p_key, uint32_t p_hash) {
+		if (tail_page == page_count) {
+			CRASH_COND_MSG(page_count == DICTIONARY_MAX_PAGES, "Dictionary is too big.");
+			pages[page_count] = (Entry *)memalloc(sizeof(Entry) * (DICTIONARY_PAGE_SIZE << page_count));
+			page_count++;
+		}
+
+		Entry *e = memnew_placement(&pages[tail_page][tail_offset], Entry);
+		e->key = p_key;
+		e->hash = p_hash;
+		e->erased = false;
+
+		tail_offset++;
+		if (tail_offset == (DICTIONARY_PAGE_SIZE << tail_page)) {
+			tail_page++;
+			tail_offset = 0;
+		}
+		used++;
+		count++;
+
+		if (index) {
+			if (used * 2 > index_mask + 1) {
+				_rebuild_index(used);
+			} else {
+				_index_insert(e);
+			}
+		} else if (used > DICTIONARY_PAGE_SIZE) {
+			_rebuild_index(used);
+		}
+
+		return e;
 	}
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	// Makes room for p_count entries, so they can be appended without growing the index.
+	void reserve(uint32_t p_count) {
+		if (p_count > DICTIONARY_PAGE_SIZE && (!index || p_count * 2 > index_mask + 1)) {
+			_rebuild_index(p_count);
+		}
+	}
+
+	bool erase(const Variant &p_key) {
+		Entry *e = find(p_key);
+		if (!e) {
+			return false;
+		}
+
+		e->erased = true;
+		e->key = Variant();
+		e->value = Variant();
+		count--;
+
+		if (count == 0) {
+			clear();
+		}
+		return true;
+	}
+
+	void clear() {
+		for (uint32_t i = 0, page = 0, offset = 0; i < used; i++) {
+			pages[page][offset].~Entry();
+			offset++;
+			if (offset == (DICTIONARY_PAGE_SIZE << page)) {
+				page++;
+				offset = 0;
+			}
+		}
+		for (uint32_t i = 0; i < page_count; i++) {
+			memfree(pages[i]);
+		}
+		if (index) {
+			memfree(index);
+		}
+
+		page_count = 0;
+		used = 0;
+		count = 0;
+		tail_page = 0;
+		tail_offset = 0;
+		index = nullptr;
+		index_mask = 0;
+	}
+
+	DictionaryPrivate() {
+		page_count = 0;
+		used = 0;
+		count = 0;
+		tail_page = 0;
+		tail_offset = 0;
+		index = nullptr;
+		index_mask = 0;
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
+};
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		p_keys->push_back(it.entry->key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
 	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
 		if (index == p_index) {
-			return E.key();
+			return it.entry->key;
 		}
 		index++;
 	}
@@ -37,9 +276,9 @@ Variant Dictionary::get_key_at_index(int p_index) const {
 
 Variant Dictionary::get_value_at_index(int p_index) const {
 	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
 		if (index == p_index) {
-			return E.value();
+			return it.entry->value;
 		}
 		index++;
 	}
@@ -48,37 +287,45 @@ Variant Dictionary::get_value_at_index(int p_index) const {
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
-	return _p->variant_map[p_key];
+	uint32_t hash = VariantHasher::hash(p_key);
+	DictionaryPrivate::Entry *e = _p->find(p_key, hash);
+	if (!e) {
+		// consistent with Map behaviour
+		e = _p->append(p_key, hash);
+	}
+	return e->value;
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
-	return _p->variant_map[p_key];
+	DictionaryPrivate::Entry *e = _p->find(p_key);
+	CRASH_COND(!e);
+	return e->value;
 }
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryPrivate::Entry *e = _p->find(p_key);
 
-	if (!E) {
+	if (!e) {
 		return nullptr;
 	}
-	return &E.get();
+	return &e->value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
+	DictionaryPrivate::Entry *e = _p->find(p_key);
 
-	if (!E) {
+	if (!e) {
 		return nullptr;
 	}
-	return &E.get();
+	return &e->value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	DictionaryPrivate::Entry *e = _p->find(p_key);
 
-	if (!E) {
+	if (!e) {
 		return Variant();
 	}
-	return E.get();
+	return e->value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -91,14 +338,14 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->count;
 }
 bool Dictionary::empty() const {
-	return !_p->variant_map.size();
+	return !_p->count;
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != nullptr;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -111,16 +358,16 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 Variant Dictionary::find_key(const Variant &p_value) const {
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (E.value() == p_value) {
-			return E.key();
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		if (it.entry->value == p_value) {
+			return it.entry->key;
 		}
 	}
 	return Variant();
 }
 
 bool Dictionary::erase(const Variant &p_key) {
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::deep_equal(const Dictionary &p_dictionary, int p_recursion_count) const {
@@ -129,26 +376,26 @@ bool Dictionary::deep_equal(const Dictionary &p_dictionary, int p_recursion_coun
 	if (_p == p_dictionary._p) {
 		return true;
 	}
-	if (_p->variant_map.size() != p_dictionary._p->variant_map.size()) {
+	if (_p->count != p_dictionary._p->count) {
 		return false;
 	}
 
 	// Heavy O(n) check
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element this_E = _p->variant_map.front();
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element other_E = p_dictionary._p->variant_map.front();
+	DictionaryPrivate::Iterator this_it = _p->begin();
+	DictionaryPrivate::Iterator other_it = p_dictionary._p->begin();
 	p_recursion_count++;
-	while (this_E && other_E) {
+	while (this_it.entry && other_it.entry) {
 		if (
-				!this_E.key().deep_equal(other_E.key(), p_recursion_count) ||
-				!this_E.value().deep_equal(other_E.value(), p_recursion_count)) {
+				!this_it.entry->key.deep_equal(other_it.entry->key, p_recursion_count) ||
+				!this_it.entry->value.deep_equal(other_it.entry->value, p_recursion_count)) {
 			return false;
 		}
 
-		this_E = this_E.next();
-		other_E = other_E.next();
+		this_it.next();
+		other_it.next();
 	}
 
-	return !this_E && !other_E;
+	return !this_it.entry && !other_it.entry;
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -177,13 +424,20 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 }
 
 void Dictionary::clear() {
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = p_dictionary._p->variant_map.front(); E; E = E.next()) {
-		if (p_overwrite || !has(E.key())) {
-			this->operator[](E.key()) = E.value();
+	if (p_dictionary._p == _p) {
+		return;
+	}
+	_p->reserve(_p->count + p_dictionary._p->count);
+	for (DictionaryPrivate::Iterator it = p_dictionary._p->begin(); it.entry; it.next()) {
+		DictionaryPrivate::Entry *e = _p->find(it.entry->key, it.entry->hash);
+		if (!e) {
+			_p->append(it.entry->key, it.entry->hash)->value = it.entry->value;
+		} else if (p_overwrite) {
+			e->value = it.entry->value;
 		}
 	}
 }
@@ -206,9 +460,9 @@ uint32_t Dictionary::recursive_hash(int p_recursion_count) const {
 
 	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_murmur3_one_32(E.key().recursive_hash(p_recursion_count), h);
-		h = hash_murmur3_one_32(E.value().recursive_hash(p_recursion_count), h);
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		h = hash_murmur3_one_32(it.entry->key.recursive_hash(p_recursion_count), h);
+		h = hash_murmur3_one_32(it.entry->value.recursive_hash(p_recursion_count), h);
 	}
 
 	return hash_fmix32(h);
@@ -216,15 +470,15 @@ uint32_t Dictionary::recursive_hash(int p_recursion_count) const {
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (!_p->count) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		varr[i] = it.entry->key;
 		i++;
 	}
 
@@ -233,15 +487,15 @@ Array Dictionary::keys() const {
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.empty()) {
+	if (!_p->count) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		varr[i] = it.entry->value;
 		i++;
 	}
 
@@ -249,26 +503,31 @@ Array Dictionary::values() const {
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
+	DictionaryPrivate::Iterator it;
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.front()) {
-			return &_p->variant_map.front().key();
+		it = _p->begin();
+	} else {
+		// keys returned by a previous call are located without hashing them again
+		if (!_p->iterator_at(p_key, it)) {
+			DictionaryPrivate::Entry *e = _p->find(*p_key);
+			if (!e || !_p->iterator_at(&e->key, it)) {
+				return nullptr;
+			}
 		}
-		return nullptr;
+		it.next();
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next()) {
-		return &E.next().key();
-	}
-	return nullptr;
+	return it.entry ? &it.entry->key : nullptr;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 	Dictionary n;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
+	n._p->reserve(_p->count);
+	for (DictionaryPrivate::Iterator it = _p->begin(); it.entry; it.next()) {
+		//keys are already unique, so no lookup is needed
+		n._p->append(it.entry->key, it.entry->hash)->value = p_deep ? it.entry->value.duplicate(true) : it.entry->value;
 	}
 
 	return n;
@@ -4,6 +4,7 @@
 
 #include "variant.h"
 
+#include "core/containers/paged_allocator.h"
 #include "core/core_string_names.h"
 #include "core/io/marshalls.h"
 #include "core/math/math_funcs.h"
@@ -14,6 +15,26 @@
 #include "scene/main/control.h"
 #include "scene/main/node.h"
 
+// The boxed types are created and freed all the time (every Transform2D operation in a script
+// makes a new one), so they come from pools instead of going through the general allocator.
+struct Variant::Pools {
+	enum {
+		PAGE_SIZE = 1024,
+	};
+
+	static PagedAllocator<Transform2D, true> transform2d;
+	static PagedAllocator<::AABB, true> aabb;
+	static PagedAllocator<Basis, true> basis;
+	static PagedAllocator<Transform, true> transform;
+	static PagedAllocator<Projection, true> projection;
+};
+
+PagedAllocator<Transform2D, true> Variant::Pools::transform2d(Variant::Pools::PAGE_SIZE);
+PagedAllocator<::AABB, true> Variant::Pools::aabb(Variant::Pools::PAGE_SIZE);
+PagedAllocator<Basis, true> Variant::Pools::basis(Variant::Pools::PAGE_SIZE);
+PagedAllocator<Transform, true> Variant::Pools::transform(Variant::Pools::PAGE_SIZE);
+PagedAllocator<Projection, true> Variant::Pools::projection(Variant::Pools::PAGE_SIZE);
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1154,19 +1175,19 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Quaternion(*reinterpret_cast<const Quaternion *>(p_variant._data._mem)));
 		} break;
 		case AABB: {
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_data._aabb = Pools::aabb.alloc(*p_variant._data._aabb);
 		} break;
 		case BASIS: {
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_data._basis = Pools::basis.alloc(*p_variant._data._basis);
 		} break;
 		case TRANSFORM: {
-			_data._transform = memnew(Transform(*p_variant._data._transform));
+			_data._transform = Pools::transform.alloc(*p_variant._data._transform);
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_data._transform2d = Pools::transform2d.alloc(*p_variant._data._transform2d);
 		} break;
 		case PROJECTION: {
-			_data._projection = memnew(Projection(*p_variant._data._projection));
+			_data._projection = Pools::projection.alloc(*p_variant._data._projection);
 		} break;
 
 		// misc types
@@ -1317,19 +1338,19 @@ void Variant::clear() {
 		QUATERNION,
 		*/
 		case AABB: {
-			memdelete(_data._aabb);
+			Pools::aabb.free(_data._aabb);
 		} break;
 		case BASIS: {
-			memdelete(_data._basis);
+			Pools::basis.free(_data._basis);
 		} break;
 		case TRANSFORM: {
-			memdelete(_data._transform);
+			Pools::transform.free(_data._transform);
 		} break;
 		case TRANSFORM2D: {
-			memdelete(_data._transform2d);
+			Pools::transform2d.free(_data._transform2d);
 		} break;
 		case PROJECTION: {
-			memdelete(_data._projection);
+			Pools::projection.free(_data._projection);
 		} break;
 		//COLOR
 
@@ -2685,12 +2706,12 @@ Variant::Variant(const Plane &p_plane) {
 }
 Variant::Variant(const ::AABB &p_aabb) {
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_data._aabb = Pools::aabb.alloc(p_aabb);
 }
 
 Variant::Variant(const Basis &p_matrix) {
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_data._basis = Pools::basis.alloc(p_matrix);
 }
 
 Variant::Variant(const Quaternion &p_quat) {
@@ -2699,17 +2720,17 @@ Variant::Variant(const Quaternion &p_quat) {
 }
 Variant::Variant(const Transform &p_transform) {
 	type = TRANSFORM;
-	_data._transform = memnew(Transform(p_transform));
+	_data._transform = Pools::transform.alloc(p_transform);
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_data._transform2d = Pools::transform2d.alloc(p_transform);
 }
 
 Variant::Variant(const Projection &p_projection) {
 	type = PROJECTION;
-	_data._projection = memnew(Projection(p_projection));
+	_data._projection = Pools::projection.alloc(p_projection);
 }
 
 Variant::Variant(const Color &p_color) {
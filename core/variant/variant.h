@@ -126,7 +126,9 @@ public:
 private:
 	friend struct _VariantCall;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
-	// it only allocates extra memory for aabb/matrix.
+	// it only allocates extra memory for aabb/matrix, from the pools below.
+
+	struct Pools;
 
 	Type type;
 
@@ -804,6 +804,7 @@ void RasterizerCanvasBaseGLES2::initialize() {
 	}
 
 	state.canvas_shader.init();
+	state.canvas_shader.warm_up();
 
 	state.using_modulate = false;
 
@@ -255,6 +255,7 @@ void RasterizerGLES2::begin_frame(double frame_step) {
 	storage->frame.delta = frame_step;
 
 	storage->update_dirty_resources();
+	storage->texture_atlas_update();
 
 	storage->info.render_final = storage->info.render;
 	storage->info.render.reset();
@@ -435,6 +436,7 @@ void RasterizerGLES2::end_frame(bool p_swap_buffers) {
 }
 
 void RasterizerGLES2::finalize() {
+	storage->finalize();
 }
 
 Rasterizer *RasterizerGLES2::_create_current() {
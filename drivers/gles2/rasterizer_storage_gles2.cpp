@@ -4,6 +4,7 @@
 
 #include "rasterizer_storage_gles2.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/math/transform.h"
 #include "rasterizer_canvas_gles2.h"
@@ -500,6 +501,9 @@ void RasterizerStorageGLES2::texture_allocate(RID p_texture, int p_width, int p_
 
 	Texture *texture = texture_owner.getornull(p_texture);
 	ERR_FAIL_COND(!texture);
+
+	_texture_atlas_remove(texture, false);
+
 	texture->width = p_width;
 	texture->height = p_height;
 	texture->format = p_format;
@@ -616,6 +620,8 @@ void RasterizerStorageGLES2::texture_set_data(RID p_texture, const Ref<Image> &p
 	ERR_FAIL_COND(p_image.is_null());
 	ERR_FAIL_COND(texture->type == RS::TEXTURE_TYPE_EXTERNAL);
 
+	_texture_atlas_remove(texture, true);
+
 	GLenum type;
 	GLenum format;
 	GLenum internal_format;
@@ -754,6 +760,11 @@ void RasterizerStorageGLES2::texture_set_data(RID p_texture, const Ref<Image> &p
 }
 
 void RasterizerStorageGLES2::texture_set_data_partial(RID p_texture, const Ref<Image> &p_image, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y, int p_dst_mip, int p_layer) {
+	Texture *texture = texture_owner.getornull(p_texture);
+	ERR_FAIL_COND(!texture);
+
+	_texture_atlas_remove(texture, true);
+
 	// TODO
 	ERR_PRINT("Not implemented (ask Karroffel to do it :p)");
 }
@@ -887,6 +898,10 @@ void RasterizerStorageGLES2::texture_set_flags(RID p_texture, uint32_t p_flags)
 
 	bool had_mipmaps = texture->flags & RS::TEXTURE_FLAG_MIPMAPS;
 
+	if (texture->flags != p_flags) {
+		_texture_atlas_remove(texture, false);
+	}
+
 	texture->flags = p_flags;
 
 	gl_wrapper.gl_active_texture(GL_TEXTURE0);
@@ -1120,6 +1135,201 @@ void RasterizerStorageGLES2::texture_set_detect_normal_callback(RID p_texture, R
 	texture->detect_normal_ud = p_userdata;
 }
 
+bool RasterizerStorageGLES2::_texture_atlas_can_pack(const Texture *p_texture) const {
+	// The copy goes through a framebuffer, so only uncompressed RGBA textures qualify. Pages have
+	// no mipmaps and no wrapping, and textures resized to a power of 2 don't match their size.
+	if (!p_texture->active || p_texture->render_target || p_texture->target != GL_TEXTURE_2D || p_texture->data_size == 0) {
+		return false;
+	}
+	if (p_texture->compressed || p_texture->format != Image::FORMAT_RGBA8) {
+		return false;
+	}
+	if (p_texture->flags & (RS::TEXTURE_FLAG_MIPMAPS | RS::TEXTURE_FLAG_MIRRORED_REPEAT | RS::TEXTURE_FLAG_USED_FOR_STREAMING)) {
+		return false;
+	}
+	if (p_texture->width != p_texture->alloc_width || p_texture->height != p_texture->alloc_height) {
+		return false;
+	}
+
+	return p_texture->width > 0 && p_texture->height > 0 && p_texture->width <= texture_atlas.texture_size_max && p_texture->height <= texture_atlas.texture_size_max;
+}
+
+int RasterizerStorageGLES2::_texture_atlas_find_space(bool p_filter, int p_width, int p_height, Vector2 &r_position) {
+	stbrp_rect rect;
+	rect.id = 0;
+	rect.w = p_width;
+	rect.h = p_height;
+
+	for (uint32_t i = 0; i < texture_atlas.pages.size(); i++) {
+		TextureAtlasPage *page = texture_atlas.pages[i];
+		if (page->filter != p_filter) {
+			continue;
+		}
+
+		stbrp_pack_rects(&page->context, &rect, 1);
+		if (rect.was_packed) {
+			r_position = Vector2(rect.x, rect.y);
+			return i;
+		}
+	}
+
+	int page_index;
+
+	if ((int)texture_atlas.pages.size() < texture_atlas.page_max) {
+		TextureAtlasPage *page = memnew(TextureAtlasPage);
+		page->texture = texture_create();
+		texture_allocate(page->texture, texture_atlas.page_size, texture_atlas.page_size, 0, Image::FORMAT_RGBA8, RS::TEXTURE_TYPE_2D, p_filter ? (uint32_t)RS::TEXTURE_FLAG_FILTER : 0u);
+
+		Ref<Image> image;
+		image.instance();
+		image->create(texture_atlas.page_size, texture_atlas.page_size, false, Image::FORMAT_RGBA8);
+		texture_set_data(page->texture, image);
+
+		page->filter = p_filter;
+		page->nodes.resize(texture_atlas.page_size);
+		_texture_atlas_clear_page(page);
+
+		page_index = texture_atlas.pages.size();
+		texture_atlas.pages.push_back(page);
+	} else {
+		page_index = 0;
+		for (uint32_t i = 1; i < texture_atlas.pages.size(); i++) {
+			if (texture_atlas.pages[i]->last_used_frame < texture_atlas.pages[page_index]->last_used_frame) {
+				page_index = i;
+			}
+		}
+
+		TextureAtlasPage *page = texture_atlas.pages[page_index];
+		if (frame.count - page->last_used_frame < TEXTURE_ATLAS_PAGE_IDLE_FRAMES_MIN) {
+			return -1;
+		}
+
+		_texture_atlas_clear_page(page);
+
+		if (page->filter != p_filter) {
+			texture_set_flags(page->texture, p_filter ? (uint32_t)RS::TEXTURE_FLAG_FILTER : 0u);
+			page->filter = p_filter;
+		}
+	}
+
+	stbrp_pack_rects(&texture_atlas.pages[page_index]->context, &rect, 1);
+	if (!rect.was_packed) {
+		return -1;
+	}
+
+	r_position = Vector2(rect.x, rect.y);
+	return page_index;
+}
+
+void RasterizerStorageGLES2::_texture_atlas_clear_page(TextureAtlasPage *p_page) {
+	for (uint32_t i = 0; i < p_page->textures.size(); i++) {
+		p_page->textures[i]->atlas_page = TEXTURE_ATLAS_NONE;
+	}
+	p_page->textures.clear();
+
+	stbrp_init_target(&p_page->context, texture_atlas.page_size, texture_atlas.page_size, p_page->nodes.ptr(), p_page->nodes.size());
+	p_page->last_used_frame = frame.count;
+}
+
+void RasterizerStorageGLES2::_texture_atlas_pack(Texture *p_texture) {
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, p_texture->tex_id, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		p_texture->atlas_page = TEXTURE_ATLAS_UNSUPPORTED;
+		return;
+	}
+
+	int w = p_texture->width;
+	int h = p_texture->height;
+
+	// One pixel of padding on each side, filled with the edges so filtering doesn't pick up the neighbours.
+	Vector2 position;
+	int page_index = _texture_atlas_find_space(p_texture->flags & RS::TEXTURE_FLAG_FILTER, w + 2, h + 2, position);
+	if (page_index < 0) {
+		p_texture->atlas_page = TEXTURE_ATLAS_NONE; // No room for now, asked again the next time it's drawn.
+		return;
+	}
+
+	TextureAtlasPage *page = texture_atlas.pages[page_index];
+	Texture *page_texture = texture_owner.getornull(page->texture);
+
+	int x = position.x + 1;
+	int y = position.y + 1;
+
+	gl_wrapper.gl_active_texture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, page_texture->tex_id);
+
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, w, h);
+
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y - 1, 0, 0, w, 1);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y + h, 0, h - 1, w, 1);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x - 1, y, 0, 0, 1, h);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x + w, y, w - 1, 0, 1, h);
+
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x - 1, y - 1, 0, 0, 1, 1);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x + w, y - 1, w - 1, 0, 1, 1);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x - 1, y + h, 0, h - 1, 1, 1);
+	glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x + w, y + h, w - 1, h - 1, 1, 1);
+
+	p_texture->atlas_page = page_index;
+	p_texture->atlas_position = Vector2(x, y);
+	page->textures.push_back(p_texture);
+}
+
+void RasterizerStorageGLES2::_texture_atlas_remove(Texture *p_texture, bool p_data_changed) {
+	if (p_texture->atlas_page >= 0) {
+		// The space stays taken until the page is cleared.
+		TextureAtlasPage *page = texture_atlas.pages[p_texture->atlas_page];
+		page->textures.remove_unordered(page->textures.find(p_texture));
+
+		// Textures updated after being packed would be copied again and again, keep them out.
+		p_texture->atlas_page = p_data_changed ? TEXTURE_ATLAS_UNSUPPORTED : TEXTURE_ATLAS_NONE;
+	} else if (p_texture->atlas_page == TEXTURE_ATLAS_PENDING) {
+		texture_atlas.pending.erase(p_texture);
+		p_texture->atlas_page = TEXTURE_ATLAS_NONE;
+	} else if (p_texture->atlas_page == TEXTURE_ATLAS_UNSUPPORTED && !p_data_changed) {
+		p_texture->atlas_page = TEXTURE_ATLAS_NONE; // Reallocated or new flags, check again.
+	}
+}
+
+bool RasterizerStorageGLES2::texture_atlas_get_region(Texture *p_texture, RID &r_page, Vector2 &r_position) {
+	if (p_texture->atlas_page >= 0) {
+		TextureAtlasPage *page = texture_atlas.pages[p_texture->atlas_page];
+		page->last_used_frame = frame.count;
+
+		r_page = page->texture;
+		r_position = p_texture->atlas_position;
+		return true;
+	}
+
+	// Packing needs a framebuffer of its own, so it waits until the start of the next frame
+	// instead of interrupting the canvas rendering.
+	if (p_texture->atlas_page == TEXTURE_ATLAS_NONE && _texture_atlas_can_pack(p_texture)) {
+		p_texture->atlas_page = TEXTURE_ATLAS_PENDING;
+		texture_atlas.pending.push_back(p_texture);
+	}
+
+	return false;
+}
+
+void RasterizerStorageGLES2::texture_atlas_update() {
+	if (texture_atlas.pending.empty()) {
+		return;
+	}
+
+	if (!texture_atlas.copy_fbo) {
+		glGenFramebuffers(1, &texture_atlas.copy_fbo);
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, texture_atlas.copy_fbo);
+
+	for (uint32_t i = 0; i < texture_atlas.pending.size(); i++) {
+		_texture_atlas_pack(texture_atlas.pending[i]);
+	}
+	texture_atlas.pending.clear();
+
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES2::system_fbo);
+}
+
 RID RasterizerStorageGLES2::texture_create_radiance_cubemap(RID p_source, int p_resolution) const {
 	return RID();
 }
@@ -1184,6 +1394,171 @@ String RasterizerStorageGLES2::shader_get_code(RID p_shader) const {
 	return shader->code;
 }
 
+static Dictionary _shader_code_to_cache(const RasterizerStorageGLES2::Shader *p_shader, const ShaderCompilerGLES2::GeneratedCode &p_gen_code) {
+	Dictionary d;
+
+	Array custom_defines;
+	for (int i = 0; i < p_gen_code.custom_defines.size(); i++) {
+		custom_defines.push_back(String::utf8(p_gen_code.custom_defines[i].get_data()));
+	}
+	d["custom_defines"] = custom_defines;
+
+	Array uniforms;
+	for (int i = 0; i < p_gen_code.uniforms.size(); i++) {
+		uniforms.push_back(String(p_gen_code.uniforms[i]));
+	}
+	d["uniforms"] = uniforms;
+
+	Array texture_uniforms;
+	for (int i = 0; i < p_gen_code.texture_uniforms.size(); i++) {
+		texture_uniforms.push_back(String(p_gen_code.texture_uniforms[i]));
+	}
+	d["texture_uniforms"] = texture_uniforms;
+
+	Array texture_hints;
+	for (int i = 0; i < p_gen_code.texture_hints.size(); i++) {
+		texture_hints.push_back(p_gen_code.texture_hints[i]);
+	}
+	d["texture_hints"] = texture_hints;
+
+	d["vertex_global"] = p_gen_code.vertex_global;
+	d["vertex"] = p_gen_code.vertex;
+	d["fragment_global"] = p_gen_code.fragment_global;
+	d["fragment"] = p_gen_code.fragment;
+	d["light"] = p_gen_code.light;
+	d["uses_fragment_time"] = p_gen_code.uses_fragment_time;
+	d["uses_vertex_time"] = p_gen_code.uses_vertex_time;
+
+	// Uniform layout, as the parser would have left it in the shader.
+	Array shader_uniforms;
+	for (const RBMap<StringName, ShaderLanguage::ShaderNode::Uniform>::Element *E = p_shader->uniforms.front(); E; E = E->next()) {
+		const ShaderLanguage::ShaderNode::Uniform &u = E->get();
+
+		Array default_value;
+		for (int i = 0; i < u.default_value.size(); i++) {
+			default_value.push_back(u.default_value[i].sint); // Raw bits, the type tells how to read them.
+		}
+
+		Dictionary ud;
+		ud["name"] = String(E->key());
+		ud["order"] = u.order;
+		ud["texture_order"] = u.texture_order;
+		ud["type"] = u.type;
+		ud["precision"] = u.precision;
+		ud["hint"] = u.hint;
+		ud["hint_range"] = Vector3(u.hint_range[0], u.hint_range[1], u.hint_range[2]);
+		ud["default_value"] = default_value;
+		shader_uniforms.push_back(ud);
+	}
+	d["shader_uniforms"] = shader_uniforms;
+
+	if (p_shader->mode == RS::SHADER_CANVAS_ITEM) {
+		const RasterizerStorageGLES2::Shader::CanvasItem &ci = p_shader->canvas_item;
+
+		Dictionary cd;
+		cd["blend_mode"] = ci.blend_mode;
+		cd["light_mode"] = ci.light_mode;
+		cd["uses_screen_texture"] = ci.uses_screen_texture;
+		cd["uses_screen_uv"] = ci.uses_screen_uv;
+		cd["uses_time"] = ci.uses_time;
+		cd["uses_modulate"] = ci.uses_modulate;
+		cd["uses_color"] = ci.uses_color;
+		cd["uses_vertex"] = ci.uses_vertex;
+		cd["uses_world_matrix"] = ci.uses_world_matrix;
+		cd["uses_extra_matrix"] = ci.uses_extra_matrix;
+		cd["uses_projection_matrix"] = ci.uses_projection_matrix;
+		cd["uses_instance_custom"] = ci.uses_instance_custom;
+		d["canvas_item"] = cd;
+	}
+
+	return d;
+}
+
+static bool _shader_code_from_cache(const Variant &p_cached, RasterizerStorageGLES2::Shader *p_shader, ShaderCompilerGLES2::GeneratedCode &r_gen_code) {
+	if (p_cached.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+
+	Dictionary d = p_cached;
+	if (!d.has("shader_uniforms") || (p_shader->mode == RS::SHADER_CANVAS_ITEM && !d.has("canvas_item"))) {
+		return false;
+	}
+
+	Array custom_defines = d["custom_defines"];
+	for (int i = 0; i < custom_defines.size(); i++) {
+		r_gen_code.custom_defines.push_back(String(custom_defines[i]).utf8());
+	}
+
+	Array uniforms = d["uniforms"];
+	for (int i = 0; i < uniforms.size(); i++) {
+		r_gen_code.uniforms.push_back(uniforms[i]);
+	}
+
+	Array texture_uniforms = d["texture_uniforms"];
+	for (int i = 0; i < texture_uniforms.size(); i++) {
+		r_gen_code.texture_uniforms.push_back(texture_uniforms[i]);
+	}
+
+	Array texture_hints = d["texture_hints"];
+	for (int i = 0; i < texture_hints.size(); i++) {
+		r_gen_code.texture_hints.push_back(ShaderLanguage::ShaderNode::Uniform::Hint((int)texture_hints[i]));
+	}
+
+	r_gen_code.vertex_global = d["vertex_global"];
+	r_gen_code.vertex = d["vertex"];
+	r_gen_code.fragment_global = d["fragment_global"];
+	r_gen_code.fragment = d["fragment"];
+	r_gen_code.light = d["light"];
+	r_gen_code.uses_fragment_time = d["uses_fragment_time"];
+	r_gen_code.uses_vertex_time = d["uses_vertex_time"];
+
+	Array shader_uniforms = d["shader_uniforms"];
+	for (int i = 0; i < shader_uniforms.size(); i++) {
+		Dictionary ud = shader_uniforms[i];
+
+		ShaderLanguage::ShaderNode::Uniform u;
+		u.order = ud["order"];
+		u.texture_order = ud["texture_order"];
+		u.type = ShaderLanguage::DataType((int)ud["type"]);
+		u.precision = ShaderLanguage::DataPrecision((int)ud["precision"]);
+		u.hint = ShaderLanguage::ShaderNode::Uniform::Hint((int)ud["hint"]);
+
+		Vector3 hint_range = ud["hint_range"];
+		u.hint_range[0] = hint_range.x;
+		u.hint_range[1] = hint_range.y;
+		u.hint_range[2] = hint_range.z;
+
+		Array default_value = ud["default_value"];
+		for (int j = 0; j < default_value.size(); j++) {
+			ShaderLanguage::ConstantNode::Value value;
+			value.sint = default_value[j];
+			u.default_value.push_back(value);
+		}
+
+		p_shader->uniforms[StringName(String(ud["name"]))] = u;
+	}
+
+	if (p_shader->mode == RS::SHADER_CANVAS_ITEM) {
+		RasterizerStorageGLES2::Shader::CanvasItem &ci = p_shader->canvas_item;
+
+		Dictionary cd = d["canvas_item"];
+		ci.blend_mode = cd["blend_mode"];
+		ci.light_mode = cd["light_mode"];
+		ci.uses_screen_texture = cd["uses_screen_texture"];
+		ci.uses_screen_uv = cd["uses_screen_uv"];
+		ci.uses_time = cd["uses_time"];
+		ci.uses_modulate = cd["uses_modulate"];
+		ci.uses_color = cd["uses_color"];
+		ci.uses_vertex = cd["uses_vertex"];
+		ci.uses_world_matrix = cd["uses_world_matrix"];
+		ci.uses_extra_matrix = cd["uses_extra_matrix"];
+		ci.uses_projection_matrix = cd["uses_projection_matrix"];
+		ci.uses_instance_custom = cd["uses_instance_custom"];
+	}
+
+	return true;
+}
+
 void RasterizerStorageGLES2::_update_shader(Shader *p_shader) const {
 	_shader_dirty_list.remove(&p_shader->dirty_list);
 
@@ -1248,9 +1623,26 @@ void RasterizerStorageGLES2::_update_shader(Shader *p_shader) const {
 		} break;
 	}
 
-	Error err = shaders.compiler.compile(p_shader->mode, p_shader->code, actions, p_shader->path, gen_code);
-	if (err != OK) {
-		return;
+	// The parse and the generated code only depend on the source, so they can come from the cache.
+	String cache_key;
+	bool cached = false;
+
+	if (shaders.cache) {
+		cache_key = shaders.cache->make_key("code", itos(p_shader->mode) + "|" + p_shader->code, false);
+
+		Variant cached_code;
+		cached = shaders.cache->retrieve(cache_key, cached_code) && _shader_code_from_cache(cached_code, p_shader, gen_code);
+	}
+
+	if (!cached) {
+		Error err = shaders.compiler.compile(p_shader->mode, p_shader->code, actions, p_shader->path, gen_code);
+		if (err != OK) {
+			return;
+		}
+
+		if (shaders.cache) {
+			shaders.cache->store(cache_key, _shader_code_to_cache(p_shader, gen_code));
+		}
 	}
 
 	p_shader->shader->set_custom_shader_code(p_shader->custom_code_id, gen_code.vertex, gen_code.vertex_global, gen_code.fragment, gen_code.light, gen_code.fragment_global, gen_code.uniforms, gen_code.texture_uniforms, gen_code.custom_defines);
@@ -1485,6 +1877,19 @@ void RasterizerStorageGLES2::shader_remove_custom_define(RID p_shader, const Str
 	_shader_make_dirty(shader);
 }
 
+void RasterizerStorageGLES2::shader_warm_up(RID p_shader) {
+	Shader *shader = shader_owner.get(p_shader);
+	ERR_FAIL_COND(!shader);
+
+	if (shader->dirty_list.in_list()) {
+		_update_shader(shader);
+	}
+
+	if (shader->valid) {
+		shader->shader->warm_up(shader->custom_code_id);
+	}
+}
+
 /* COMMON MATERIAL API */
 
 void RasterizerStorageGLES2::_material_make_dirty(Material *p_material) const {
@@ -3944,6 +4349,8 @@ bool RasterizerStorageGLES2::free(RID p_rid) {
 		// can't free a render target texture
 		ERR_FAIL_COND_V(t->render_target, true);
 
+		_texture_atlas_remove(t, false);
+
 		info.texture_mem -= t->total_data_size;
 		texture_owner.free(p_rid);
 		memdelete(t);
@@ -4364,7 +4771,27 @@ void RasterizerStorageGLES2::initialize() {
 	glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &config.max_cubemap_texture_size);
 	glGetIntegerv(GL_MAX_VIEWPORT_DIMS, config.max_viewport_dimensions);
 
+	shaders.cache = nullptr;
+	// Shaders are recompiled on every edit in the editor, caching each version would only fill the folder up.
+	if (GLOBAL_GET("rendering/gles2/shader_cache/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		String driver_id = String((const char *)glGetString(GL_VENDOR)) + "|" + String((const char *)glGetString(GL_RENDERER)) + "|" + String((const char *)glGetString(GL_VERSION));
+
+		bool program_binaries_supported = false;
+#ifdef GLES_OVER_GL
+		if (GLAD_GL_ARB_get_program_binary && GLOBAL_GET("rendering/gles2/shader_cache/use_program_binaries")) {
+			GLint format_count = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+			program_binaries_supported = format_count > 0;
+		}
+#endif
+
+		uint64_t max_size = (uint64_t)(int)GLOBAL_GET("rendering/gles2/shader_cache/max_size_mb") * 1024 * 1024;
+		shaders.cache = memnew(ShaderCacheGLES2(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"), driver_id, program_binaries_supported, max_size));
+	}
+	ShaderGLES2::shader_cache = shaders.cache;
+
 	shaders.copy.init();
+	shaders.copy.warm_up();
 
 	{
 		// quad for copying stuff
@@ -4534,9 +4961,31 @@ void RasterizerStorageGLES2::initialize() {
 			config.should_orphan = true;
 		} break;
 	}
+
+	texture_atlas.page_size = MIN((int)GLOBAL_GET("rendering/batching/texture_atlas/page_size"), config.max_texture_size);
+	texture_atlas.page_max = MAX((int)GLOBAL_GET("rendering/batching/texture_atlas/max_pages"), 1);
+	texture_atlas.texture_size_max = MIN((int)GLOBAL_GET("rendering/batching/texture_atlas/max_texture_size"), texture_atlas.page_size - 2);
+	texture_atlas.copy_fbo = 0;
 }
 
 void RasterizerStorageGLES2::finalize() {
+	for (uint32_t i = 0; i < texture_atlas.pages.size(); i++) {
+		_texture_atlas_clear_page(texture_atlas.pages[i]);
+		free(texture_atlas.pages[i]->texture);
+		memdelete(texture_atlas.pages[i]);
+	}
+	texture_atlas.pages.clear();
+
+	if (texture_atlas.copy_fbo) {
+		glDeleteFramebuffers(1, &texture_atlas.copy_fbo);
+		texture_atlas.copy_fbo = 0;
+	}
+
+	if (shaders.cache) {
+		ShaderGLES2::shader_cache = nullptr;
+		memdelete(shaders.cache);
+		shaders.cache = nullptr;
+	}
 }
 
 void RasterizerStorageGLES2::_copy_screen() {
@@ -4554,4 +5003,5 @@ void RasterizerStorageGLES2::update_dirty_resources() {
 RasterizerStorageGLES2::RasterizerStorageGLES2() {
 	RasterizerStorageGLES2::system_fbo = 0;
 	config.should_orphan = true;
+	shaders.cache = nullptr;
 }
@@ -5,11 +5,14 @@
 
 
 #include "core/containers/bitfield_dynamic.h"
+#include "core/containers/local_vector.h"
 #include "core/containers/pool_vector.h"
 #include "core/containers/self_list.h"
+#include "core/thirdparty/stb_rect_pack/stb_rect_pack.h"
 #include "drivers/gles_common/rasterizer_asserts.h"
 #include "servers/rendering/rasterizer.h"
 #include "servers/rendering/shader_language.h"
+#include "shader_cache_gles2.h"
 #include "shader_compiler_gles2.h"
 #include "shader_gles2.h"
 
@@ -95,6 +98,7 @@ public:
 
 	mutable struct Shaders {
 		ShaderCompilerGLES2 compiler;
+		ShaderCacheGLES2 *cache;
 
 		CopyShaderGLES2 copy;
 
@@ -189,6 +193,12 @@ public:
 
 	struct RenderTarget;
 
+	enum TextureAtlasState {
+		TEXTURE_ATLAS_NONE = -1,
+		TEXTURE_ATLAS_PENDING = -2, // Packed at the start of the next frame.
+		TEXTURE_ATLAS_UNSUPPORTED = -3, // Can't be copied, or its data changed while packed.
+	};
+
 	struct Texture : RID_Data {
 		Texture *proxy;
 		RBSet<Texture *> proxy_owners;
@@ -237,6 +247,9 @@ public:
 		RenderingServer::TextureDetectCallback detect_normal;
 		void *detect_normal_ud;
 
+		int atlas_page; // Index of the runtime atlas page holding a copy, or a TextureAtlasState.
+		Vector2 atlas_position; // Top left corner of the copy in the page.
+
 		Texture() :
 				proxy(nullptr),
 				flags(0),
@@ -263,7 +276,8 @@ public:
 				detect_srgb(nullptr),
 				detect_srgb_ud(nullptr),
 				detect_normal(nullptr),
-				detect_normal_ud(nullptr) {
+				detect_normal_ud(nullptr),
+				atlas_page(TEXTURE_ATLAS_NONE) {
 		}
 
 		_ALWAYS_INLINE_ Texture *get_ptr() {
@@ -329,6 +343,42 @@ public:
 
 	virtual void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable);
 
+	/* TEXTURE ATLAS API */
+
+	// Small 2D textures are copied into shared pages at runtime, so the canvas batcher can join
+	// rects drawn with different textures. stb_rect_pack can't free single rects, so when all
+	// pages are full the least recently used one is cleared as a whole.
+	struct TextureAtlasPage {
+		RID texture;
+		bool filter;
+		uint64_t last_used_frame;
+		stbrp_context context;
+		LocalVector<stbrp_node> nodes;
+		LocalVector<Texture *> textures;
+	};
+
+	enum {
+		TEXTURE_ATLAS_PAGE_IDLE_FRAMES_MIN = 60, // Pages used more recently are never cleared, to avoid copying the same textures every frame.
+	};
+
+	struct TextureAtlas {
+		int page_size;
+		int page_max;
+		int texture_size_max;
+		GLuint copy_fbo;
+		LocalVector<TextureAtlasPage *> pages;
+		LocalVector<Texture *> pending;
+	} texture_atlas;
+
+	bool _texture_atlas_can_pack(const Texture *p_texture) const;
+	int _texture_atlas_find_space(bool p_filter, int p_width, int p_height, Vector2 &r_position);
+	void _texture_atlas_clear_page(TextureAtlasPage *p_page);
+	void _texture_atlas_pack(Texture *p_texture);
+	void _texture_atlas_remove(Texture *p_texture, bool p_data_changed);
+
+	bool texture_atlas_get_region(Texture *p_texture, RID &r_page, Vector2 &r_position);
+	void texture_atlas_update();
+
 	/* SHADER API */
 
 	struct Material;
@@ -480,6 +530,8 @@ public:
 	virtual void shader_get_custom_defines(RID p_shader, Vector<String> *p_defines) const;
 	virtual void shader_remove_custom_define(RID p_shader, const String &p_define);
 
+	virtual void shader_warm_up(RID p_shader);
+
 	void set_shader_async_hidden_forbidden(bool p_forbidden) {}
 	bool is_shader_async_hidden_forbidden() { return false; }
 
@@ -0,0 +1,168 @@
+
+/*  shader_cache_gles2.cpp                                               */
+
+
+#include "shader_cache_gles2.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/version.h"
+
+String ShaderCacheGLES2::make_key(const String &p_kind, const String &p_data, bool p_driver_dependent) const {
+	// The commit hash tells dev builds of the same version apart, their shader compilers may differ.
+	String key = p_kind + "|" + itos(FORMAT_VERSION) + "|" + VERSION_FULL_BUILD + "|" + VERSION_HASH;
+	if (p_driver_dependent) {
+		key += "|" + driver_id;
+	}
+
+	return (key + "|" + p_data).sha256_text();
+}
+
+bool ShaderCacheGLES2::retrieve(const String &p_key, Variant &r_value) const {
+	if (storage_path.empty()) {
+		return false;
+	}
+
+	FileAccessRef f = FileAccess::open(storage_path.plus_file(p_key), FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	uint64_t len = f->get_len();
+	Vector<uint8_t> data;
+	data.resize(len);
+	if (f->get_buffer(data.ptrw(), len) != len) {
+		return false;
+	}
+
+	Variant entry;
+	if (decode_variant(entry, data.ptr(), len) != OK || entry.get_type() != Variant::ARRAY) {
+		return false;
+	}
+
+	// Entries hold their own key, so a damaged or foreign file is never taken for one.
+	Array arr = entry;
+	if (arr.size() != 2 || arr[0].get_type() != Variant::STRING || String(arr[0]) != p_key) {
+		return false;
+	}
+
+	r_value = arr[1];
+	return true;
+}
+
+void ShaderCacheGLES2::store(const String &p_key, const Variant &p_value) {
+	if (storage_path.empty()) {
+		return;
+	}
+
+	Array entry;
+	entry.push_back(p_key);
+	entry.push_back(p_value);
+
+	int len = 0;
+	ERR_FAIL_COND(encode_variant(entry, nullptr, len) != OK);
+
+	Vector<uint8_t> data;
+	data.resize(len);
+	encode_variant(entry, data.ptrw(), len);
+
+	// Written aside and renamed, so an interrupted write never leaves a partial entry behind.
+	String path = storage_path.plus_file(p_key);
+	String tmp_path = path + ".tmp";
+	{
+		FileAccessRef f = FileAccess::open(tmp_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(!f, "Can't write shader cache entry: " + tmp_path + ".");
+		f->store_buffer(data.ptr(), len);
+	}
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (FileAccess::exists(path)) {
+		da->remove(path);
+	}
+	da->rename(tmp_path, path);
+}
+
+void ShaderCacheGLES2::remove(const String &p_key) {
+	if (storage_path.empty()) {
+		return;
+	}
+
+	String path = storage_path.plus_file(p_key);
+	if (FileAccess::exists(path)) {
+		DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		da->remove(path);
+	}
+}
+
+void ShaderCacheGLES2::_purge(uint64_t p_max_size) {
+	struct CacheFile {
+		String path;
+		uint64_t size;
+		uint64_t modified_time;
+
+		bool operator<(const CacheFile &p_file) const { return modified_time < p_file.modified_time; }
+	};
+
+	DirAccessRef da = DirAccess::open(storage_path);
+	if (!da) {
+		return;
+	}
+
+	Vector<CacheFile> files;
+	uint64_t total_size = 0;
+
+	da->list_dir_begin();
+	for (String name = da->get_next(); !name.empty(); name = da->get_next()) {
+		if (da->current_is_dir()) {
+			continue;
+		}
+
+		String path = storage_path.plus_file(name);
+		if (name.ends_with(".tmp")) {
+			da->remove(path); // Left behind by an interrupted write.
+			continue;
+		}
+
+		FileAccessRef f = FileAccess::open(path, FileAccess::READ);
+		if (!f) {
+			continue;
+		}
+
+		CacheFile file;
+		file.path = path;
+		file.size = f->get_len();
+		file.modified_time = FileAccess::get_modified_time(path);
+		files.push_back(file);
+		total_size += file.size;
+	}
+	da->list_dir_end();
+
+	if (total_size <= p_max_size) {
+		return;
+	}
+
+	// Code and program binary entries are never rewritten once stored, so the oldest ones are mostly left over
+	// from shaders or builds that changed since. The variant lists are rewritten whenever a variant is recorded,
+	// so the ones still in use are among the newest.
+	files.sort();
+	for (int i = 0; i < files.size() && total_size > p_max_size; i++) {
+		da->remove(files[i].path);
+		total_size -= files[i].size;
+	}
+}
+
+ShaderCacheGLES2::ShaderCacheGLES2(const String &p_storage_path, const String &p_driver_id, bool p_program_binaries_supported, uint64_t p_max_size) {
+	storage_path = p_storage_path;
+	driver_id = p_driver_id;
+	program_binaries_supported = p_program_binaries_supported;
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->make_dir_recursive(storage_path) != OK) {
+		WARN_PRINT("Can't create the shader cache folder, shaders won't be cached: " + storage_path + ".");
+		storage_path = String();
+		return;
+	}
+
+	_purge(p_max_size);
+}
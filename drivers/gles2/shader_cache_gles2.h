@@ -0,0 +1,44 @@
+#ifndef SHADER_CACHE_GLES2_H
+#define SHADER_CACHE_GLES2_H
+
+/*  shader_cache_gles2.h                                                 */
+
+
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+
+/**
+	On disk cache for the GLES2 shaders, in the user data folder.
+
+	Holds the output of the shader compiler for custom shaders, the program binaries
+	the driver can give back and the variants each shader was used with. Entries are
+	keyed by a hash of everything that went into them, so they never go stale, they
+	just stop being looked up. The oldest entries are deleted on startup when the
+	folder grows past its maximum size.
+*/
+
+class ShaderCacheGLES2 {
+	String storage_path;
+	String driver_id;
+	bool program_binaries_supported;
+
+	void _purge(uint64_t p_max_size);
+
+public:
+	enum {
+		FORMAT_VERSION = 1, // Bump when the layout of the entries or the output of the shader compiler changes.
+	};
+
+	// Hash to use as key, covers the engine version and commit and, for program binaries, the driver.
+	String make_key(const String &p_kind, const String &p_data, bool p_driver_dependent) const;
+
+	bool retrieve(const String &p_key, Variant &r_value) const;
+	void store(const String &p_key, const Variant &p_value);
+	void remove(const String &p_key);
+
+	_FORCE_INLINE_ bool are_program_binaries_supported() const { return program_binaries_supported; }
+
+	ShaderCacheGLES2(const String &p_storage_path, const String &p_driver_id, bool p_program_binaries_supported, uint64_t p_max_size);
+};
+
+#endif // SHADER_CACHE_GLES2_H
@@ -10,6 +10,7 @@
 #include "core/string/string_builder.h"
 #include "rasterizer_gles2.h"
 #include "rasterizer_storage_gles2.h"
+#include "shader_cache_gles2.h"
 
 // #define DEBUG_OPENGL
 
@@ -31,6 +32,7 @@
 #endif
 
 ShaderGLES2 *ShaderGLES2::active = nullptr;
+ShaderCacheGLES2 *ShaderGLES2::shader_cache = nullptr;
 
 //#define DEBUG_SHADER
 
@@ -105,6 +107,117 @@ String ShaderGLES2::_mkid(const String &p_id) {
 	return id.replace("__", "_dus_"); //doubleunderscore is reserved in glsl
 }
 
+String ShaderGLES2::_get_program_cache_key(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const {
+	String data = get_shader_name();
+
+	for (int i = 0; i < p_vertex_strings.size(); i++) {
+		data += p_vertex_strings[i];
+	}
+	data += "|";
+	for (int i = 0; i < p_fragment_strings.size(); i++) {
+		data += p_fragment_strings[i];
+	}
+	data += "|";
+	for (int i = 0; i < attribute_pair_count; i++) {
+		data += String(attribute_pairs[i].name) + ":" + itos(attribute_pairs[i].index) + ";";
+	}
+
+	return shader_cache->make_key("program", data, true);
+}
+
+bool ShaderGLES2::_load_program_binary(Version &v, const String &p_key) {
+#ifdef GLES_OVER_GL
+	Variant cached;
+	if (!shader_cache->retrieve(p_key, cached) || cached.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+
+	Dictionary d = cached;
+	if (d.get("format", Variant()).get_type() != Variant::INT || d.get("data", Variant()).get_type() != Variant::POOL_BYTE_ARRAY) {
+		return false;
+	}
+
+	GLenum format = (int)d["format"];
+	PoolVector<uint8_t> data = d["data"];
+
+	{
+		PoolVector<uint8_t>::Read r = data.read();
+		glProgramBinary(v.id, format, r.ptr(), data.size());
+	}
+
+	GLint status;
+	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
+	if (status == GL_FALSE) {
+		// The driver is allowed to reject binaries it made itself (e.g. after an update), start over from the source.
+		shader_cache->remove(p_key);
+		glDeleteProgram(v.id);
+		v.id = glCreateProgram();
+		return false;
+	}
+
+	v.vert_id = 0;
+	v.frag_id = 0;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ShaderGLES2::_store_program_binary(const Version &v, const String &p_key) {
+#ifdef GLES_OVER_GL
+	GLint length = 0;
+	glGetProgramiv(v.id, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	PoolVector<uint8_t> data;
+	data.resize(length);
+	GLenum format = 0;
+
+	{
+		PoolVector<uint8_t>::Write w = data.write();
+		glGetProgramBinary(v.id, length, nullptr, &format, w.ptr());
+	}
+
+	Dictionary d;
+	d["format"] = (int)format;
+	d["data"] = data;
+	shader_cache->store(p_key, d);
+#endif
+}
+
+void ShaderGLES2::_load_recorded_variants(const String &p_key, RBSet<uint64_t> &r_versions) {
+	r_versions.clear();
+
+	Variant cached;
+	if (!shader_cache->retrieve(p_key, cached) || cached.get_type() != Variant::ARRAY) {
+		return;
+	}
+
+	Array versions = cached;
+	for (int i = 0; i < versions.size(); i++) {
+		r_versions.insert((uint64_t)(int64_t)versions[i]);
+	}
+}
+
+void ShaderGLES2::_record_variant(CustomCode *p_cc) {
+	RBSet<uint64_t> &recorded = p_cc ? p_cc->recorded_versions : recorded_versions;
+	const String &key = p_cc ? p_cc->variants_key : variants_key;
+
+	if (key.empty() || recorded.has(conditional_version.version)) {
+		return;
+	}
+
+	recorded.insert(conditional_version.version);
+
+	Array versions;
+	for (RBSet<uint64_t>::Element *E = recorded.front(); E; E = E->next()) {
+		versions.push_back((int64_t)E->get());
+	}
+	shader_cache->store(key, versions);
+}
+
 ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 	Version *_v = version_map.getptr(conditional_version);
 
@@ -181,6 +294,8 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 	CharString code_string;
 	CharString code_string2;
 	CharString code_globals;
+	CharString vertex_globals_string;
+	CharString light_string;
 
 	CustomCode *cc = nullptr;
 
@@ -205,23 +320,23 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 
 	// vertex shader
 
-	int string_base_size = strings.size();
+	Vector<const char *> vertex_strings = strings;
 
-	strings.push_back(vertex_code0.get_data());
+	vertex_strings.push_back(vertex_code0.get_data());
 
 	if (cc) {
-		code_globals = cc->vertex_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		vertex_globals_string = cc->vertex_globals.ascii();
+		vertex_strings.push_back(vertex_globals_string.get_data());
 	}
 
-	strings.push_back(vertex_code1.get_data());
+	vertex_strings.push_back(vertex_code1.get_data());
 
 	if (cc) {
 		code_string = cc->vertex.ascii();
-		strings.push_back(code_string.get_data());
+		vertex_strings.push_back(code_string.get_data());
 	}
 
-	strings.push_back(vertex_code2.get_data());
+	vertex_strings.push_back(vertex_code2.get_data());
 
 #ifdef DEBUG_SHADER
 
@@ -229,171 +344,191 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 
 #endif
 
-	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(v.vert_id, strings.size(), &strings[0], nullptr);
-	glCompileShader(v.vert_id);
-
-	GLint status;
-
-	glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		GLsizei iloglen;
-		glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-		if (iloglen < 0) {
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-
-			ERR_PRINT("No OpenGL vertex shader compiler log. What the frick?");
-		} else {
-			if (iloglen == 0) {
-				iloglen = 4096; // buggy driver (Adreno 220+)
-			}
-
-			char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-			ilogmem[iloglen] = '\0';
-			glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
-
-			String err_string = get_shader_name() + ": Vertex shader compilation failed:\n";
-
-			err_string += ilogmem;
-
-			_display_error_with_code(err_string, strings);
-
-			Memory::free_static(ilogmem);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-		}
-
-		ERR_FAIL_V(nullptr);
-	}
-
-	strings.resize(string_base_size);
-
 	// fragment shader
 
-	strings.push_back(fragment_code0.get_data());
+	Vector<const char *> fragment_strings = strings;
+
+	fragment_strings.push_back(fragment_code0.get_data());
 
 	if (cc) {
 		code_globals = cc->fragment_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		fragment_strings.push_back(code_globals.get_data());
 	}
 
-	strings.push_back(fragment_code1.get_data());
+	fragment_strings.push_back(fragment_code1.get_data());
 
 	if (cc) {
-		code_string = cc->light.ascii();
-		strings.push_back(code_string.get_data());
+		light_string = cc->light.ascii();
+		fragment_strings.push_back(light_string.get_data());
 	}
 
-	strings.push_back(fragment_code2.get_data());
+	fragment_strings.push_back(fragment_code2.get_data());
 
 	if (cc) {
 		code_string2 = cc->fragment.ascii();
-		strings.push_back(code_string2.get_data());
+		fragment_strings.push_back(code_string2.get_data());
 	}
 
-	strings.push_back(fragment_code3.get_data());
+	fragment_strings.push_back(fragment_code3.get_data());
 
 #ifdef DEBUG_SHADER
 
 	if (cc) {
 		DEBUG_PRINT("\nFragment Code:\n\n" + String(cc->fragment_globals));
 	}
-	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string.get_data()));
+	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string2.get_data()));
 #endif
 
-	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(v.frag_id, strings.size(), &strings[0], nullptr);
-	glCompileShader(v.frag_id);
+	String binary_key;
+	bool binary_loaded = false;
 
-	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		GLsizei iloglen;
-		glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
+	if (shader_cache && shader_cache->are_program_binaries_supported()) {
+		binary_key = _get_program_cache_key(vertex_strings, fragment_strings);
+		binary_loaded = _load_program_binary(v, binary_key);
+	}
 
-		if (iloglen < 0) {
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+	if (!binary_loaded) {
+		v.vert_id = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(v.vert_id, vertex_strings.size(), &vertex_strings[0], nullptr);
+		glCompileShader(v.vert_id);
 
-			ERR_PRINT("No OpenGL fragment shader compiler log. What the frick?");
-		} else {
-			if (iloglen == 0) {
-				iloglen = 4096; // buggy driver (Adreno 220+)
-			}
+		GLint status;
 
-			char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-			ilogmem[iloglen] = '\0';
-			glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+		glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
+		if (status == GL_FALSE) {
+			GLsizei iloglen;
+			glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
 
-			String err_string = get_shader_name() + ": Fragment shader compilation failed:\n";
+			if (iloglen < 0) {
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
 
-			err_string += ilogmem;
+				ERR_PRINT("No OpenGL vertex shader compiler log. What the frick?");
+			} else {
+				if (iloglen == 0) {
+					iloglen = 4096; // buggy driver (Adreno 220+)
+				}
 
-			_display_error_with_code(err_string, strings);
+				char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
+				ilogmem[iloglen] = '\0';
+				glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
 
-			Memory::free_static(ilogmem);
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+				String err_string = get_shader_name() + ": Vertex shader compilation failed:\n";
+
+				err_string += ilogmem;
+
+				_display_error_with_code(err_string, vertex_strings);
+
+				Memory::free_static(ilogmem);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+			}
+
+			ERR_FAIL_V(nullptr);
 		}
 
-		ERR_FAIL_V(nullptr);
-	}
+		v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(v.frag_id, fragment_strings.size(), &fragment_strings[0], nullptr);
+		glCompileShader(v.frag_id);
 
-	glAttachShader(v.id, v.frag_id);
-	glAttachShader(v.id, v.vert_id);
+		glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
+		if (status == GL_FALSE) {
+			GLsizei iloglen;
+			glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
 
-	// bind the attribute locations. This has to be done before linking so that the
-	// linker doesn't assign some random indices
+			if (iloglen < 0) {
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
 
-	for (int i = 0; i < attribute_pair_count; i++) {
-		glBindAttribLocation(v.id, attribute_pairs[i].index, attribute_pairs[i].name);
-	}
+				ERR_PRINT("No OpenGL fragment shader compiler log. What the frick?");
+			} else {
+				if (iloglen == 0) {
+					iloglen = 4096; // buggy driver (Adreno 220+)
+				}
 
-	glLinkProgram(v.id);
+				char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
+				ilogmem[iloglen] = '\0';
+				glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
 
-	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
-	if (status == GL_FALSE) {
-		GLsizei iloglen;
-		glGetProgramiv(v.id, GL_INFO_LOG_LENGTH, &iloglen);
+				String err_string = get_shader_name() + ": Fragment shader compilation failed:\n";
 
-		if (iloglen < 0) {
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+				err_string += ilogmem;
+
+				_display_error_with_code(err_string, fragment_strings);
+
+				Memory::free_static(ilogmem);
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+			}
 
-			ERR_PRINT("No OpenGL program link log. What the frick?");
 			ERR_FAIL_V(nullptr);
 		}
 
-		if (iloglen == 0) {
-			iloglen = 4096; // buggy driver (Adreno 220+)
+		glAttachShader(v.id, v.frag_id);
+		glAttachShader(v.id, v.vert_id);
+
+		// bind the attribute locations. This has to be done before linking so that the
+		// linker doesn't assign some random indices
+
+		for (int i = 0; i < attribute_pair_count; i++) {
+			glBindAttribLocation(v.id, attribute_pairs[i].index, attribute_pairs[i].name);
 		}
 
-		char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-		ilogmem[iloglen] = '\0';
-		glGetProgramInfoLog(v.id, iloglen, &iloglen, ilogmem);
+#ifdef GLES_OVER_GL
+		if (!binary_key.empty()) {
+			glProgramParameteri(v.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+#endif
 
-		String err_string = get_shader_name() + ": Program linking failed:\n";
+		glLinkProgram(v.id);
 
-		err_string += ilogmem;
+		glGetProgramiv(v.id, GL_LINK_STATUS, &status);
+		if (status == GL_FALSE) {
+			GLsizei iloglen;
+			glGetProgramiv(v.id, GL_INFO_LOG_LENGTH, &iloglen);
 
-		_display_error_with_code(err_string, strings);
+			if (iloglen < 0) {
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
 
-		Memory::free_static(ilogmem);
-		glDeleteShader(v.frag_id);
-		glDeleteShader(v.vert_id);
-		glDeleteProgram(v.id);
-		v.id = 0;
+				ERR_PRINT("No OpenGL program link log. What the frick?");
+				ERR_FAIL_V(nullptr);
+			}
+
+			if (iloglen == 0) {
+				iloglen = 4096; // buggy driver (Adreno 220+)
+			}
+
+			char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
+			ilogmem[iloglen] = '\0';
+			glGetProgramInfoLog(v.id, iloglen, &iloglen, ilogmem);
+
+			String err_string = get_shader_name() + ": Program linking failed:\n";
+
+			err_string += ilogmem;
+
+			_display_error_with_code(err_string, fragment_strings);
+
+			Memory::free_static(ilogmem);
+			glDeleteShader(v.frag_id);
+			glDeleteShader(v.vert_id);
+			glDeleteProgram(v.id);
+			v.id = 0;
+
+			ERR_FAIL_V(nullptr);
+		}
 
-		ERR_FAIL_V(nullptr);
+		if (!binary_key.empty()) {
+			_store_program_binary(v, binary_key);
+		}
 	}
 
 	// get uniform locations
@@ -439,6 +574,10 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 		cc->versions.insert(conditional_version.version);
 	}
 
+	if (shader_cache) {
+		_record_variant(cc);
+	}
+
 	return &v;
 }
 
@@ -533,6 +672,11 @@ void ShaderGLES2::setup(
 	}
 
 	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &max_image_units);
+
+	if (shader_cache) {
+		variants_key = shader_cache->make_key("variants", get_shader_name() + "|" + vertex_code + "|" + fragment_code, false);
+		_load_recorded_variants(variants_key, recorded_versions);
+	}
 }
 
 void ShaderGLES2::finish() {
@@ -593,6 +737,16 @@ void ShaderGLES2::set_custom_shader_code(uint32_t p_code_id,
 	cc->custom_defines = p_custom_defines;
 	cc->texture_uniforms = p_texture_uniforms;
 	cc->version++;
+
+	if (shader_cache) {
+		String data = get_shader_name() + "|" + p_vertex + "|" + p_vertex_globals + "|" + p_fragment + "|" + p_light + "|" + p_fragment_globals;
+		for (int i = 0; i < p_custom_defines.size(); i++) {
+			data += "|" + String(p_custom_defines[i].get_data());
+		}
+
+		cc->variants_key = shader_cache->make_key("variants", data, false);
+		_load_recorded_variants(cc->variants_key, cc->recorded_versions);
+	}
 }
 
 void ShaderGLES2::set_custom_shader(uint32_t p_code_id) {
@@ -625,6 +779,35 @@ void ShaderGLES2::free_custom_shader(uint32_t p_code_id) {
 	custom_code_map.erase(p_code_id);
 }
 
+void ShaderGLES2::warm_up(uint32_t p_code_id) {
+	const RBSet<uint64_t> *recorded = &recorded_versions;
+	if (p_code_id != CUSTOM_SHADER_DISABLED) {
+		CustomCode *cc = custom_code_map.getptr(p_code_id);
+		ERR_FAIL_COND(!cc);
+		recorded = &cc->recorded_versions;
+	}
+
+	if (recorded->empty()) {
+		return;
+	}
+
+	// Compiling changes the program in use, so whatever shader was bound has to bind again.
+	if (active) {
+		active->unbind();
+	}
+
+	VersionKey prev_version = conditional_version;
+
+	for (RBSet<uint64_t>::Element *E = recorded->front(); E; E = E->next()) {
+		conditional_version.version = E->get();
+		conditional_version.code_version = p_code_id;
+		get_current_version();
+	}
+
+	conditional_version = prev_version;
+	version = nullptr;
+}
+
 void ShaderGLES2::use_material(void *p_material) {
 	RasterizerStorageGLES2::Material *material = (RasterizerStorageGLES2::Material *)p_material;
 
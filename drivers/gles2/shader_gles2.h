@@ -22,6 +22,7 @@
 #include <stdio.h>
 
 class RasterizerStorageGLES2;
+class ShaderCacheGLES2;
 
 class ShaderGLES2 {
 	static String _mkid(const String &p_id);
@@ -75,6 +76,10 @@ private:
 		Vector<StringName> custom_uniforms;
 		Vector<CharString> custom_defines;
 		RBSet<uint64_t> versions;
+
+		// Variants this code was used with in previous runs, for warm_up().
+		String variants_key;
+		RBSet<uint64_t> recorded_versions;
 	};
 
 	struct Version {
@@ -140,6 +145,15 @@ private:
 
 	Vector<CharString> custom_defines;
 
+	String variants_key;
+	RBSet<uint64_t> recorded_versions;
+
+	String _get_program_cache_key(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const;
+	bool _load_program_binary(Version &v, const String &p_key);
+	void _store_program_binary(const Version &v, const String &p_key);
+	void _load_recorded_variants(const String &p_key, RBSet<uint64_t> &r_versions);
+	void _record_variant(CustomCode *p_cc);
+
 	Version *get_current_version();
 
 	static ShaderGLES2 *active;
@@ -175,6 +189,9 @@ public:
 	GLint get_uniform_location(const String &p_name) const;
 	GLint get_uniform_location(int p_index) const;
 
+	// Set by the storage when the on disk shader cache is enabled.
+	static ShaderCacheGLES2 *shader_cache;
+
 	static _FORCE_INLINE_ ShaderGLES2 *get_active() { return active; }
 	bool bind();
 	void unbind();
@@ -197,6 +214,9 @@ public:
 	void set_custom_shader(uint32_t p_code_id);
 	void free_custom_shader(uint32_t p_code_id);
 
+	// Compiles the variants recorded for this shader (or custom code) in previous runs, so they don't hitch on first use.
+	void warm_up(uint32_t p_code_id = CUSTOM_SHADER_DISABLED);
+
 	uint64_t get_version_key() const { return conditional_version.version; }
 
 	// this void* is actually a RasterizerStorageGLES2::Material, but C++ doesn't
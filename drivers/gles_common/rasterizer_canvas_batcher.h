@@ -203,6 +203,11 @@ public:
 		TileMode tile_mode;
 		BatchVector2 tex_pixel_size;
 		uint32_t flags;
+
+		// runtime texture atlas, when a copy of the texture is available in one of its pages
+		int atlas_batch_tex_id; // -1 if not in the atlas
+		BatchVector2 atlas_position; // in pixels of the page
+		BatchVector2 atlas_size;
 	};
 
 	// items in a list to be sorted prior to joining
@@ -288,6 +293,8 @@ public:
 			settings_uv_contract = false;
 			settings_uv_contract_amount = 0.0f;
 
+			settings_use_texture_atlas = false;
+
 			buffer_mode_batch_upload_send_null = true;
 			buffer_mode_batch_upload_flag_stream = false;
 
@@ -417,6 +424,8 @@ public:
 		bool settings_uv_contract;
 		float settings_uv_contract_amount;
 
+		bool settings_use_texture_atlas;
+
 		// only done on diagnose frame
 		void reset_stats() {
 			stats_items_sorted = 0;
@@ -434,6 +443,7 @@ public:
 			// half way through a list of commands
 			curr_batch = nullptr;
 			batch_tex_id = -1;
+			source_batch_tex_id = -1;
 			texpixel_size = Vector2(1, 1);
 			contract_uvs = false;
 
@@ -455,6 +465,8 @@ public:
 
 		Batch *curr_batch;
 		int batch_tex_id;
+		int source_batch_tex_id; // differs from batch_tex_id when the texture is drawn from the atlas
+		bool use_texture_atlas; // custom shaders may rely on the original texture, don't remap theirs
 
 		bool is_single_item;
 		bool use_attrib_transform;
@@ -949,6 +961,20 @@ PREAMBLE(int)::_batch_find_or_create_tex(const RID &p_texture, const RID &p_norm
 		new_batch_tex.tile_mode = BatchTex::TILE_OFF;
 	}
 
+	// if the texture has been copied into the runtime atlas, rects can use the page instead,
+	// and join with the other textures in it
+	new_batch_tex.atlas_batch_tex_id = -1;
+
+	if (bdata.settings_use_texture_atlas && texture && !p_normal.is_valid() && !p_tile) {
+		RID page;
+		Vector2 position;
+		if (get_storage()->texture_atlas_get_region(texture, page, position)) {
+			new_batch_tex.atlas_batch_tex_id = _batch_find_or_create_tex(page, RID(), false, -1);
+			new_batch_tex.atlas_position.set(position);
+			new_batch_tex.atlas_size.set(texture->width, texture->height);
+		}
+	}
+
 	// push back
 	bdata.batch_textures.push_back(new_batch_tex);
 
@@ -1007,6 +1033,8 @@ PREAMBLE(void)::batch_initialize() {
 	bdata.settings_uv_contract = GLOBAL_GET("rendering/batching/precision/uv_contract");
 	bdata.settings_uv_contract_amount = (float)GLOBAL_GET("rendering/batching/precision/uv_contract_amount") / 1000000.0f;
 
+	bdata.settings_use_texture_atlas = GLOBAL_GET("rendering/batching/options/use_texture_atlas");
+
 	// we can use the threshold to determine whether to turn scissoring off or on
 	bdata.settings_scissor_threshold = GLOBAL_GET("rendering/batching/lights/scissor_area_threshold");
 	if (bdata.settings_scissor_threshold > 0.999f) {
@@ -1805,7 +1833,22 @@ bool C_PREAMBLE::_prefill_rect(RasterizerCanvas::Item::CommandRect *rect, FillSt
 	// This means we have a potentially rather slow step to identify which texture combo
 	// using the RIDs.
 	int old_batch_tex_id = r_fill_state.batch_tex_id;
-	r_fill_state.batch_tex_id = _batch_find_or_create_tex(rect->texture, rect->normal_map, rect->flags & RasterizerCanvas::CANVAS_RECT_TILE, old_batch_tex_id);
+	r_fill_state.source_batch_tex_id = _batch_find_or_create_tex(rect->texture, rect->normal_map, rect->flags & RasterizerCanvas::CANVAS_RECT_TILE, r_fill_state.source_batch_tex_id);
+	r_fill_state.batch_tex_id = r_fill_state.source_batch_tex_id;
+
+	// draw from the atlas page instead, as long as the region stays within the texture
+	const BatchTex *atlas_source = nullptr;
+	if (r_fill_state.use_texture_atlas) {
+		const BatchTex &source = bdata.batch_textures[r_fill_state.source_batch_tex_id];
+		if (source.atlas_batch_tex_id != -1) {
+			Vector2 atlas_size;
+			source.atlas_size.to(atlas_size);
+			if (!(rect->flags & RasterizerCanvas::CANVAS_RECT_REGION) || Rect2(Vector2(), atlas_size).encloses(rect->source.abs())) {
+				atlas_source = &source;
+				r_fill_state.batch_tex_id = source.atlas_batch_tex_id;
+			}
+		}
+	}
 
 	//r_fill_state.use_light_angles = send_light_angles;
 	if (SEND_LIGHT_ANGLES) {
@@ -1906,6 +1949,13 @@ bool C_PREAMBLE::_prefill_rect(RasterizerCanvas::Item::CommandRect *rect, FillSt
 		src_min = rect->source.position;
 		src_max = src_min + rect->source.size;
 
+		if (atlas_source) {
+			Vector2 atlas_position;
+			atlas_source->atlas_position.to(atlas_position);
+			src_min += atlas_position;
+			src_max += atlas_position;
+		}
+
 		src_min *= r_fill_state.texpixel_size;
 		src_max *= r_fill_state.texpixel_size;
 
@@ -1919,6 +1969,14 @@ bool C_PREAMBLE::_prefill_rect(RasterizerCanvas::Item::CommandRect *rect, FillSt
 			src_max.x -= uv_epsilon;
 			src_max.y -= uv_epsilon;
 		}
+	} else if (atlas_source) {
+		// the padding around the copy in the page covers the filtering, no need to contract
+		atlas_source->atlas_position.to(src_min);
+		atlas_source->atlas_size.to(src_max);
+		src_max += src_min;
+
+		src_min *= r_fill_state.texpixel_size;
+		src_max *= r_fill_state.texpixel_size;
 	} else {
 		src_min = Vector2(0, 0);
 		src_max = Vector2(1, 1);
@@ -2482,6 +2540,8 @@ PREAMBLE(bool)::prefill_joined_item(FillState &r_fill_state, int &r_command_star
 	// whether to multiply final modulate on the CPU, or pass it in the FVF and apply in the shader
 	bool multiply_final_modulate = true;
 
+	r_fill_state.use_texture_atlas = bdata.settings_use_texture_atlas && !(p_material && p_material->shader);
+
 	if (r_fill_state.is_single_item || bdata.use_modulate || bdata.use_large_verts) {
 		multiply_final_modulate = false;
 	}
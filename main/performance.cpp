@@ -46,6 +46,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_2D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_2D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(AUDIO_ACTIVE_VOICES);
+	BIND_ENUM_CONSTANT(AUDIO_VIRTUAL_VOICES);
+	BIND_ENUM_CONSTANT(GUI_LAYOUT_PASSES_IN_FRAME);
+	BIND_ENUM_CONSTANT(GUI_RESIZE_NOTIFICATIONS_IN_FRAME);
+	BIND_ENUM_CONSTANT(OBJECT_POOL_HITS);
+	BIND_ENUM_CONSTANT(OBJECT_POOL_MISSES);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_NARROWPHASE_SOLVED);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_NARROWPHASE_CACHED);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -59,6 +67,42 @@ float Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+float Performance::_get_layout_passes() const {
+	MainLoop *ml = OS::get_singleton()->get_main_loop();
+	SceneTree *sml = Object::cast_to<SceneTree>(ml);
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_layout_passes_in_frame();
+}
+
+float Performance::_get_resize_notifications() const {
+	MainLoop *ml = OS::get_singleton()->get_main_loop();
+	SceneTree *sml = Object::cast_to<SceneTree>(ml);
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_resize_notifications_in_frame();
+}
+
+float Performance::_get_pool_hits() const {
+	MainLoop *ml = OS::get_singleton()->get_main_loop();
+	SceneTree *sml = Object::cast_to<SceneTree>(ml);
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_pool_hits();
+}
+
+float Performance::_get_pool_misses() const {
+	MainLoop *ml = OS::get_singleton()->get_main_loop();
+	SceneTree *sml = Object::cast_to<SceneTree>(ml);
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_pool_misses();
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -92,6 +136,14 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_2d/collision_pairs",
 		"physics_2d/islands",
 		"audio/output_latency",
+		"audio/active_voices",
+		"audio/virtual_voices",
+		"gui/layout_passes",
+		"gui/resize_notifications",
+		"object/pool_hits",
+		"object/pool_misses",
+		"physics_2d/narrowphase_solved",
+		"physics_2d/narrowphase_cached",
 	};
 
 	return names[p_monitor];
@@ -157,6 +209,22 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case AUDIO_ACTIVE_VOICES:
+			return AudioServer::get_singleton()->get_active_voice_count();
+		case AUDIO_VIRTUAL_VOICES:
+			return AudioServer::get_singleton()->get_virtual_voice_count();
+		case GUI_LAYOUT_PASSES_IN_FRAME:
+			return _get_layout_passes();
+		case GUI_RESIZE_NOTIFICATIONS_IN_FRAME:
+			return _get_resize_notifications();
+		case OBJECT_POOL_HITS:
+			return _get_pool_hits();
+		case OBJECT_POOL_MISSES:
+			return _get_pool_misses();
+		case PHYSICS_2D_NARROWPHASE_SOLVED:
+			return Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_NARROWPHASE_SOLVED);
+		case PHYSICS_2D_NARROWPHASE_CACHED:
+			return Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_NARROWPHASE_CACHED);
 
 		default: {
 		}
@@ -199,6 +267,14 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 	};
 
 	return types[p_monitor];
@@ -16,6 +16,10 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	float _get_node_count() const;
+	float _get_layout_passes() const;
+	float _get_resize_notifications() const;
+	float _get_pool_hits() const;
+	float _get_pool_misses() const;
 
 	float _process_time;
 	float _physics_process_time;
@@ -53,6 +57,14 @@ public:
 		PHYSICS_2D_COLLISION_PAIRS,
 		PHYSICS_2D_ISLAND_COUNT,
 		AUDIO_OUTPUT_LATENCY,
+		AUDIO_ACTIVE_VOICES,
+		AUDIO_VIRTUAL_VOICES,
+		GUI_LAYOUT_PASSES_IN_FRAME,
+		GUI_RESIZE_NOTIFICATIONS_IN_FRAME,
+		OBJECT_POOL_HITS,
+		OBJECT_POOL_MISSES,
+		PHYSICS_2D_NARROWPHASE_SOLVED,
+		PHYSICS_2D_NARROWPHASE_CACHED,
 		MONITOR_MAX
 	};
 
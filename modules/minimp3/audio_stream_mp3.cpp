@@ -14,6 +14,11 @@
 void AudioStreamPlaybackMP3::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 	ERR_FAIL_COND(!active);
 
+	if (seek_pending) {
+		mp3dec_ex_seek(mp3d, frames_mixed * mp3_stream->channels);
+		seek_pending = false;
+	}
+
 	int todo = p_frames;
 
 	while (todo && active) {
@@ -82,9 +87,34 @@ void AudioStreamPlaybackMP3::seek(float p_time) {
 	}
 
 	frames_mixed = uint32_t(mp3_stream->sample_rate * p_time);
+	seek_pending = false;
 	mp3dec_ex_seek(mp3d, frames_mixed * mp3_stream->channels);
 }
 
+void AudioStreamPlaybackMP3::skip(float p_rate_scale, int p_frames) {
+	if (!active) {
+		return;
+	}
+
+	int64_t frame = int64_t(frames_mixed) + _skip_resample(p_rate_scale, p_frames);
+	int64_t length = int64_t(mp3_stream->length * mp3_stream->sample_rate);
+
+	if (frame >= length) {
+		int64_t loop_from = int64_t(mp3_stream->loop_offset * mp3_stream->sample_rate);
+
+		if (!mp3_stream->loop || loop_from >= length) {
+			active = false;
+			return;
+		}
+
+		loops += (frame - length) / (length - loop_from) + 1;
+		frame = loop_from + (frame - length) % (length - loop_from);
+	}
+
+	frames_mixed = uint32_t(MAX(frame, 0));
+	seek_pending = true;
+}
+
 AudioStreamPlaybackMP3::~AudioStreamPlaybackMP3() {
 	if (mp3d) {
 		mp3dec_ex_close(mp3d);
@@ -17,6 +17,7 @@ class AudioStreamPlaybackMP3 : public AudioStreamPlaybackResampled {
 	mp3dec_ex_t *mp3d = nullptr;
 	uint32_t frames_mixed = 0;
 	bool active = false;
+	bool seek_pending = false;
 	int loops = 0;
 
 	friend class AudioStreamMP3;
@@ -37,6 +38,8 @@ public:
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
 
+	virtual void skip(float p_rate_scale, int p_frames);
+
 	AudioStreamPlaybackMP3() {}
 	~AudioStreamPlaybackMP3();
 };
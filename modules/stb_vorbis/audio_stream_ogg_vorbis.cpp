@@ -9,6 +9,11 @@
 void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 	ERR_FAIL_COND(!active);
 
+	if (seek_pending) {
+		stb_vorbis_seek(ogg_stream, frames_mixed);
+		seek_pending = false;
+	}
+
 	int todo = p_frames;
 
 	int start_buffer = 0;
@@ -82,10 +87,35 @@ void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 		p_time = 0;
 	}
 	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
+	seek_pending = false;
 
 	stb_vorbis_seek(ogg_stream, frames_mixed);
 }
 
+void AudioStreamPlaybackOGGVorbis::skip(float p_rate_scale, int p_frames) {
+	if (!active) {
+		return;
+	}
+
+	int64_t frame = int64_t(frames_mixed) + _skip_resample(p_rate_scale, p_frames);
+	int64_t length = int64_t(vorbis_stream->length * vorbis_stream->sample_rate);
+
+	if (frame >= length) {
+		int64_t loop_from = int64_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+
+		if (!vorbis_stream->loop || loop_from >= length) {
+			active = false;
+			return;
+		}
+
+		loops += (frame - length) / (length - loop_from) + 1;
+		frame = loop_from + (frame - length) % (length - loop_from);
+	}
+
+	frames_mixed = uint32_t(MAX(frame, 0));
+	seek_pending = true;
+}
+
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
 	if (ogg_alloc.alloc_buffer) {
 		stb_vorbis_close(ogg_stream);
@@ -18,6 +18,7 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 	stb_vorbis_alloc ogg_alloc;
 	uint32_t frames_mixed;
 	bool active;
+	bool seek_pending;
 	int loops;
 
 	friend class AudioStreamOGGVorbis;
@@ -38,7 +39,9 @@ public:
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
 
-	AudioStreamPlaybackOGGVorbis() {}
+	virtual void skip(float p_rate_scale, int p_frames);
+
+	AudioStreamPlaybackOGGVorbis() { seek_pending = false; }
 	~AudioStreamPlaybackOGGVorbis();
 };
 
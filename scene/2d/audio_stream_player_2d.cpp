@@ -10,6 +10,7 @@
 #include "scene/2d/listener_2d.h"
 #include "scene/main/viewport.h"
 #include "scene/resources/world_2d.h"
+#include "servers/audio/audio_mix.h"
 #include "servers/audio/audio_stream.h"
 #include "servers/audio_server.h"
 #include "servers/physics_2d_server.h"
@@ -25,6 +26,12 @@ void AudioStreamPlayer2D::_mix_audio() {
 		setseek.set(-1.0); //reset seek
 	}
 
+	if (voice_virtualized) {
+		//coming back from a virtual voice, ramp the volume in
+		voice_virtualized = false;
+		stream_paused_fade_in = true;
+	}
+
 	//get data
 	AudioFrame *buffer = mix_buffer.ptrw();
 	int buffer_size = mix_buffer.size();
@@ -66,7 +73,6 @@ void AudioStreamPlayer2D::_mix_audio() {
 		AudioFrame target_volume = stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol;
 		AudioFrame vol_prev = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol;
 		AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
-		AudioFrame vol = vol_prev;
 
 		int cc = AudioServer::get_singleton()->get_channel_count();
 
@@ -77,10 +83,7 @@ void AudioStreamPlayer2D::_mix_audio() {
 
 			AudioFrame *target = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.bus_index, 0);
 
-			for (int j = 0; j < buffer_size; j++) {
-				target[j] += buffer[j] * vol;
-				vol += vol_inc;
-			}
+			AudioMix::accumulate_ramp(target, buffer, vol_prev, vol_inc, buffer_size);
 
 		} else {
 			AudioFrame *targets[4];
@@ -99,12 +102,8 @@ void AudioStreamPlayer2D::_mix_audio() {
 				continue;
 			}
 
-			for (int j = 0; j < buffer_size; j++) {
-				AudioFrame frame = buffer[j] * vol;
-				for (int k = 0; k < cc; k++) {
-					targets[k][j] += frame;
-				}
-				vol += vol_inc;
+			for (int k = 0; k < cc; k++) {
+				AudioMix::accumulate_ramp(targets[k], buffer, vol_prev, vol_inc, buffer_size);
 			}
 		}
 
@@ -123,16 +122,55 @@ void AudioStreamPlayer2D::_mix_audio() {
 	stream_paused_fade_out = false;
 }
 
+bool AudioStreamPlayer2D::_query_voice(AudioServer::VoiceState &r_state) {
+	if (!stream_playback.is_valid() || !active.is_set() || stream_paused || stream_paused_fade_in || setseek.get() >= 0.0) {
+		return false;
+	}
+
+	int oc = output_count.get();
+
+	r_state.bus_index = oc > 0 ? outputs[0].bus_index : AudioServer::get_singleton()->thread_find_bus_index(bus);
+	r_state.priority = voice_priority;
+	r_state.audibility = 0;
+
+	for (int i = 0; i < oc; i++) {
+		r_state.audibility = MAX(r_state.audibility, MAX(outputs[i].vol.l, outputs[i].vol.r));
+	}
+
+	return true;
+}
+
+void AudioStreamPlayer2D::_skip_audio(int p_frames) {
+	if (!voice_virtualized) {
+		//fade out what was playing before going silent
+		stream_paused_fade_out = true;
+		_mix_audio();
+		p_frames -= MIN(p_frames, MIN(mix_buffer.size(), 128));
+		voice_virtualized = true;
+	}
+
+	if (active.is_set()) {
+		stream_playback->skip(pitch_scale, p_frames);
+
+		if (!stream_playback->is_playing()) {
+			active.clear();
+		}
+	}
+
+	//keep the outputs updating, so the voice can come back once it is audible
+	output_ready.clear();
+}
+
 void AudioStreamPlayer2D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_ENTER_TREE) {
-		AudioServer::get_singleton()->add_callback(_mix_audios, this);
+		AudioServer::get_singleton()->add_voice(_mix_audios, _query_voices, _skip_audios, this);
 		if (autoplay && !Engine::get_singleton()->is_editor_hint()) {
 			play();
 		}
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
-		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		AudioServer::get_singleton()->remove_voice(this);
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -428,6 +466,14 @@ uint32_t AudioStreamPlayer2D::get_area_mask() const {
 	return area_mask;
 }
 
+void AudioStreamPlayer2D::set_voice_priority(int p_priority) {
+	voice_priority = p_priority;
+}
+
+int AudioStreamPlayer2D::get_voice_priority() const {
+	return voice_priority;
+}
+
 void AudioStreamPlayer2D::set_stream_paused(bool p_pause) {
 	if (p_pause != stream_paused) {
 		stream_paused = p_pause;
@@ -488,6 +534,9 @@ void AudioStreamPlayer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_area_mask", "mask"), &AudioStreamPlayer2D::set_area_mask);
 	ClassDB::bind_method(D_METHOD("get_area_mask"), &AudioStreamPlayer2D::get_area_mask);
 
+	ClassDB::bind_method(D_METHOD("set_voice_priority", "priority"), &AudioStreamPlayer2D::set_voice_priority);
+	ClassDB::bind_method(D_METHOD("get_voice_priority"), &AudioStreamPlayer2D::get_voice_priority);
+
 	ClassDB::bind_method(D_METHOD("set_stream_paused", "pause"), &AudioStreamPlayer2D::set_stream_paused);
 	ClassDB::bind_method(D_METHOD("get_stream_paused"), &AudioStreamPlayer2D::get_stream_paused);
 
@@ -509,6 +558,7 @@ void AudioStreamPlayer2D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "panning_strength", PROPERTY_HINT_RANGE, "0,3,0.01,or_greater"), "set_panning_strength", "get_panning_strength");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "voice_priority"), "set_voice_priority", "get_voice_priority");
 
 	ADD_SIGNAL(MethodInfo("finished"));
 }
@@ -526,6 +576,8 @@ AudioStreamPlayer2D::AudioStreamPlayer2D() {
 	stream_paused = false;
 	stream_paused_fade_in = false;
 	stream_paused_fade_out = false;
+	voice_priority = 0;
+	voice_virtualized = false;
 	AudioServer::get_singleton()->connect("bus_layout_changed", this, "_bus_layout_changed");
 	cached_global_panning_strength = ProjectSettings::get_singleton()->get("audio/2d_panning_strength");
 }
@@ -8,6 +8,7 @@
 #include "core/object/reference.h"
 #include "core/os/safe_refcount.h"
 #include "scene/main/node_2d.h"
+#include "servers/audio_server.h"
 
 class AudioStreamPlayback;
 class AudioStream;
@@ -51,10 +52,17 @@ private:
 	bool stream_paused_fade_in;
 	bool stream_paused_fade_out;
 	StringName bus;
+	int voice_priority;
+	bool voice_virtualized;
 
 	void _mix_audio();
 	static void _mix_audios(void *self) { reinterpret_cast<AudioStreamPlayer2D *>(self)->_mix_audio(); }
 
+	bool _query_voice(AudioServer::VoiceState &r_state);
+	static bool _query_voices(void *self, AudioServer::VoiceState &r_state) { return reinterpret_cast<AudioStreamPlayer2D *>(self)->_query_voice(r_state); }
+	void _skip_audio(int p_frames);
+	static void _skip_audios(void *self, int p_frames) { reinterpret_cast<AudioStreamPlayer2D *>(self)->_skip_audio(p_frames); }
+
 	void _set_playing(bool p_enable);
 	bool _is_active() const;
 
@@ -107,6 +115,9 @@ public:
 	void set_area_mask(uint32_t p_mask);
 	uint32_t get_area_mask() const;
 
+	void set_voice_priority(int p_priority);
+	int get_voice_priority() const;
+
 	void set_stream_paused(bool p_pause);
 	bool get_stream_paused() const;
 
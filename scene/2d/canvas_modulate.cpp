@@ -52,10 +52,7 @@ String CanvasModulate::get_configuration_warning() const {
 		return warning;
 	}
 
-	List<Node *> nodes;
-	get_tree()->get_nodes_in_group("_canvas_modulate_" + itos(get_canvas().get_id()), &nodes);
-
-	if (nodes.size() > 1) {
+	if (get_tree()->get_node_count_in_group("_canvas_modulate_" + itos(get_canvas().get_id())) > 1) {
 		if (warning != String()) {
 			warning += "\n\n";
 		}
@@ -8,10 +8,119 @@
 #include "core/os/os.h"
 #include "core/containers/fixed_array.h"
 #include "core/math/transform_interpolator.h"
+#include "core/config/project_settings.h"
 #include "scene/main/canvas_item.h"
+#include "scene/resources/curve.h"
+#include "scene/resources/gradient.h"
 #include "scene/resources/texture.h"
 #include "servers/rendering_server.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPU_PARTICLES_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CPU_PARTICLES_NEON
+#include <arm_neon.h>
+#endif
+
+ThreadWorkPool CPUParticles2D::thread_pool;
+int CPUParticles2D::thread_pool_size = 0;
+
+template <class T>
+static void _resize_and_fill(LocalVector<T> &r_vector, uint32_t p_size, const T &p_value) {
+	r_vector.resize(p_size);
+	T *w = r_vector.ptr();
+	for (uint32_t i = 0; i < p_size; i++) {
+		w[i] = p_value;
+	}
+}
+
+// r_pos += p_vel * p_delta, for p_count particles.
+static void _integrate_positions(float *r_pos_x, float *r_pos_y, const float *p_vel_x, const float *p_vel_y, const float *p_delta, int p_count) {
+	int i = 0;
+
+#if defined(CPU_PARTICLES_SSE2)
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 delta = _mm_loadu_ps(p_delta + i);
+		_mm_storeu_ps(r_pos_x + i, _mm_add_ps(_mm_loadu_ps(r_pos_x + i), _mm_mul_ps(_mm_loadu_ps(p_vel_x + i), delta)));
+		_mm_storeu_ps(r_pos_y + i, _mm_add_ps(_mm_loadu_ps(r_pos_y + i), _mm_mul_ps(_mm_loadu_ps(p_vel_y + i), delta)));
+	}
+#elif defined(CPU_PARTICLES_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4_t delta = vld1q_f32(p_delta + i);
+		vst1q_f32(r_pos_x + i, vmlaq_f32(vld1q_f32(r_pos_x + i), vld1q_f32(p_vel_x + i), delta));
+		vst1q_f32(r_pos_y + i, vmlaq_f32(vld1q_f32(r_pos_y + i), vld1q_f32(p_vel_y + i), delta));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_pos_x[i] += p_vel_x[i] * p_delta[i];
+		r_pos_y[i] += p_vel_y[i] * p_delta[i];
+	}
+}
+
+// Linear lookup in a table of p_size + 2 samples (the last one repeated), covering offsets 0 to 1.
+static _FORCE_INLINE_ float _sample_table(const float *p_table, int p_size, float p_offset) {
+	float x = p_offset > 0.0f ? (p_offset < 1.0f ? p_offset : 1.0f) : 0.0f; // Also catches NaN.
+	x *= p_size;
+	int idx = int(x);
+	return Math::lerp(p_table[idx], p_table[idx + 1], x - idx);
+}
+
+static _FORCE_INLINE_ Color _sample_table(const Color *p_table, int p_size, float p_offset) {
+	float x = p_offset > 0.0f ? (p_offset < 1.0f ? p_offset : 1.0f) : 0.0f;
+	x *= p_size;
+	int idx = int(x);
+	return p_table[idx].linear_interpolate(p_table[idx + 1], x - idx);
+}
+
+// Same as above, for p_count offsets at once.
+static void _sample_table(const float *p_table, int p_size, const float *p_offsets, float *r_values, int p_count) {
+	int i = 0;
+
+#if defined(CPU_PARTICLES_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 size = _mm_set1_ps(float(p_size));
+	int32_t idx[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		// max() returns its second operand for NaN, so they end up at offset 0.
+		__m128 x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p_offsets + i), zero), one), size);
+		__m128i xi = _mm_cvttps_epi32(x);
+		__m128 frac = _mm_sub_ps(x, _mm_cvtepi32_ps(xi));
+		_mm_storeu_si128((__m128i *)idx, xi);
+
+		__m128 a = _mm_setr_ps(p_table[idx[0]], p_table[idx[1]], p_table[idx[2]], p_table[idx[3]]);
+		__m128 b = _mm_setr_ps(p_table[idx[0] + 1], p_table[idx[1] + 1], p_table[idx[2] + 1], p_table[idx[3] + 1]);
+		_mm_storeu_ps(r_values + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac)));
+	}
+#elif defined(CPU_PARTICLES_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	int32_t idx[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4_t offset = vld1q_f32(p_offsets + i);
+		offset = vbslq_f32(vceqq_f32(offset, offset), offset, zero); // NaN to 0.
+		float32x4_t x = vmulq_n_f32(vminq_f32(vmaxq_f32(offset, zero), one), float(p_size));
+		int32x4_t xi = vcvtq_s32_f32(x);
+		float32x4_t frac = vsubq_f32(x, vcvtq_f32_s32(xi));
+		vst1q_s32(idx, xi);
+
+		float a_arr[4] = { p_table[idx[0]], p_table[idx[1]], p_table[idx[2]], p_table[idx[3]] };
+		float b_arr[4] = { p_table[idx[0] + 1], p_table[idx[1] + 1], p_table[idx[2] + 1], p_table[idx[3] + 1] };
+		float32x4_t a = vld1q_f32(a_arr);
+		float32x4_t b = vld1q_f32(b_arr);
+		vst1q_f32(r_values + i, vmlaq_f32(a, vsubq_f32(b, a), frac));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_values[i] = _sample_table(p_table, p_size, p_offsets[i]);
+	}
+}
+
 void CPUParticles2D::set_emitting(bool p_emitting) {
 	if (emitting == p_emitting) {
 		return;
@@ -26,16 +135,35 @@ void CPUParticles2D::set_emitting(bool p_emitting) {
 void CPUParticles2D::set_amount(int p_amount) {
 	ERR_FAIL_COND_MSG(p_amount < 1, "Amount of particles must be greater than 0.");
 
-	particles.resize(p_amount);
+	particle_count = p_amount;
 	particles_prev.resize(p_amount);
 	{
-		PoolVector<Particle>::Write w = particles.write();
+		ParticleArrays &pa = particles;
 
-		// each particle must be set to false
+		// each particle must be set to inactive
 		// zeroing the data also prevents uninitialized memory being sent to GPU
-		memset(static_cast<void *>(&w[0]), 0, p_amount * sizeof(Particle));
-		// cast to prevent compiler warning .. note this relies on Particle not containing any complex types.
-		// an alternative is to use some zero method per item but the generated code will be far less efficient.
+		_resize_and_fill(pa.pos_x, p_amount, 0.0f);
+		_resize_and_fill(pa.pos_y, p_amount, 0.0f);
+		_resize_and_fill(pa.vel_x, p_amount, 0.0f);
+		_resize_and_fill(pa.vel_y, p_amount, 0.0f);
+		_resize_and_fill(pa.axis_x, p_amount, Vector2());
+		_resize_and_fill(pa.axis_y, p_amount, Vector2());
+		_resize_and_fill(pa.color, p_amount, Color(0, 0, 0, 0));
+		_resize_and_fill(pa.phase, p_amount, 0.0f);
+		_resize_and_fill(pa.anim_phase, p_amount, 0.0f);
+		_resize_and_fill(pa.rotation, p_amount, 0.0f);
+		_resize_and_fill(pa.time, p_amount, 0.0f);
+		_resize_and_fill(pa.lifetime, p_amount, 0.0f);
+		_resize_and_fill(pa.angle_rand, p_amount, 0.0f);
+		_resize_and_fill(pa.scale_rand, p_amount, 0.0f);
+		_resize_and_fill(pa.hue_rot_rand, p_amount, 0.0f);
+		_resize_and_fill(pa.anim_offset_rand, p_amount, 0.0f);
+		_resize_and_fill(pa.start_color_rand, p_amount, Color(0, 0, 0, 0));
+		_resize_and_fill(pa.base_color, p_amount, Color(0, 0, 0, 0));
+		_resize_and_fill(pa.seed, p_amount, uint32_t(0));
+		_resize_and_fill(pa.active, p_amount, uint8_t(0));
+		_resize_and_fill(pa.step, p_amount, uint8_t(PARTICLE_STEP_SKIP));
+		_resize_and_fill(pa.delta, p_amount, 0.0f);
 
 		for (int i = 0; i < p_amount; i++) {
 			particles_prev[i].blank();
@@ -111,7 +239,7 @@ bool CPUParticles2D::is_emitting() const {
 	return emitting;
 }
 int CPUParticles2D::get_amount() const {
-	return particles.size();
+	return particle_count;
 }
 float CPUParticles2D::get_lifetime() const {
 	return lifetime;
@@ -281,11 +409,10 @@ void CPUParticles2D::restart() {
 	emitting = false;
 
 	{
-		int pc = particles.size();
-		PoolVector<Particle>::Write w = particles.write();
+		uint8_t *active = particles.active.ptr();
 
-		for (int i = 0; i < pc; i++) {
-			w[i].active = false;
+		for (int i = 0; i < particle_count; i++) {
+			active[i] = false;
 		}
 	}
 
@@ -342,8 +469,26 @@ static void _adjust_curve_range(const Ref<Curve> &p_curve, float p_min, float p_
 void CPUParticles2D::set_param_curve(Parameter p_param, const Ref<Curve> &p_curve) {
 	ERR_FAIL_INDEX(p_param, PARAM_MAX);
 
+	Ref<Curve> old_curve = curve_parameters[p_param];
 	curve_parameters[p_param] = p_curve;
 
+	if (old_curve.is_valid() && old_curve != p_curve) {
+		bool still_used = false;
+		for (int i = 0; i < PARAM_MAX; i++) {
+			if (curve_parameters[i] == old_curve) {
+				still_used = true;
+				break;
+			}
+		}
+		if (!still_used) {
+			old_curve->disconnect(CoreStringNames::get_singleton()->changed, this, "_curves_changed");
+		}
+	}
+	if (p_curve.is_valid() && !p_curve->is_connected(CoreStringNames::get_singleton()->changed, this, "_curves_changed")) {
+		curve_parameters[p_param]->connect(CoreStringNames::get_singleton()->changed, this, "_curves_changed");
+	}
+	curve_tables_dirty = true;
+
 	switch (p_param) {
 		case PARAM_INITIAL_LINEAR_VELOCITY: {
 			//do none for this one
@@ -398,7 +543,20 @@ Color CPUParticles2D::get_color() const {
 }
 
 void CPUParticles2D::set_color_ramp(const Ref<Gradient> &p_ramp) {
+	if (color_ramp == p_ramp) {
+		return;
+	}
+
+	if (color_ramp.is_valid()) {
+		color_ramp->disconnect(CoreStringNames::get_singleton()->changed, this, "_curves_changed");
+	}
+
 	color_ramp = p_ramp;
+
+	if (color_ramp.is_valid()) {
+		color_ramp->connect(CoreStringNames::get_singleton()->changed, this, "_curves_changed");
+	}
+	curve_tables_dirty = true;
 }
 
 Ref<Gradient> CPUParticles2D::get_color_ramp() const {
@@ -526,7 +684,7 @@ static float rand_from_seed(uint32_t &seed) {
 }
 
 void CPUParticles2D::_update_internal(bool p_on_physics_tick) {
-	if (particles.size() == 0 || !is_visible_in_tree()) {
+	if (particle_count == 0 || !is_visible_in_tree()) {
 		_set_redraw(false);
 		return;
 	}
@@ -609,118 +767,307 @@ void CPUParticles2D::_update_internal(bool p_on_physics_tick) {
 	}
 }
 
-void CPUParticles2D::_particle_process(Particle &r_p, const Transform2D &p_emission_xform, float p_local_delta, float &r_tv) {
-	uint32_t alt_seed = r_p.seed;
+void CPUParticles2D::_spawn_particle(uint32_t p_index, const Transform2D &p_emission_xform, const Transform2D &p_velocity_xform) {
+	ParticleArrays &pa = particles;
+	const uint32_t i = p_index;
 
-	r_p.time += p_local_delta;
-	r_p.custom[1] = r_p.time / lifetime;
-	r_tv = r_p.time / r_p.lifetime;
+	pa.active[i] = true;
 
-	float tex_linear_velocity = 0.0;
+	/*float tex_linear_velocity = 0;
 	if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-		tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(r_tv);
-	}
+		tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(0);
+	}*/
 
-	float tex_orbit_velocity = 0.0;
-	if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-		tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(r_tv);
+	float tex_angle = 0.0;
+	if (curve_tables[PARAM_ANGLE].size()) {
+		tex_angle = _sample_curve_table(PARAM_ANGLE, 0.0);
 	}
 
-	float tex_angular_velocity = 0.0;
-	if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-		tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(r_tv);
+	float tex_anim_offset = 0.0;
+	if (curve_tables[PARAM_ANGLE].size()) {
+		tex_anim_offset = _sample_curve_table(PARAM_ANGLE, 0.0);
 	}
 
-	float tex_linear_accel = 0.0;
-	if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-		tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(r_tv);
-	}
+	pa.seed[i] = Math::rand();
 
-	float tex_tangential_accel = 0.0;
-	if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-		tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(r_tv);
-	}
+	pa.angle_rand[i] = Math::randf();
+	pa.scale_rand[i] = Math::randf();
+	pa.hue_rot_rand[i] = Math::randf();
+	pa.anim_offset_rand[i] = Math::randf();
 
-	float tex_radial_accel = 0.0;
-	if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-		tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(r_tv);
+	if (color_initial_ramp.is_valid()) {
+		pa.start_color_rand[i] = color_initial_ramp->interpolate_baked(Math::randf());
+	} else {
+		pa.start_color_rand[i] = Color(1, 1, 1, 1);
 	}
 
-	float tex_damping = 0.0;
-	if (curve_parameters[PARAM_DAMPING].is_valid()) {
-		tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(r_tv);
+	float angle1_rad = Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+	Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
+	Vector2 velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+
+	float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, pa.angle_rand[i], randomness[PARAM_ANGLE]);
+	pa.rotation[i] = Math::deg2rad(base_angle);
+
+	pa.phase[i] = 0.0; // phase [0..1]
+	pa.anim_phase[i] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, pa.anim_offset_rand[i], randomness[PARAM_ANIM_OFFSET]); //animation phase [0..1]
+	Transform2D transform;
+	pa.time[i] = 0;
+	pa.lifetime[i] = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+	pa.base_color[i] = Color(1, 1, 1, 1);
+
+	switch (emission_shape) {
+		case EMISSION_SHAPE_POINT: {
+			//do none
+		} break;
+		case EMISSION_SHAPE_SPHERE: {
+			float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
+			float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
+			transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+		} break;
+		case EMISSION_SHAPE_RECTANGLE: {
+			transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+		} break;
+		case EMISSION_SHAPE_POINTS:
+		case EMISSION_SHAPE_DIRECTED_POINTS: {
+			int pc = emission_points.size();
+			if (pc == 0) {
+				break;
+			}
+
+			int random_idx = Math::rand() % pc;
+
+			transform[2] = emission_points.get(random_idx);
+
+			if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
+				Vector2 normal = emission_normals.get(random_idx);
+				Transform2D m2;
+				m2.set_axis(0, normal);
+				m2.set_axis(1, normal.tangent());
+				velocity = m2.basis_xform(velocity);
+			}
+
+			if (emission_colors.size() == pc) {
+				pa.base_color[i] = emission_colors.get(random_idx);
+			}
+		} break;
+		case EMISSION_SHAPE_MAX: { // Max value for validity check.
+			break;
+		}
 	}
 
-	float tex_angle = 0.0;
-	if (curve_parameters[PARAM_ANGLE].is_valid()) {
-		tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(r_tv);
+	if (!local_coords) {
+		velocity = p_velocity_xform.xform(velocity);
+		transform = p_emission_xform * transform;
 	}
-	float tex_anim_speed = 0.0;
-	if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-		tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(r_tv);
+
+	pa.vel_x[i] = velocity.x;
+	pa.vel_y[i] = velocity.y;
+	pa.axis_x[i] = transform.columns[0];
+	pa.axis_y[i] = transform.columns[1];
+	pa.pos_x[i] = transform.columns[2].x;
+	pa.pos_y[i] = transform.columns[2].y;
+}
+
+void CPUParticles2D::_process_particle_chunk(uint32_t p_chunk, const Transform2D *p_emission_xform) {
+	const uint32_t from = p_chunk * PARTICLE_CHUNK_SIZE;
+	const int count = MIN(int(PARTICLE_CHUNK_SIZE), particle_count - int(from));
+
+	ParticleArrays &pa = particles;
+	const uint8_t *step = pa.step.ptr() + from;
+	const float *delta = pa.delta.ptr() + from;
+	float *pos_x = pa.pos_x.ptr() + from;
+	float *pos_y = pa.pos_y.ptr() + from;
+	float *vel_x = pa.vel_x.ptr() + from;
+	float *vel_y = pa.vel_y.ptr() + from;
+	float *ptime = pa.time.ptr() + from;
+	const float *plifetime = pa.lifetime.ptr() + from;
+
+	// Advance the particle clocks, and compute the phase at which the curves are sampled.
+	float tv[PARTICLE_CHUNK_SIZE];
+	for (int i = 0; i < count; i++) {
+		switch (step[i]) {
+			case PARTICLE_STEP_PROCESS: {
+				ptime[i] += delta[i];
+				pa.phase[from + i] = ptime[i] / lifetime;
+				tv[i] = ptime[i] / plifetime[i];
+			} break;
+			case PARTICLE_STEP_EXPIRED: {
+				tv[i] = 1.0;
+			} break;
+			default: {
+				tv[i] = 0.0;
+			}
+		}
 	}
 
-	float tex_anim_offset = 0.0;
-	if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-		tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(r_tv);
+	float curve_values[PARAM_MAX][PARTICLE_CHUNK_SIZE];
+	const float *curve[PARAM_MAX];
+	for (int j = 0; j < PARAM_MAX; j++) {
+		if (curve_tables[j].size()) {
+			_sample_table(curve_tables[j].ptr(), CURVE_TABLE_SIZE, tv, curve_values[j], count);
+			curve[j] = curve_values[j];
+		} else {
+			curve[j] = nullptr;
+		}
 	}
 
-	Vector2 force = gravity;
-	Vector2 pos = r_p.transform[2];
+	const Vector2 org = p_emission_xform->columns[2];
 
-	// Apply linear acceleration.
-	force += r_p.velocity.length() > 0.0 ? r_p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
+	for (int i = 0; i < count; i++) {
+		if (step[i] == PARTICLE_STEP_SKIP) {
+			continue;
+		}
 
-	// Apply radial acceleration.
-	Vector2 org = p_emission_xform[2];
-	Vector2 diff = pos - org;
-	force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector2();
+		const uint32_t idx = from + i;
+		Vector2 velocity = Vector2(vel_x[i], vel_y[i]);
+
+		if (step[i] == PARTICLE_STEP_PROCESS) {
+			uint32_t alt_seed = pa.seed[idx];
+			float local_delta = delta[i];
+
+			float tex_linear_velocity = curve[PARAM_INITIAL_LINEAR_VELOCITY] ? curve[PARAM_INITIAL_LINEAR_VELOCITY][i] : 0.0f;
+			float tex_orbit_velocity = curve[PARAM_ORBIT_VELOCITY] ? curve[PARAM_ORBIT_VELOCITY][i] : 0.0f;
+			float tex_angular_velocity = curve[PARAM_ANGULAR_VELOCITY] ? curve[PARAM_ANGULAR_VELOCITY][i] : 0.0f;
+			float tex_linear_accel = curve[PARAM_LINEAR_ACCEL] ? curve[PARAM_LINEAR_ACCEL][i] : 0.0f;
+			float tex_tangential_accel = curve[PARAM_TANGENTIAL_ACCEL] ? curve[PARAM_TANGENTIAL_ACCEL][i] : 0.0f;
+			float tex_radial_accel = curve[PARAM_RADIAL_ACCEL] ? curve[PARAM_RADIAL_ACCEL][i] : 0.0f;
+			float tex_damping = curve[PARAM_DAMPING] ? curve[PARAM_DAMPING][i] : 0.0f;
+			float tex_angle = curve[PARAM_ANGLE] ? curve[PARAM_ANGLE][i] : 0.0f;
+			float tex_anim_speed = curve[PARAM_ANIM_SPEED] ? curve[PARAM_ANIM_SPEED][i] : 0.0f;
+			float tex_anim_offset = curve[PARAM_ANIM_OFFSET] ? curve[PARAM_ANIM_OFFSET][i] : 0.0f;
+
+			Vector2 force = gravity;
+			Vector2 pos = Vector2(pos_x[i], pos_y[i]);
+
+			// Apply linear acceleration.
+			force += velocity.length() > 0.0 ? velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
+
+			// Apply radial acceleration.
+			Vector2 diff = pos - org;
+			force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector2();
+
+			// Apply tangential acceleration.
+			Vector2 yx = Vector2(diff.y, diff.x);
+			force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector2();
+
+			// Apply attractor forces.
+			velocity += force * local_delta;
+
+			// Orbit velocity.
+			float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
+			if (orbit_amount != 0.0) {
+				float ang = orbit_amount * local_delta * Math_PI * 2.0;
+				// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
+				// but we use -ang here to reproduce its behavior.
+				Transform2D rot = Transform2D(-ang, Vector2());
+				pos -= diff;
+				pos += rot.basis_xform(diff);
+				pos_x[i] = pos.x;
+				pos_y[i] = pos.y;
+			}
+			if (curve[PARAM_INITIAL_LINEAR_VELOCITY]) {
+				velocity = velocity.normalized() * tex_linear_velocity;
+			}
 
-	// Apply tangential acceleration.
-	Vector2 yx = Vector2(diff.y, diff.x);
-	force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector2();
+			if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
+				float v = velocity.length();
+				float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
+				v -= damp * local_delta;
+				if (v < 0.0) {
+					velocity = Vector2();
+				} else {
+					velocity = velocity.normalized() * v;
+				}
+			}
+			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, pa.angle_rand[idx], randomness[PARAM_ANGLE]);
+			base_angle += pa.phase[idx] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
+			pa.rotation[idx] = Math::deg2rad(base_angle); //angle
+			pa.anim_phase[idx] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, pa.anim_offset_rand[idx], randomness[PARAM_ANIM_OFFSET]) + tv[i] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
 
-	// Apply attractor forces.
-	r_p.velocity += force * p_local_delta;
+			vel_x[i] = velocity.x;
+			vel_y[i] = velocity.y;
+		}
 
-	// Orbit velocity.
-	float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
-	if (orbit_amount != 0.0) {
-		float ang = orbit_amount * p_local_delta * Math_PI * 2.0;
-		// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
-		// but we use -ang here to reproduce its behavior.
-		Transform2D rot = Transform2D(-ang, Vector2());
-		r_p.transform[2] -= diff;
-		r_p.transform[2] += rot.basis_xform(diff);
-	}
-	if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-		r_p.velocity = r_p.velocity.normalized() * tex_linear_velocity;
-	}
+		//apply color
+		//apply hue rotation
+
+		float tex_scale = curve[PARAM_SCALE] ? curve[PARAM_SCALE][i] : 1.0f;
+		float tex_hue_variation = curve[PARAM_HUE_VARIATION] ? curve[PARAM_HUE_VARIATION][i] : 0.0f;
+
+		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, pa.hue_rot_rand[idx] * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
+		float hue_rot_c = Math::cos(hue_rot_angle);
+		float hue_rot_s = Math::sin(hue_rot_angle);
+
+		Basis hue_rot_mat;
+		{
+			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+
+			for (int j = 0; j < 3; j++) {
+				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+			}
+		}
 
-	if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
-		float v = r_p.velocity.length();
-		float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
-		v -= damp * p_local_delta;
-		if (v < 0.0) {
-			r_p.velocity = Vector2();
+		Color &pcolor = pa.color[idx];
+		if (color_ramp_table.size()) {
+			pcolor = _sample_table(color_ramp_table.ptr(), CURVE_TABLE_SIZE, tv[i]) * color;
 		} else {
-			r_p.velocity = r_p.velocity.normalized() * v;
+			pcolor = color;
+		}
+
+		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(pcolor.r, pcolor.g, pcolor.b));
+		pcolor.r = color_rgb.x;
+		pcolor.g = color_rgb.y;
+		pcolor.b = color_rgb.z;
+
+		pcolor *= pa.base_color[idx] * pa.start_color_rand[idx];
+
+		Vector2 &axis_x = pa.axis_x[idx];
+		Vector2 &axis_y = pa.axis_y[idx];
+
+		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
+			if (velocity.length() > 0.0) {
+				axis_y = velocity.normalized();
+				axis_x = axis_y.tangent();
+			}
+
+		} else {
+			float rotation = pa.rotation[idx];
+			axis_x = Vector2(Math::cos(rotation), -Math::sin(rotation));
+			axis_y = Vector2(Math::sin(rotation), Math::cos(rotation));
+		}
+
+		//scale by scale
+		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, pa.scale_rand[idx] * randomness[PARAM_SCALE]);
+
+		// Prevent zero scale (which can cause rendering issues).
+		base_scale = SGN(base_scale) * MAX(Math::abs(base_scale), 0.000001);
+
+		axis_x *= base_scale;
+		axis_y *= base_scale;
+	}
+
+	// Skipped particles have a delta of 0, so the whole chunk can be integrated at once.
+	_integrate_positions(pos_x, pos_y, vel_x, vel_y, delta, count);
+
+	// Teleport if starting a new particle, so
+	// we don't get a streak from the old position
+	// to this new start.
+	if (_interpolated) {
+		for (int i = 0; i < count; i++) {
+			if (step[i] == PARTICLE_STEP_SPAWNED) {
+				_copy_particle_to(from + i, particles_prev[from + i]);
+			}
 		}
 	}
-	float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, r_p.angle_rand, randomness[PARAM_ANGLE]);
-	base_angle += r_p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
-	r_p.rotation = Math::deg2rad(base_angle); //angle
-	float animation_phase = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, r_p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + r_tv * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
-	r_p.custom[2] = animation_phase;
 }
 
 void CPUParticles2D::_particles_process(float p_delta) {
 	p_delta *= speed_scale;
 
-	int pcount = particles.size();
-	PoolVector<Particle>::Write w = particles.write();
-
-	Particle *parray = w.ptr();
+	int pcount = particle_count;
+	ParticleArrays &pa = particles;
 
 	float prev_time = time;
 	time += p_delta;
@@ -745,19 +1092,32 @@ void CPUParticles2D::_particles_process(float p_delta) {
 		velocity_xform[2] = Vector2();
 	}
 
+	if (curve_tables_dirty) {
+		_update_curve_tables();
+	}
+
 	float system_phase = time / lifetime;
 
+	uint8_t *step = pa.step.ptr();
+	float *delta = pa.delta.ptr();
+	uint8_t *active = pa.active.ptr();
+	const float *ptime = pa.time.ptr();
+	const float *plifetime = pa.lifetime.ptr();
+
+	// Serial pass: decide what happens to every particle this step, and emit the new ones
+	// (emission uses the global random generator, so it can't run on the worker threads).
 	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+		step[i] = PARTICLE_STEP_SKIP;
+		delta[i] = 0.0;
 
-		if (!emitting && !p.active) {
+		if (!emitting && !active[i]) {
 			continue;
 		}
 
 		// For interpolation we need to keep a record of previous particles.
 		if (_interpolated) {
-			DEV_ASSERT((uint32_t)particles.size() == particles_prev.size());
-			p.copy_to(particles_prev[i]);
+			DEV_ASSERT((uint32_t)particle_count == particles_prev.size());
+			_copy_particle_to(i, particles_prev[i]);
 		}
 
 		float local_delta = p_delta;
@@ -807,199 +1167,115 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			}
 		}
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		if (ptime[i] * (1.0 - explosiveness_ratio) > plifetime[i]) {
 			restart = true;
 		}
 
-		float tv = 0.0;
-
 		if (restart) {
 			if (!emitting) {
-				p.active = false;
+				active[i] = false;
 				continue;
 			}
-			p.active = true;
-
-			/*float tex_linear_velocity = 0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(0);
-			}*/
-
-			float tex_angle = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(tv);
-			}
-
-			float tex_anim_offset = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(tv);
-			}
-
-			p.seed = Math::rand();
-
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
-
-			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
-			} else {
-				p.start_color_rand = Color(1, 1, 1, 1);
-			}
-
-			float angle1_rad = Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
-			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
-
-			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
-			p.rotation = Math::deg2rad(base_angle);
-
-			p.custom[0] = 0.0; // unused
-			p.custom[1] = 0.0; // phase [0..1]
-			p.custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]); //animation phase [0..1]
-			p.custom[3] = 0.0;
-			p.transform = Transform2D();
-			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
-			p.base_color = Color(1, 1, 1, 1);
-
-			switch (emission_shape) {
-				case EMISSION_SHAPE_POINT: {
-					//do none
-				} break;
-				case EMISSION_SHAPE_SPHERE: {
-					float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
-					float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
-				} break;
-				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
-				} break;
-				case EMISSION_SHAPE_POINTS:
-				case EMISSION_SHAPE_DIRECTED_POINTS: {
-					int pc = emission_points.size();
-					if (pc == 0) {
-						break;
-					}
-
-					int random_idx = Math::rand() % pc;
-
-					p.transform[2] = emission_points.get(random_idx);
-
-					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						Vector2 normal = emission_normals.get(random_idx);
-						Transform2D m2;
-						m2.set_axis(0, normal);
-						m2.set_axis(1, normal.tangent());
-						p.velocity = m2.basis_xform(p.velocity);
-					}
-
-					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
-					}
-				} break;
-				case EMISSION_SHAPE_MAX: { // Max value for validity check.
-					break;
-				}
-			}
-
-			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
-			}
+			_spawn_particle(i, emission_xform, velocity_xform);
+			step[i] = PARTICLE_STEP_SPAWNED;
 
-		} else if (!p.active) {
+		} else if (!active[i]) {
 			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
+		} else if (ptime[i] > plifetime[i]) {
+			active[i] = false;
+			step[i] = PARTICLE_STEP_EXPIRED;
 		} else {
-			_particle_process(p, emission_xform, local_delta, tv);
+			step[i] = PARTICLE_STEP_PROCESS;
 		}
-		//apply color
-		//apply hue rotation
 
-		float tex_scale = 1.0;
-		if (curve_parameters[PARAM_SCALE].is_valid()) {
-			tex_scale = curve_parameters[PARAM_SCALE]->interpolate(tv);
-		}
+		delta[i] = local_delta;
+	}
+
+	uint32_t chunk_count = (pcount + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE;
 
-		float tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(tv);
+	if (pcount >= PARTICLE_THREADING_THRESHOLD && thread_pool_size != 0) {
+		if (thread_pool.get_thread_count() == 0) {
+			thread_pool.init(thread_pool_size);
 		}
+		thread_pool.do_work(chunk_count, this, &CPUParticles2D::_process_particle_chunk, (const Transform2D *)&emission_xform);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_process_particle_chunk(i, &emission_xform);
+		}
+	}
+}
 
-		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
-		float hue_rot_c = Math::cos(hue_rot_angle);
-		float hue_rot_s = Math::sin(hue_rot_angle);
+void CPUParticles2D::_curves_changed() {
+	curve_tables_dirty = true;
+}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+void CPUParticles2D::_update_curve_tables() {
+	for (int i = 0; i < PARAM_MAX; i++) {
+		LocalVector<float> &table = curve_tables[i];
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
-			}
+		if (curve_parameters[i].is_null()) {
+			table.clear();
+			continue;
 		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
-		} else {
-			p.color = color;
+		table.resize(CURVE_TABLE_SIZE + 2);
+		float *w = table.ptr();
+		for (int j = 0; j <= CURVE_TABLE_SIZE; j++) {
+			w[j] = curve_parameters[i]->interpolate(float(j) / CURVE_TABLE_SIZE);
 		}
+		w[CURVE_TABLE_SIZE + 1] = w[CURVE_TABLE_SIZE];
+	}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
-
-		p.color *= p.base_color * p.start_color_rand;
-
-		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
-				p.transform.columns[1] = p.velocity.normalized();
-				p.transform.columns[0] = p.transform.columns[1].tangent();
-			}
-
-		} else {
-			p.transform.columns[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.columns[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+	if (color_ramp.is_valid()) {
+		color_ramp_table.resize(CURVE_TABLE_SIZE + 2);
+		Color *w = color_ramp_table.ptr();
+		for (int j = 0; j <= CURVE_TABLE_SIZE; j++) {
+			w[j] = color_ramp->get_color_at_offset(float(j) / CURVE_TABLE_SIZE);
 		}
+		w[CURVE_TABLE_SIZE + 1] = w[CURVE_TABLE_SIZE];
+	} else {
+		color_ramp_table.clear();
+	}
 
-		//scale by scale
-		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
+	curve_tables_dirty = false;
+}
 
-		// Prevent zero scale (which can cause rendering issues).
-		base_scale = SGN(base_scale) * MAX(Math::abs(base_scale), 0.000001);
+float CPUParticles2D::_sample_curve_table(Parameter p_param, float p_offset) const {
+	return _sample_table(curve_tables[p_param].ptr(), CURVE_TABLE_SIZE, p_offset);
+}
 
-		p.transform.columns[0] *= base_scale;
-		p.transform.columns[1] *= base_scale;
+void CPUParticles2D::_copy_particle_to(uint32_t p_index, ParticleBase &r_o) const {
+	const ParticleArrays &pa = particles;
+	r_o.transform = Transform2D(pa.axis_x[p_index], pa.axis_y[p_index], Vector2(pa.pos_x[p_index], pa.pos_y[p_index]));
+	r_o.color = pa.color[p_index];
+	r_o.custom[0] = 0.0;
+	r_o.custom[1] = pa.phase[p_index];
+	r_o.custom[2] = pa.anim_phase[p_index];
+	r_o.custom[3] = 0.0;
+}
 
-		p.transform[2] += p.velocity * local_delta;
+void CPUParticles2D::init_thread_pool() {
+	// -1 uses one thread per core, 0 processes every emitter on the main thread.
+	// The threads are only started once an emitter large enough to need them is processed.
+	thread_pool_size = GLOBAL_DEF_RST("rendering/2d/cpu_particles/thread_count", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/2d/cpu_particles/thread_count", PropertyInfo(Variant::INT, "rendering/2d/cpu_particles/thread_count", PROPERTY_HINT_RANGE, "-1,64,1"));
+}
 
-		// Teleport if starting a new particle, so
-		// we don't get a streak from the old position
-		// to this new start.
-		if (restart && _interpolated) {
-			p.copy_to(particles_prev[i]);
-		}
-	}
+void CPUParticles2D::finish_thread_pool() {
+	thread_pool.finish();
 }
 
 void CPUParticles2D::_update_particle_data_buffer() {
 	update_mutex.lock();
 
 	{
-		int pc = particles.size();
+		int pc = particle_count;
+		const uint8_t *active = particles.active.ptr();
 
 		PoolVector<int>::Write ow;
 		int *order = nullptr;
 
 		PoolVector<float>::Write w = particle_data.write();
-		PoolVector<Particle>::Read r = particles.read();
 		float *ptr = w.ptr();
 
 		PoolVector<float>::Write w_prev;
@@ -1020,7 +1296,7 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			}
 			if (draw_order == DRAW_ORDER_LIFETIME) {
 				SortArray<int, SortLifetime> sorter;
-				sorter.compare.particles = r.ptr();
+				sorter.compare.time = particles.time.ptr();
 				sorter.sort(order, pc);
 			}
 		}
@@ -1028,9 +1304,9 @@ void CPUParticles2D::_update_particle_data_buffer() {
 		if (_interpolated) {
 			for (int i = 0; i < pc; i++) {
 				int idx = order ? order[i] : i;
-				_fill_particle_data<false>(r[idx], ptr, r[idx].active);
+				_fill_particle_data<false>(idx, ptr);
 				ptr += 13;
-				_fill_particle_data<false>(particles_prev[idx], ptr_prev, r[idx].active);
+				_fill_particle_data<false>(particles_prev[idx], ptr_prev, active[idx]);
 				ptr_prev += 13;
 			}
 		} else {
@@ -1039,20 +1315,20 @@ void CPUParticles2D::_update_particle_data_buffer() {
 				inv_emission_transform = get_global_transform().affine_inverse();
 				for (int i = 0; i < pc; i++) {
 					int idx = order ? order[i] : i;
-					_fill_particle_data<true>(r[idx], ptr, r[idx].active);
+					_fill_particle_data<true>(idx, ptr);
 					ptr += 13;
 				}
 			} else {
 				for (int i = 0; i < pc; i++) {
 					int idx = order ? order[i] : i;
-					_fill_particle_data<false>(r[idx], ptr, r[idx].active);
+					_fill_particle_data<false>(idx, ptr);
 					ptr += 13;
 				}
 			}
 #else
 			for (int i = 0; i < pc; i++) {
 				int idx = order ? order[i] : i;
-				_fill_particle_data<false>(r[idx], ptr, r[idx].active);
+				_fill_particle_data<false>(idx, ptr);
 				ptr += 13;
 			}
 #endif
@@ -1203,16 +1479,16 @@ void CPUParticles2D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
 		if (!_interpolated && !local_coords) {
 			inv_emission_transform = get_global_transform().affine_inverse();
-			int pc = particles.size();
+			int pc = particle_count;
+			const ParticleArrays &pa = particles;
 
 			PoolVector<float>::Write w = particle_data.write();
-			PoolVector<Particle>::Read r = particles.read();
 			float *ptr = w.ptr();
 
 			for (int i = 0; i < pc; i++) {
-				Transform2D t = inv_emission_transform * r[i].transform;
+				Transform2D t = inv_emission_transform * Transform2D(pa.axis_x[i], pa.axis_y[i], Vector2(pa.pos_x[i], pa.pos_y[i]));
 
-				if (r[i].active) {
+				if (pa.active[i]) {
 					ptr[0] = t.columns[0][0];
 					ptr[1] = t.columns[1][0];
 					ptr[2] = 0;
@@ -1355,6 +1631,7 @@ void CPUParticles2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("_update_render_thread"), &CPUParticles2D::_update_render_thread);
 	ClassDB::bind_method(D_METHOD("_texture_changed"), &CPUParticles2D::_texture_changed);
+	ClassDB::bind_method(D_METHOD("_curves_changed"), &CPUParticles2D::_curves_changed);
 
 	ADD_GROUP("Emission Shape", "emission_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "emission_shape", PROPERTY_HINT_ENUM, "Point,Sphere,Rectangle,Points,Directed Points", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), "set_emission_shape", "get_emission_shape");
@@ -1458,6 +1735,8 @@ CPUParticles2D::CPUParticles2D() {
 	emitting = false;
 	_interpolated = false;
 	_interpolation_data.interpolated_follow = false;
+	particle_count = 0;
+	curve_tables_dirty = true;
 
 	mesh = RID_PRIME(RenderingServer::get_singleton()->mesh_create());
 	multimesh = RID_PRIME(RenderingServer::get_singleton()->multimesh_create());
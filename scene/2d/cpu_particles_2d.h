@@ -4,6 +4,8 @@
 /*  cpu_particles_2d.h                                                   */
 
 
+#include "core/containers/local_vector.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/main/node_2d.h"
 
 class RID;
@@ -68,27 +70,47 @@ private:
 		float custom[4];
 	};
 
-	// Warning - beware of adding non-trivial types
-	// to this structure as it is zeroed to initialize in set_amount().
-	struct Particle : public ParticleBase {
-		void copy_to(ParticleBase &r_o) {
-			r_o.transform = transform;
-			r_o.color = color;
-			memcpy(r_o.custom, custom, sizeof(custom));
-		}
-		float rotation;
-		Vector2 velocity;
-		bool active;
-		float angle_rand;
-		float scale_rand;
-		float hue_rot_rand;
-		float anim_offset_rand;
-		Color start_color_rand;
-		float time;
-		float lifetime;
-		Color base_color;
-
-		uint32_t seed;
+	// Particles are stored as a structure of arrays, one entry per particle in each array.
+	// The per step kernels walk contiguous floats (position integration and curve sampling use SIMD),
+	// and large emitters are split in chunks which are processed by worker threads.
+	struct ParticleArrays {
+		LocalVector<float> pos_x;
+		LocalVector<float> pos_y;
+		LocalVector<float> vel_x;
+		LocalVector<float> vel_y;
+		LocalVector<Vector2> axis_x; // Transform columns 0 and 1, rotation and scale.
+		LocalVector<Vector2> axis_y;
+		LocalVector<Color> color;
+		LocalVector<float> phase; // custom[1], time / system lifetime.
+		LocalVector<float> anim_phase; // custom[2].
+		LocalVector<float> rotation;
+		LocalVector<float> time;
+		LocalVector<float> lifetime;
+		LocalVector<float> angle_rand;
+		LocalVector<float> scale_rand;
+		LocalVector<float> hue_rot_rand;
+		LocalVector<float> anim_offset_rand;
+		LocalVector<Color> start_color_rand;
+		LocalVector<Color> base_color;
+		LocalVector<uint32_t> seed;
+		LocalVector<uint8_t> active;
+
+		// Scratch written by the serial emission pass, and read by the chunk kernels.
+		LocalVector<uint8_t> step;
+		LocalVector<float> delta;
+	};
+
+	enum ParticleStep {
+		PARTICLE_STEP_SKIP, // Left untouched this step.
+		PARTICLE_STEP_PROCESS,
+		PARTICLE_STEP_SPAWNED,
+		PARTICLE_STEP_EXPIRED,
+	};
+
+	enum {
+		PARTICLE_CHUNK_SIZE = 256,
+		PARTICLE_THREADING_THRESHOLD = 8192, // Emitters with fewer particles are processed on the calling thread.
+		CURVE_TABLE_SIZE = 256,
 	};
 
 	float time;
@@ -100,25 +122,18 @@ private:
 	RID mesh;
 	RID multimesh;
 
-	PoolVector<Particle> particles;
+	ParticleArrays particles;
+	int particle_count;
 	LocalVector<ParticleBase> particles_prev;
 	PoolVector<float> particle_data;
 	PoolVector<float> particle_data_prev;
 	PoolVector<int> particle_order;
 
 	struct SortLifetime {
-		const Particle *particles;
+		const float *time;
 
 		bool operator()(int p_a, int p_b) const {
-			return particles[p_a].time > particles[p_b].time;
-		}
-	};
-
-	struct SortAxis {
-		const Particle *particles;
-		Vector2 axis;
-		bool operator()(int p_a, int p_b) const {
-			return axis.dot(particles[p_a].transform[2]) < axis.dot(particles[p_b].transform[2]);
+			return time[p_a] > time[p_b];
 		}
 	};
 
@@ -168,11 +183,26 @@ private:
 
 	Vector2 gravity;
 
+	// Curves and the color ramp are baked into uniformly sampled tables (CURVE_TABLE_SIZE + 1 entries)
+	// on the main thread, so the chunk kernels never touch the resources.
+	LocalVector<float> curve_tables[PARAM_MAX];
+	LocalVector<Color> color_ramp_table;
+	bool curve_tables_dirty;
+
+	static ThreadWorkPool thread_pool;
+	static int thread_pool_size;
+
 	void _update_internal(bool p_on_physics_tick);
 	void _particles_process(float p_delta);
-	void _particle_process(Particle &r_p, const Transform2D &p_emission_xform, float p_local_delta, float &r_tv);
+	void _spawn_particle(uint32_t p_index, const Transform2D &p_emission_xform, const Transform2D &p_velocity_xform);
+	void _process_particle_chunk(uint32_t p_chunk, const Transform2D *p_emission_xform);
 	void _update_particle_data_buffer();
 
+	void _curves_changed();
+	void _update_curve_tables();
+	float _sample_curve_table(Parameter p_param, float p_offset) const;
+	void _copy_particle_to(uint32_t p_index, ParticleBase &r_o) const;
+
 	Mutex update_mutex;
 	// Whether this particle system is interpolated.
 	bool _interpolated;
@@ -198,15 +228,28 @@ private:
 
 	template <bool TRANSFORM_PARTICLE>
 	void _fill_particle_data(const ParticleBase &p_source, float *r_dest, bool p_active) const {
+		_fill_particle_data<TRANSFORM_PARTICLE>(p_source.transform, p_source.color, p_source.custom, r_dest, p_active);
+	}
+
+	template <bool TRANSFORM_PARTICLE>
+	void _fill_particle_data(uint32_t p_index, float *r_dest) const {
+		const ParticleArrays &p = particles;
+		float custom[4] = { 0.0f, p.phase[p_index], p.anim_phase[p_index], 0.0f };
+		Transform2D t(p.axis_x[p_index], p.axis_y[p_index], Vector2(p.pos_x[p_index], p.pos_y[p_index]));
+		_fill_particle_data<TRANSFORM_PARTICLE>(t, p.color[p_index], custom, r_dest, p.active[p_index]);
+	}
+
+	template <bool TRANSFORM_PARTICLE>
+	void _fill_particle_data(const Transform2D &p_transform, const Color &p_color, const float *p_custom, float *r_dest, bool p_active) const {
 		if (p_active) {
 #ifdef PANDEMONIUM_CPU_PARTICLES_2D_LEGACY_COMPATIBILITY
-			Transform2D t = p_source.transform;
+			Transform2D t = p_transform;
 
 			if (TRANSFORM_PARTICLE) {
 				t = inv_emission_transform * t;
 			}
 #else
-			const Transform2D &t = p_source.transform;
+			const Transform2D &t = p_transform;
 #endif
 
 			r_dest[0] = t.columns[0][0];
@@ -218,17 +261,17 @@ private:
 			r_dest[6] = 0;
 			r_dest[7] = t.columns[2][1];
 
-			Color c = p_source.color;
+			const Color &c = p_color;
 			uint8_t *data8 = (uint8_t *)&r_dest[8];
 			data8[0] = CLAMP(c.r * 255.0, 0, 255);
 			data8[1] = CLAMP(c.g * 255.0, 0, 255);
 			data8[2] = CLAMP(c.b * 255.0, 0, 255);
 			data8[3] = CLAMP(c.a * 255.0, 0, 255);
 
-			r_dest[9] = p_source.custom[0];
-			r_dest[10] = p_source.custom[1];
-			r_dest[11] = p_source.custom[2];
-			r_dest[12] = p_source.custom[3];
+			r_dest[9] = p_custom[0];
+			r_dest[10] = p_custom[1];
+			r_dest[11] = p_custom[2];
+			r_dest[12] = p_custom[3];
 
 		} else {
 			memset(r_dest, 0, sizeof(float) * 13);
@@ -328,6 +371,9 @@ public:
 
 	void restart();
 
+	static void init_thread_pool();
+	static void finish_thread_pool();
+
 	CPUParticles2D();
 	~CPUParticles2D();
 };
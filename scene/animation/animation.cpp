@@ -530,7 +530,7 @@ int Animation::add_track(TrackType p_type, int p_at_pos) {
 			ERR_PRINT("Unknown track type");
 		}
 	}
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 	return p_at_pos;
 }
@@ -569,7 +569,7 @@ void Animation::remove_track(int p_track) {
 
 	memdelete(t);
 	tracks.remove(p_track);
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -585,7 +585,7 @@ Animation::TrackType Animation::track_get_type(int p_track) const {
 void Animation::track_set_path(int p_track, const NodePath &p_path) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	tracks[p_track]->path = p_path;
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -607,7 +607,7 @@ void Animation::track_set_interpolation_type(int p_track, InterpolationType p_in
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	ERR_FAIL_INDEX(p_interp, 3);
 	tracks[p_track]->interpolation = p_interp;
-	emit_changed();
+	_changed();
 }
 
 Animation::InterpolationType Animation::track_get_interpolation_type(int p_track) const {
@@ -618,7 +618,7 @@ Animation::InterpolationType Animation::track_get_interpolation_type(int p_track
 void Animation::track_set_interpolation_loop_wrap(int p_track, bool p_enable) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	tracks[p_track]->loop_wrap = p_enable;
-	emit_changed();
+	_changed();
 }
 
 bool Animation::track_get_interpolation_loop_wrap(int p_track) const {
@@ -698,7 +698,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		} break;
 	}
 
-	emit_changed();
+	_changed();
 }
 
 int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
@@ -849,7 +849,7 @@ void Animation::track_insert_key(int p_track, float p_time, const Variant &p_key
 		} break;
 	}
 
-	emit_changed();
+	_changed();
 }
 
 int Animation::track_get_key_count(int p_track) const {
@@ -983,6 +983,7 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	Track *t = tracks[p_track];
+	version++;
 
 	switch (t->type) {
 		case TYPE_VALUE: {
@@ -1129,7 +1130,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		} break;
 	}
 
-	emit_changed();
+	_changed();
 }
 
 void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_transition) {
@@ -1156,7 +1157,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		} break;
 	}
 
-	emit_changed();
+	_changed();
 }
 
 template <class K>
@@ -1196,6 +1197,37 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 	return middle;
 }
 
+template <class K>
+int Animation::_find_hinted(const Vector<K> &p_keys, float p_time, int p_hint) const {
+	int len = p_keys.size();
+	if (len == 0 || p_hint < -1 || p_hint >= len) {
+		return _find(p_keys, p_time);
+	}
+
+	const K *keys = &p_keys[0];
+
+	// Check the hinted key and the one after it, this covers regular playback.
+	for (int i = p_hint; i < p_hint + 2 && i < len; i++) {
+		if (i >= 0 && p_time < keys[i].time && !Math::is_equal_approx(p_time, keys[i].time)) {
+			break; // Went backwards.
+		}
+		if (i + 1 == len || (p_time < keys[i + 1].time && !Math::is_equal_approx(p_time, keys[i + 1].time))) {
+			return i;
+		}
+	}
+
+	return _find(p_keys, p_time);
+}
+
+template <class K>
+int Animation::_get_key_count_in_length(const Vector<K> &p_keys) const {
+	int len = p_keys.size();
+	if (len == 0 || p_keys[len - 1].time <= length) {
+		return len; // Usual case, no keys past the end.
+	}
+	return _find(p_keys, length) + 1;
+}
+
 Vector3 Animation::_interpolate(const Vector3 &p_a, const Vector3 &p_b, float p_c) const {
 	return p_a.linear_interpolate(p_b, p_c);
 }
@@ -1308,8 +1340,8 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 }
 
 template <class T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+	int len = _get_key_count_in_length(p_keys); // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -1326,7 +1358,13 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx;
+	if (r_cursor) {
+		idx = _find_hinted(p_keys, p_time, *r_cursor);
+		*r_cursor = idx;
+	} else {
+		idx = _find(p_keys, p_time);
+	}
 
 	ERR_FAIL_COND_V(idx == -2, T());
 
@@ -1477,6 +1515,23 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 	return Variant();
 }
 
+Variant Animation::value_track_interpolate_cursor(int p_track, float p_time, int &r_cursor) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
+	Track *t = tracks[p_track];
+	ERR_FAIL_COND_V(t->type != TYPE_VALUE, Variant());
+	ValueTrack *vt = static_cast<ValueTrack *>(t);
+
+	bool ok = false;
+
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, &r_cursor);
+
+	if (ok) {
+		return res;
+	}
+
+	return Variant();
+}
+
 void Animation::_value_track_get_key_indices_in_range(const ValueTrack *vt, float from_time, float to_time, List<int> *p_indices) const {
 	if (from_time != length && to_time == length) {
 		to_time = length * 1.001; //include a little more if at the end
@@ -1565,7 +1620,7 @@ void Animation::value_track_set_update_mode(int p_track, UpdateMode p_mode) {
 
 	ValueTrack *vt = static_cast<ValueTrack *>(t);
 	vt->update_mode = p_mode;
-	emit_changed();
+	_changed();
 }
 
 Animation::UpdateMode Animation::value_track_get_update_mode(int p_track) const {
@@ -1839,7 +1894,7 @@ int Animation::bezier_track_insert_key(int p_track, float p_time, float p_value,
 
 	int key = _insert(p_time, bt->values, k);
 
-	emit_changed();
+	_changed();
 
 	return key;
 }
@@ -1854,7 +1909,7 @@ void Animation::bezier_track_set_key_value(int p_track, int p_index, float p_val
 	ERR_FAIL_INDEX(p_index, bt->values.size());
 
 	bt->values.write[p_index].value.value = p_value;
-	emit_changed();
+	_changed();
 }
 
 void Animation::bezier_track_set_key_in_handle(int p_track, int p_index, const Vector2 &p_handle) {
@@ -1870,7 +1925,7 @@ void Animation::bezier_track_set_key_in_handle(int p_track, int p_index, const V
 	if (bt->values[p_index].value.in_handle.x > 0) {
 		bt->values.write[p_index].value.in_handle.x = 0;
 	}
-	emit_changed();
+	_changed();
 }
 void Animation::bezier_track_set_key_out_handle(int p_track, int p_index, const Vector2 &p_handle) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
@@ -1885,7 +1940,7 @@ void Animation::bezier_track_set_key_out_handle(int p_track, int p_index, const
 	if (bt->values[p_index].value.out_handle.x < 0) {
 		bt->values.write[p_index].value.out_handle.x = 0;
 	}
-	emit_changed();
+	_changed();
 }
 float Animation::bezier_track_get_key_value(int p_track, int p_index) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
@@ -1933,14 +1988,25 @@ static _FORCE_INLINE_ Vector2 _bezier_interp(real_t t, const Vector2 &start, con
 }
 
 float Animation::bezier_track_interpolate(int p_track, float p_time) const {
-	//this uses a different interpolation scheme
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *track = tracks[p_track];
 	ERR_FAIL_COND_V(track->type != TYPE_BEZIER, 0);
 
-	BezierTrack *bt = static_cast<BezierTrack *>(track);
+	return _bezier_track_interpolate(static_cast<BezierTrack *>(track), p_time, nullptr);
+}
+
+float Animation::bezier_track_interpolate_cursor(int p_track, float p_time, int &r_cursor) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
+	Track *track = tracks[p_track];
+	ERR_FAIL_COND_V(track->type != TYPE_BEZIER, 0);
 
-	int len = _find(bt->values, length) + 1; // try to find last key (there may be more past the end)
+	return _bezier_track_interpolate(static_cast<BezierTrack *>(track), p_time, &r_cursor);
+}
+
+float Animation::_bezier_track_interpolate(const BezierTrack *bt, float p_time, int *r_cursor) const {
+	//this uses a different interpolation scheme
+
+	int len = _get_key_count_in_length(bt->values); // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -1949,7 +2015,13 @@ float Animation::bezier_track_interpolate(int p_track, float p_time) const {
 		return bt->values[0].value.value;
 	}
 
-	int idx = _find(bt->values, p_time);
+	int idx;
+	if (r_cursor) {
+		idx = _find_hinted(bt->values, p_time, *r_cursor);
+		*r_cursor = idx;
+	} else {
+		idx = _find(bt->values, p_time);
+	}
 
 	ERR_FAIL_COND_V(idx == -2, 0);
 
@@ -2019,7 +2091,7 @@ int Animation::audio_track_insert_key(int p_track, float p_time, const RES &p_st
 
 	int key = _insert(p_time, at->values, k);
 
-	emit_changed();
+	_changed();
 
 	return key;
 }
@@ -2035,7 +2107,7 @@ void Animation::audio_track_set_key_stream(int p_track, int p_key, const RES &p_
 
 	at->values.write[p_key].value.stream = p_stream;
 
-	emit_changed();
+	_changed();
 }
 
 void Animation::audio_track_set_key_start_offset(int p_track, int p_key, float p_offset) {
@@ -2053,7 +2125,7 @@ void Animation::audio_track_set_key_start_offset(int p_track, int p_key, float p
 
 	at->values.write[p_key].value.start_offset = p_offset;
 
-	emit_changed();
+	_changed();
 }
 
 void Animation::audio_track_set_key_end_offset(int p_track, int p_key, float p_offset) {
@@ -2071,7 +2143,7 @@ void Animation::audio_track_set_key_end_offset(int p_track, int p_key, float p_o
 
 	at->values.write[p_key].value.end_offset = p_offset;
 
-	emit_changed();
+	_changed();
 }
 
 RES Animation::audio_track_get_key_stream(int p_track, int p_key) const {
@@ -2123,7 +2195,7 @@ int Animation::animation_track_insert_key(int p_track, float p_time, const Strin
 
 	int key = _insert(p_time, at->values, k);
 
-	emit_changed();
+	_changed();
 
 	return key;
 }
@@ -2139,7 +2211,7 @@ void Animation::animation_track_set_key_animation(int p_track, int p_key, const
 
 	at->values.write[p_key].value = p_animation;
 
-	emit_changed();
+	_changed();
 }
 
 StringName Animation::animation_track_get_key_animation(int p_track, int p_key) const {
@@ -2159,7 +2231,7 @@ void Animation::set_length(float p_length) {
 		p_length = ANIM_MIN_LENGTH;
 	}
 	length = p_length;
-	emit_changed();
+	_changed();
 }
 float Animation::get_length() const {
 	return length;
@@ -2167,7 +2239,7 @@ float Animation::get_length() const {
 
 void Animation::set_loop(bool p_enabled) {
 	loop = p_enabled;
-	emit_changed();
+	_changed();
 }
 bool Animation::has_loop() const {
 	return loop;
@@ -2186,7 +2258,7 @@ bool Animation::track_is_imported(int p_track) const {
 void Animation::track_set_enabled(int p_track, bool p_enabled) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	tracks[p_track]->enabled = p_enabled;
-	emit_changed();
+	_changed();
 }
 
 bool Animation::track_is_enabled(int p_track) const {
@@ -2199,7 +2271,7 @@ void Animation::track_move_up(int p_track) {
 		SWAP(tracks.write[p_track], tracks.write[p_track + 1]);
 	}
 
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2208,7 +2280,7 @@ void Animation::track_move_down(int p_track) {
 		SWAP(tracks.write[p_track], tracks.write[p_track - 1]);
 	}
 
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2224,7 +2296,7 @@ void Animation::track_move_to(int p_track, int p_to_index) {
 	// Take into account that the position of the tracks that come after the one removed will change.
 	tracks.insert(p_to_index > p_track ? p_to_index - 1 : p_to_index, track);
 
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2236,13 +2308,13 @@ void Animation::track_swap(int p_track, int p_with_track) {
 	}
 	SWAP(tracks.write[p_track], tracks.write[p_with_track]);
 
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
 void Animation::set_step(float p_step) {
 	step = p_step;
-	emit_changed();
+	_changed();
 }
 
 float Animation::get_step() const {
@@ -2383,17 +2455,23 @@ void Animation::clear() {
 	tracks.clear();
 	loop = false;
 	length = 1;
-	emit_changed();
+	_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
 void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err, float p_max_optimizable_angle) {
 }
 
+void Animation::_changed() {
+	version++;
+	emit_changed();
+}
+
 Animation::Animation() {
 	step = 0.1;
 	loop = false;
 	length = 1;
+	version = 0;
 }
 
 Animation::~Animation() {
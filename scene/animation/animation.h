@@ -155,6 +155,10 @@ private:
 
 	template <class K>
 	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	template <class K>
+	inline int _find_hinted(const Vector<K> &p_keys, float p_time, int p_hint) const;
+	template <class K>
+	_FORCE_INLINE_ int _get_key_count_in_length(const Vector<K> &p_keys) const;
 
 	_FORCE_INLINE_ Vector3 _interpolate(const Vector3 &p_a, const Vector3 &p_b, float p_c) const;
 	_FORCE_INLINE_ Quaternion _interpolate(const Quaternion &p_a, const Quaternion &p_b, float p_c) const;
@@ -167,7 +171,9 @@ private:
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = nullptr) const;
+
+	float _bezier_track_interpolate(const BezierTrack *p_track, float p_time, int *r_cursor) const;
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -178,6 +184,9 @@ private:
 	float length;
 	float step;
 	bool loop;
+	uint64_t version; // Bumped on every change, so data sampled ahead of time can be checked against it.
+
+	void _changed();
 
 	// bind helpers
 private:
@@ -256,6 +265,7 @@ public:
 	Vector2 bezier_track_get_key_out_handle(int p_track, int p_index) const;
 
 	float bezier_track_interpolate(int p_track, float p_time) const;
+	float bezier_track_interpolate_cursor(int p_track, float p_time, int &r_cursor) const;
 
 	int audio_track_insert_key(int p_track, float p_time, const RES &p_stream, float p_start_offset = 0, float p_end_offset = 0);
 	void audio_track_set_key_stream(int p_track, int p_key, const RES &p_stream);
@@ -273,6 +283,9 @@ public:
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
 	Variant value_track_interpolate(int p_track, float p_time) const;
+	// Same as value_track_interpolate(), r_cursor keeps the key found by the previous call so
+	// playback that moves forward a little every frame doesn't binary search the keys again.
+	Variant value_track_interpolate_cursor(int p_track, float p_time, int &r_cursor) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -294,6 +307,8 @@ public:
 	void set_step(float p_step);
 	float get_step() const;
 
+	_FORCE_INLINE_ uint64_t get_version() const { return version; }
+
 	void clear();
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
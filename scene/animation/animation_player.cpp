@@ -5,6 +5,7 @@
 #include "animation_player.h"
 
 #include "core/config/engine.h"
+#include "core/config/project_settings.h"
 #include "core/object/message_queue.h"
 #include "scene/main/node_2d.h"
 #include "scene/animation/animation.h"
@@ -123,6 +124,12 @@ void AnimationPlayer::_get_property_list(List<PropertyInfo> *p_list) const {
 	p_list->push_back(PropertyInfo(Variant::ARRAY, "blend_times", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 }
 
+ThreadWorkPool AnimationPlayer::thread_pool;
+int AnimationPlayer::thread_pool_size = 0;
+LocalVector<AnimationPlayer *> AnimationPlayer::threaded_players;
+LocalVector<AnimationPlayer *> AnimationPlayer::sample_batch;
+uint64_t AnimationPlayer::sample_batch_frame[2] = { 0, 0 };
+
 void AnimationPlayer::advance(float p_time) {
 	_animation_process(p_time);
 }
@@ -138,6 +145,9 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 			//_set_process(false);
 			clear_caches();
+			if (threaded_sampling) {
+				threaded_players.push_back(this);
+			}
 		} break;
 		case NOTIFICATION_READY: {
 			if (!Engine::get_singleton()->is_editor_hint() && animation_set.has(autoplay)) {
@@ -151,6 +161,9 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 
 			if (processing) {
+				if (threaded_sampling) {
+					_sample_threaded_players(ANIMATION_PROCESS_IDLE, get_process_delta_time());
+				}
 				_animation_process(get_process_delta_time());
 			}
 		} break;
@@ -160,18 +173,24 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 
 			if (processing) {
+				if (threaded_sampling) {
+					_sample_threaded_players(ANIMATION_PROCESS_PHYSICS, get_physics_process_delta_time());
+				}
 				_animation_process(get_physics_process_delta_time());
 			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 			clear_caches();
+			if (threaded_sampling) {
+				threaded_players.erase(this);
+			}
 		} break;
 	}
 }
 
 void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_override) {
 	// Already cached?
-	if (p_anim->node_cache.size() == p_anim->animation->get_track_count()) {
+	if (p_anim->bindings.size() == (uint32_t)p_anim->animation->get_track_count()) {
 		return;
 	}
 
@@ -181,12 +200,13 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 
 	Animation *a = p_anim->animation.operator->();
 
-	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->bindings.resize(a->get_track_count());
 
 	setup_pass++;
 
 	for (int i = 0; i < a->get_track_count(); i++) {
-		p_anim->node_cache.write[i] = NULL;
+		TrackBinding &binding = p_anim->bindings[i];
+		binding = TrackBinding();
 
 		if (!a->track_is_enabled(i)) {
 			continue;
@@ -224,7 +244,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 		}
 
 		TrackNodeCache *node_cache = &node_cache_map[key];
-		p_anim->node_cache.write[i] = node_cache;
+		binding.node_cache = node_cache;
 
 		node_cache->path = a->track_get_path(i);
 		node_cache->node = child;
@@ -232,13 +252,15 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 		node_cache->node_2d = Object::cast_to<Node2D>(child);
 
 		if (a->track_get_type(i) == Animation::TYPE_VALUE) {
-			if (!node_cache->property_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			StringName subnames = a->track_get_path(i).get_concatenated_subnames();
+			RBMap<StringName, TrackNodeCache::PropertyAnim>::Element *E = node_cache->property_anim.find(subnames);
+			if (!E) {
 				TrackNodeCache::PropertyAnim pa;
 				pa.subpath = leftover_path;
 				pa.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
 				pa.special = SP_NONE;
 				pa.owner = node_cache;
-				if (false && node_cache->node_2d) {
+				if (resource.is_null() && node_cache->node_2d) {
 					if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_pos) {
 						pa.special = SP_NODE2D_POS;
 					} else if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_rot) {
@@ -247,19 +269,23 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 						pa.special = SP_NODE2D_SCALE;
 					}
 				}
-				node_cache->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
+				E = node_cache->property_anim.insert(subnames, pa);
 			}
+			binding.property = &E->get();
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_BEZIER && leftover_path.size()) {
-			if (!node_cache->bezier_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			StringName subnames = a->track_get_path(i).get_concatenated_subnames();
+			RBMap<StringName, TrackNodeCache::BezierAnim>::Element *E = node_cache->bezier_anim.find(subnames);
+			if (!E) {
 				TrackNodeCache::BezierAnim ba;
 				ba.bezier_property = leftover_path;
 				ba.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
 				ba.owner = node_cache;
 
-				node_cache->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
+				E = node_cache->bezier_anim.insert(subnames, ba);
 			}
+			binding.bezier = &E->get();
 		}
 
 		node_cache->last_setup_pass = setup_pass;
@@ -268,7 +294,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 
 void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started) {
 	_ensure_node_caches(p_anim);
-	ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
+	ERR_FAIL_COND(p_anim->bindings.size() != (uint32_t)p_anim->animation->get_track_count());
 
 	Animation *a = p_anim->animation.operator->();
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
@@ -276,11 +302,13 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	for (int i = 0; i < a->get_track_count(); i++) {
 		// If an animation changes this animation (or it animates itself)
 		// we need to recreate our animation cache
-		if (p_anim->node_cache.size() != a->get_track_count()) {
+		if (p_anim->bindings.size() != (uint32_t)a->get_track_count()) {
 			_ensure_node_caches(p_anim);
+			ERR_FAIL_COND(p_anim->bindings.size() != (uint32_t)a->get_track_count());
 		}
 
-		TrackNodeCache *nc = p_anim->node_cache[i];
+		TrackBinding &binding = p_anim->bindings[i];
+		TrackNodeCache *nc = binding.node_cache;
 
 		if (!nc) {
 			continue; // no node cache for this track, skip it
@@ -300,12 +328,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 					continue;
 				}
 
-				//StringName property=a->track_get_path(i).get_property();
-
-				RBMap<StringName, TrackNodeCache::PropertyAnim>::Element *E = nc->property_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::PropertyAnim *pa = &E->get();
+				TrackNodeCache::PropertyAnim *pa = binding.property;
+				ERR_CONTINUE(!pa);
 
 				Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
@@ -354,7 +378,13 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value;
+					if (binding.sample_pass == accum_pass && binding.sample_time == p_time && binding.sample_version == a->get_version()) {
+						value = binding.sample_value;
+						binding.sample_value = Variant();
+					} else {
+						value = a->value_track_interpolate_cursor(i, p_time, binding.key_cursor);
+					}
 
 					if (value == Variant()) {
 						continue;
@@ -380,44 +410,17 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 					for (List<int>::Element *F = indices.front(); F; F = F->next()) {
 						Variant value = a->track_get_key_value(i, F->get());
-						switch (pa->special) {
-							case SP_NONE: {
-								bool valid;
-								pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
-#ifdef DEBUG_ENABLED
-								if (!valid) {
-									ERR_PRINT("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
-								}
-#endif
-
-							} break;
-							case SP_NODE2D_POS: {
-#ifdef DEBUG_ENABLED
-								if (value.get_type() != Variant::VECTOR2) {
-									ERR_PRINT("Position key at time " + rtos(p_time) + " in Animation Track '" + String(pa->owner->path) + "' not of type Vector2(). Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
-								}
-#endif
-								static_cast<Node2D *>(pa->object)->set_position(value);
-							} break;
-							case SP_NODE2D_ROT: {
-#ifdef DEBUG_ENABLED
-								if (value.is_num()) {
-									ERR_PRINT("Rotation key at time " + rtos(p_time) + " in Animation Track '" + String(pa->owner->path) + "' not numerical. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
-								}
-#endif
+						if (_apply_special_property(pa, value)) {
+							continue;
+						}
 
-								static_cast<Node2D *>(pa->object)->set_rotation(Math::deg2rad((double)value));
-							} break;
-							case SP_NODE2D_SCALE: {
+						bool valid;
+						pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
-								if (value.get_type() != Variant::VECTOR2) {
-									ERR_PRINT("Scale key at time " + rtos(p_time) + " in Animation Track '" + String(pa->owner->path) + "' not of type Vector2()." + a->get_name() + "' at node '" + get_path() + "'.");
-								}
-#endif
-
-								static_cast<Node2D *>(pa->object)->set_scale(value);
-							} break;
+						if (!valid) {
+							ERR_PRINT("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
 						}
+#endif
 					}
 				}
 
@@ -485,12 +488,15 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 					continue;
 				}
 
-				RBMap<StringName, TrackNodeCache::BezierAnim>::Element *E = nc->bezier_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::BezierAnim *ba = &E->get();
+				TrackNodeCache::BezierAnim *ba = binding.bezier;
+				ERR_CONTINUE(!ba);
 
-				float bezier = a->bezier_track_interpolate(i, p_time);
+				float bezier;
+				if (binding.sample_pass == accum_pass && binding.sample_time == p_time && binding.sample_version == a->get_version()) {
+					bezier = binding.sample_bezier;
+				} else {
+					bezier = a->bezier_track_interpolate_cursor(i, p_time, binding.key_cursor);
+				}
 				if (ba->accum_pass != accum_pass) {
 					ERR_CONTINUE(cache_update_bezier_size >= NODE_CACHE_UPDATE_MAX);
 					cache_update_bezier[cache_update_bezier_size++] = ba;
@@ -670,20 +676,38 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	}
 }
 
-void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started) {
-	float delta = p_delta * speed_scale * cd.speed_scale;
-	float next_pos = cd.pos + delta;
-
+float AnimationPlayer::_get_next_position(const PlaybackData &cd, float p_delta) const {
+	float next_pos = cd.pos + p_delta;
 	float len = cd.from->animation->get_length();
-	bool loop = cd.from->animation->has_loop();
 
-	if (!loop) {
+	if (!cd.from->animation->has_loop()) {
 		if (next_pos < 0) {
 			next_pos = 0;
 		} else if (next_pos > len) {
 			next_pos = len;
 		}
+	} else {
+		float looped_next_pos = Math::fposmod(next_pos, len);
+		if (looped_next_pos == 0 && next_pos != 0) {
+			// Loop multiples of the length to it, rather than 0
+			// so state at time=length is previewable in the editor
+			next_pos = len;
+		} else {
+			next_pos = looped_next_pos;
+		}
+	}
+
+	return next_pos;
+}
+
+void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started) {
+	float delta = p_delta * speed_scale * cd.speed_scale;
+	float next_pos = _get_next_position(cd, delta);
+
+	float len = cd.from->animation->get_length();
+	bool loop = cd.from->animation->has_loop();
 
+	if (!loop) {
 		bool backwards = signbit(delta); // Negative zero means playing backwards too
 		delta = next_pos - cd.pos; // Fix delta (after determination of backwards because negative zero is lost here)
 
@@ -700,16 +724,6 @@ void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, f
 				end_notify = cd.pos > 0; // Notify only if not already at the beginning
 			}
 		}
-
-	} else {
-		float looped_next_pos = Math::fposmod(next_pos, len);
-		if (looped_next_pos == 0 && next_pos != 0) {
-			// Loop multiples of the length to it, rather than 0
-			// so state at time=length is previewable in the editor
-			next_pos = len;
-		} else {
-			next_pos = looped_next_pos;
-		}
 	}
 
 	cd.pos = next_pos;
@@ -741,6 +755,127 @@ void AnimationPlayer::_animation_process2(float p_delta, bool p_started) {
 	}
 }
 
+void AnimationPlayer::_sample_threaded_players(AnimationProcessMode p_mode, float p_delta) {
+	// The first threaded player processed in a frame samples the continuous tracks of all the
+	// threaded players sharing its process mode. Each player still applies its own values when it's
+	// processed, if its playback changed in between the samples no longer match and it samples again.
+	if (thread_pool_size == 0) {
+		return;
+	}
+
+	uint64_t frame = p_mode == ANIMATION_PROCESS_PHYSICS ? Engine::get_singleton()->get_physics_frames() : Engine::get_singleton()->get_idle_frames();
+	if (sample_batch_frame[p_mode] == frame + 1) {
+		return; // Already sampled this frame.
+	}
+	sample_batch_frame[p_mode] = frame + 1;
+
+	sample_batch.clear();
+	for (uint32_t i = 0; i < threaded_players.size(); i++) {
+		AnimationPlayer *player = threaded_players[i];
+		if (player->animation_process_mode != p_mode || !player->processing || !player->active || !player->playback.current.from || !player->can_process()) {
+			continue;
+		}
+
+		// Resolving tracks needs the scene tree, so it's done here rather than in the workers.
+		player->_ensure_node_caches(player->playback.current.from);
+		for (List<Blend>::Element *E = player->playback.blend.front(); E; E = E->next()) {
+			player->_ensure_node_caches(E->get().data.from);
+		}
+
+		sample_batch.push_back(player);
+	}
+
+	if (sample_batch.size() < 2) {
+		return; // Not worth waking the workers, the player samples its tracks while processing.
+	}
+
+	if (thread_pool.get_thread_count() == 0) {
+		thread_pool.init(thread_pool_size);
+	}
+
+	SampleBatch batch;
+	batch.players = sample_batch.ptr();
+	batch.delta = p_delta;
+	thread_pool.do_work(sample_batch.size(), sample_batch[0], &AnimationPlayer::_sample_batch_player, &batch);
+}
+
+void AnimationPlayer::_sample_batch_player(uint32_t p_index, SampleBatch *p_batch) {
+	p_batch->players[p_index]->_sample_playback(p_batch->delta);
+}
+
+void AnimationPlayer::_sample_playback(float p_delta) {
+	// Runs on a worker thread, only reads the animations and writes the samples in the bindings.
+	uint64_t pass = accum_pass + 1; // The pass the next _animation_process2() will use.
+
+	_sample_playback_data(playback.current, p_delta, pass);
+	for (List<Blend>::Element *E = playback.blend.front(); E; E = E->next()) {
+		_sample_playback_data(E->get().data, p_delta, pass);
+	}
+}
+
+void AnimationPlayer::_sample_playback_data(const PlaybackData &cd, float p_delta, uint64_t p_pass) {
+	AnimationData *ad = cd.from;
+	const Animation *a = ad->animation.ptr();
+	if (ad->bindings.size() != (uint32_t)a->get_track_count()) {
+		return;
+	}
+
+	// Same position _animation_process_data() will compute.
+	float time = _get_next_position(cd, p_delta * speed_scale * cd.speed_scale);
+
+	for (uint32_t i = 0; i < ad->bindings.size(); i++) {
+		TrackBinding &binding = ad->bindings[i];
+		if (!binding.node_cache || !binding.node_cache->node || !a->track_is_enabled(i) || a->track_get_key_count(i) == 0) {
+			continue;
+		}
+
+		if (binding.property) {
+			Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+			if (update_mode != Animation::UPDATE_CONTINUOUS && update_mode != Animation::UPDATE_CAPTURE) {
+				continue;
+			}
+			binding.sample_value = a->value_track_interpolate_cursor(i, time, binding.key_cursor);
+		} else if (binding.bezier) {
+			binding.sample_bezier = a->bezier_track_interpolate_cursor(i, time, binding.key_cursor);
+		} else {
+			continue;
+		}
+
+		binding.sample_time = time;
+		binding.sample_pass = p_pass;
+		binding.sample_version = a->get_version();
+	}
+}
+
+bool AnimationPlayer::_apply_special_property(TrackNodeCache::PropertyAnim *pa, const Variant &p_value) {
+	// Common Node2D properties skip the property lookup in set_indexed(). Keys of the wrong type
+	// return false, so they go through set_indexed() and get reported there.
+	switch (pa->special) {
+		case SP_NODE2D_POS: {
+			if (p_value.get_type() == Variant::VECTOR2) {
+				static_cast<Node2D *>(pa->object)->set_position(p_value);
+				return true;
+			}
+		} break;
+		case SP_NODE2D_ROT: {
+			if (p_value.is_num()) {
+				static_cast<Node2D *>(pa->object)->set_rotation(Math::deg2rad((double)p_value));
+				return true;
+			}
+		} break;
+		case SP_NODE2D_SCALE: {
+			if (p_value.get_type() == Variant::VECTOR2) {
+				static_cast<Node2D *>(pa->object)->set_scale(p_value);
+				return true;
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return false;
+}
+
 void AnimationPlayer::_animation_update_transforms() {
 	{
 		Transform t;
@@ -758,44 +893,17 @@ void AnimationPlayer::_animation_update_transforms() {
 
 		ERR_CONTINUE(pa->accum_pass != accum_pass);
 
-		switch (pa->special) {
-			case SP_NONE: {
-				bool valid;
-				pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
-#ifdef DEBUG_ENABLED
-				if (!valid) {
-					ERR_PRINT("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
-				}
-#endif
-
-			} break;
-			case SP_NODE2D_POS: {
-#ifdef DEBUG_ENABLED
-				if (pa->value_accum.get_type() != Variant::VECTOR2) {
-					ERR_PRINT("Position key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "' not of type Vector2()");
-				}
-#endif
-				static_cast<Node2D *>(pa->object)->set_position(pa->value_accum);
-			} break;
-			case SP_NODE2D_ROT: {
-#ifdef DEBUG_ENABLED
-				if (pa->value_accum.is_num()) {
-					ERR_PRINT("Rotation key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "' not numerical");
-				}
-#endif
+		if (_apply_special_property(pa, pa->value_accum)) {
+			continue;
+		}
 
-				static_cast<Node2D *>(pa->object)->set_rotation(Math::deg2rad((double)pa->value_accum));
-			} break;
-			case SP_NODE2D_SCALE: {
+		bool valid;
+		pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
-				if (pa->value_accum.get_type() != Variant::VECTOR2) {
-					ERR_PRINT("Scale key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "' not of type Vector2()");
-				}
-#endif
-
-				static_cast<Node2D *>(pa->object)->set_scale(pa->value_accum);
-			} break;
+		if (!valid) {
+			ERR_PRINT("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
 		}
+#endif
 	}
 
 	cache_update_prop_size = 0;
@@ -1256,7 +1364,7 @@ void AnimationPlayer::clear_caches() {
 	node_cache_map.clear();
 
 	for (RBMap<StringName, AnimationData>::Element *E = animation_set.front(); E; E = E->next()) {
-		E->get().node_cache.clear();
+		E->get().bindings.clear();
 	}
 
 	cache_update_size = 0;
@@ -1335,6 +1443,26 @@ AnimationPlayer::AnimationMethodCallMode AnimationPlayer::get_method_call_mode()
 	return method_call_mode;
 }
 
+void AnimationPlayer::set_threaded_sampling_enabled(bool p_enabled) {
+	if (threaded_sampling == p_enabled) {
+		return;
+	}
+
+	threaded_sampling = p_enabled;
+
+	if (is_inside_tree()) {
+		if (threaded_sampling) {
+			threaded_players.push_back(this);
+		} else {
+			threaded_players.erase(this);
+		}
+	}
+}
+
+bool AnimationPlayer::is_threaded_sampling_enabled() const {
+	return threaded_sampling;
+}
+
 void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 	if (processing == p_process && !p_force) {
 		return;
@@ -1454,6 +1582,9 @@ void AnimationPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_method_call_mode", "mode"), &AnimationPlayer::set_method_call_mode);
 	ClassDB::bind_method(D_METHOD("get_method_call_mode"), &AnimationPlayer::get_method_call_mode);
 
+	ClassDB::bind_method(D_METHOD("set_threaded_sampling_enabled", "enabled"), &AnimationPlayer::set_threaded_sampling_enabled);
+	ClassDB::bind_method(D_METHOD("is_threaded_sampling_enabled"), &AnimationPlayer::is_threaded_sampling_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_current_animation_position"), &AnimationPlayer::get_current_animation_position);
 	ClassDB::bind_method(D_METHOD("get_current_animation_length"), &AnimationPlayer::get_current_animation_length);
 
@@ -1473,6 +1604,7 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "playback_default_blend_time", PROPERTY_HINT_RANGE, "0,4096,0.01"), "set_default_blend_time", "get_default_blend_time");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "playback_active", PROPERTY_HINT_NONE, "", 0), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "playback_threaded_sampling"), "set_threaded_sampling_enabled", "is_threaded_sampling_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING_NAME, "anim_name")));
@@ -1488,6 +1620,19 @@ void AnimationPlayer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ANIMATION_METHOD_CALL_IMMEDIATE);
 }
 
+void AnimationPlayer::init_thread_pool() {
+	// -1 uses one thread per core, 0 samples every player on its own thread.
+	// The threads are only started once two or more threaded players are processed in the same frame.
+	thread_pool_size = GLOBAL_DEF_RST("animation/player/thread_count", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("animation/player/thread_count", PropertyInfo(Variant::INT, "animation/player/thread_count", PROPERTY_HINT_RANGE, "-1,64,1"));
+}
+
+void AnimationPlayer::finish_thread_pool() {
+	thread_pool.finish();
+	threaded_players.reset();
+	sample_batch.reset();
+}
+
 AnimationPlayer::AnimationPlayer() {
 	accum_pass = 1;
 	cache_update_size = 0;
@@ -1504,6 +1649,7 @@ AnimationPlayer::AnimationPlayer() {
 	root = SceneStringNames::get_singleton()->path_pp;
 	playing = false;
 	active = true;
+	threaded_sampling = false;
 	playback.seeked = false;
 	playback.started = false;
 }
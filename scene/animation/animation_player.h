@@ -4,7 +4,9 @@
 /*  animation_player.h                                                   */
 
 
+#include "core/containers/local_vector.h"
 #include "core/object/reference.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/main/node.h"
 
 class Resource;
@@ -144,6 +146,32 @@ private:
 
 	RBMap<TrackNodeCacheKey, TrackNodeCache> node_cache_map;
 
+	// Everything a track needs every frame, resolved once by _ensure_node_caches().
+	struct TrackBinding {
+		TrackNodeCache *node_cache;
+		TrackNodeCache::PropertyAnim *property;
+		TrackNodeCache::BezierAnim *bezier;
+		int key_cursor; // Key found on the previous frame, used as a search hint.
+
+		// Sampled ahead of time by a worker thread when threaded sampling is enabled.
+		uint64_t sample_pass;
+		uint64_t sample_version; // Of the animation, samples taken before it was edited are discarded.
+		float sample_time;
+		Variant sample_value;
+		float sample_bezier;
+
+		TrackBinding() :
+				node_cache(nullptr),
+				property(nullptr),
+				bezier(nullptr),
+				key_cursor(0),
+				sample_pass(0),
+				sample_version(0),
+				sample_time(0.0),
+				sample_bezier(0.0) {
+		}
+	};
+
 	TrackNodeCache *cache_update[NODE_CACHE_UPDATE_MAX];
 	int cache_update_size;
 	TrackNodeCache::PropertyAnim *cache_update_prop[NODE_CACHE_UPDATE_MAX];
@@ -159,7 +187,7 @@ private:
 	struct AnimationData {
 		String name;
 		StringName next;
-		Vector<TrackNodeCache *> node_cache;
+		LocalVector<TrackBinding> bindings;
 		Ref<Animation> animation;
 	};
 
@@ -215,14 +243,33 @@ private:
 	AnimationMethodCallMode method_call_mode;
 	bool processing;
 	bool active;
+	bool threaded_sampling;
 
 	NodePath root;
 
+	struct SampleBatch {
+		AnimationPlayer **players;
+		float delta;
+	};
+
+	static ThreadWorkPool thread_pool;
+	static int thread_pool_size;
+	static LocalVector<AnimationPlayer *> threaded_players;
+	static LocalVector<AnimationPlayer *> sample_batch;
+	static uint64_t sample_batch_frame[2];
+
+	static void _sample_threaded_players(AnimationProcessMode p_mode, float p_delta);
+	void _sample_batch_player(uint32_t p_index, SampleBatch *p_batch);
+	void _sample_playback(float p_delta);
+	void _sample_playback_data(const PlaybackData &cd, float p_delta, uint64_t p_pass);
+
 	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false);
 
 	void _ensure_node_caches(AnimationData *p_anim, Node *p_root_override = NULL);
+	float _get_next_position(const PlaybackData &cd, float p_delta) const;
 	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
 	void _animation_process2(float p_delta, bool p_started);
+	bool _apply_special_property(TrackNodeCache::PropertyAnim *pa, const Variant &p_value);
 	void _animation_update_transforms();
 	void _animation_process(float p_delta);
 
@@ -308,6 +355,9 @@ public:
 	void set_method_call_mode(AnimationMethodCallMode p_mode);
 	AnimationMethodCallMode get_method_call_mode() const;
 
+	void set_threaded_sampling_enabled(bool p_enabled);
+	bool is_threaded_sampling_enabled() const;
+
 	void seek(float p_time, bool p_update = false);
 	void seek_delta(float p_time, float p_delta);
 	float get_current_animation_position() const;
@@ -322,6 +372,9 @@ public:
 
 	void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options, const String &quote_style) const;
 
+	static void init_thread_pool();
+	static void finish_thread_pool();
+
 	AnimationPlayer();
 	~AnimationPlayer();
 };
@@ -5,6 +5,7 @@
 #include "audio_stream_player.h"
 
 #include "core/config/engine.h"
+#include "servers/audio/audio_mix.h"
 
 void AudioStreamPlayer::_mix_to_bus(const AudioFrame *p_frames, int p_amount) {
 	int bus_index = AudioServer::get_singleton()->thread_find_bus_index(bus);
@@ -33,9 +34,7 @@ void AudioStreamPlayer::_mix_to_bus(const AudioFrame *p_frames, int p_amount) {
 		if (!targets[c]) {
 			break;
 		}
-		for (int i = 0; i < p_amount; i++) {
-			targets[c][i] += p_frames[i];
-		}
+		AudioMix::accumulate(targets[c], p_frames, p_amount);
 	}
 }
 
@@ -56,10 +55,7 @@ void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
 	float vol = Math::db2linear(mix_volume_db);
 	float vol_inc = (Math::db2linear(target_volume) - vol) / float(buffer_size);
 
-	for (int i = 0; i < buffer_size; i++) {
-		buffer[i] *= vol;
-		vol += vol_inc;
-	}
+	AudioMix::scale_ramp(buffer, AudioFrame(vol, vol), AudioFrame(vol_inc, vol_inc), buffer_size);
 
 	//set volume for next mix
 	mix_volume_db = target_volume;
@@ -105,12 +101,45 @@ void AudioStreamPlayer::_mix_audio() {
 
 	stop_has_priority.clear();
 
+	if (voice_virtualized) {
+		//coming back from a virtual voice, ramp the volume in
+		voice_virtualized = false;
+		mix_volume_db = -80.0;
+	}
+
 	_mix_internal(false);
 }
 
+bool AudioStreamPlayer::_query_voice(AudioServer::VoiceState &r_state) {
+	if (!stream_playback.is_valid() || !active.is_set() || stream_paused || use_fadeout) {
+		return false;
+	}
+
+	if (setstop.is_set() || setseek.get() >= 0.0) {
+		//let a regular mix handle the fades
+		return false;
+	}
+
+	r_state.bus_index = AudioServer::get_singleton()->thread_find_bus_index(bus);
+	r_state.priority = voice_priority;
+	r_state.audibility = Math::db2linear(volume_db);
+	return true;
+}
+
+void AudioStreamPlayer::_skip_audio(int p_frames) {
+	if (!voice_virtualized) {
+		//fade out what was playing before going silent
+		_mix_internal(true);
+		p_frames -= MIN(p_frames, MIN(mix_buffer.size(), 128));
+		voice_virtualized = true;
+	}
+
+	stream_playback->skip(pitch_scale, p_frames);
+}
+
 void AudioStreamPlayer::_notification(int p_what) {
 	if (p_what == NOTIFICATION_ENTER_TREE) {
-		AudioServer::get_singleton()->add_callback(_mix_audios, this);
+		AudioServer::get_singleton()->add_voice(_mix_audios, _query_voices, _skip_audios, this);
 		if (autoplay && !Engine::get_singleton()->is_editor_hint()) {
 			play();
 		}
@@ -125,7 +154,7 @@ void AudioStreamPlayer::_notification(int p_what) {
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
-		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		AudioServer::get_singleton()->remove_voice(this);
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -285,6 +314,14 @@ AudioStreamPlayer::MixTarget AudioStreamPlayer::get_mix_target() const {
 	return mix_target;
 }
 
+void AudioStreamPlayer::set_voice_priority(int p_priority) {
+	voice_priority = p_priority;
+}
+
+int AudioStreamPlayer::get_voice_priority() const {
+	return voice_priority;
+}
+
 void AudioStreamPlayer::_set_playing(bool p_enable) {
 	if (p_enable) {
 		play();
@@ -356,6 +393,9 @@ void AudioStreamPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_mix_target", "mix_target"), &AudioStreamPlayer::set_mix_target);
 	ClassDB::bind_method(D_METHOD("get_mix_target"), &AudioStreamPlayer::get_mix_target);
 
+	ClassDB::bind_method(D_METHOD("set_voice_priority", "priority"), &AudioStreamPlayer::set_voice_priority);
+	ClassDB::bind_method(D_METHOD("get_voice_priority"), &AudioStreamPlayer::get_voice_priority);
+
 	ClassDB::bind_method(D_METHOD("_set_playing", "enable"), &AudioStreamPlayer::_set_playing);
 	ClassDB::bind_method(D_METHOD("_is_active"), &AudioStreamPlayer::_is_active);
 
@@ -374,6 +414,7 @@ void AudioStreamPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stream_paused", PROPERTY_HINT_NONE, ""), "set_stream_paused", "get_stream_paused");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "mix_target", PROPERTY_HINT_ENUM, "Stereo,Surround,Center"), "set_mix_target", "get_mix_target");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "voice_priority"), "set_voice_priority", "get_voice_priority");
 
 	ADD_SIGNAL(MethodInfo("finished"));
 
@@ -391,6 +432,8 @@ AudioStreamPlayer::AudioStreamPlayer() {
 	stream_paused = false;
 	stream_paused_fade = false;
 	mix_target = MIX_TARGET_STEREO;
+	voice_priority = 0;
+	voice_virtualized = false;
 	fadeout_buffer.resize(512);
 	use_fadeout = false;
 
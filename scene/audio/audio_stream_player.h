@@ -37,6 +37,8 @@ private:
 	bool stream_paused;
 	bool stream_paused_fade;
 	StringName bus;
+	int voice_priority;
+	bool voice_virtualized;
 
 	MixTarget mix_target;
 
@@ -44,6 +46,11 @@ private:
 	void _mix_audio();
 	static void _mix_audios(void *self) { reinterpret_cast<AudioStreamPlayer *>(self)->_mix_audio(); }
 
+	bool _query_voice(AudioServer::VoiceState &r_state);
+	static bool _query_voices(void *self, AudioServer::VoiceState &r_state) { return reinterpret_cast<AudioStreamPlayer *>(self)->_query_voice(r_state); }
+	void _skip_audio(int p_frames);
+	static void _skip_audios(void *self, int p_frames) { reinterpret_cast<AudioStreamPlayer *>(self)->_skip_audio(p_frames); }
+
 	void _set_playing(bool p_enable);
 	bool _is_active() const;
 
@@ -80,6 +87,9 @@ public:
 	void set_mix_target(MixTarget p_target);
 	MixTarget get_mix_target() const;
 
+	void set_voice_priority(int p_priority);
+	int get_voice_priority() const;
+
 	void set_stream_paused(bool p_pause);
 	bool get_stream_paused() const;
 
@@ -376,6 +376,85 @@ void AudioStreamPlaybackSample::mix(AudioFrame *p_buffer, float p_rate_scale, in
 	}
 }
 
+void AudioStreamPlaybackSample::skip(float p_rate_scale, int p_frames) {
+	if (base->format == AudioStreamSample::FORMAT_IMA_ADPCM) {
+		//no seeking in IMA_ADPCM, the decoder state has to be kept in sync
+		AudioStreamPlayback::skip(p_rate_scale, p_frames);
+		return;
+	}
+
+	if (!base->data || !active) {
+		return;
+	}
+
+	int len = base->data_bytes;
+	if (base->format == AudioStreamSample::FORMAT_16_BITS) {
+		len /= 2;
+	}
+
+	if (base->stereo) {
+		len /= 2;
+	}
+
+	int64_t loop_begin_fp = ((int64_t)base->loop_begin << MIX_FRAC_BITS);
+	int64_t loop_end_fp = ((int64_t)base->loop_end << MIX_FRAC_BITS);
+	bool looping = base->loop_mode != AudioStreamSample::LOOP_DISABLED;
+	int64_t begin_limit = looping ? loop_begin_fp : 0;
+	int64_t end_limit = looping ? loop_end_fp : ((int64_t)len << MIX_FRAC_BITS);
+
+	if (looping && loop_end_fp <= loop_begin_fp) {
+		return;
+	}
+
+	if (base->loop_mode == AudioStreamSample::LOOP_BACKWARD) {
+		sign = -1;
+	}
+
+	float global_rate_scale = AudioServer::get_singleton()->get_global_rate_scale();
+	float base_rate = AudioServer::get_singleton()->get_mix_rate() * global_rate_scale;
+	float fincrement = (base->mix_rate * p_rate_scale) / base_rate;
+	int64_t advance = int64_t(MAX(fincrement * MIX_FRAC_LEN, 1)) * p_frames;
+
+	//same loop handling as mix(), minus the resampling
+	while (advance > 0) {
+		if (sign > 0) {
+			int64_t step = MIN(advance, MAX(end_limit - offset, (int64_t)0));
+			offset += step;
+			advance -= step;
+
+			if (offset >= end_limit) {
+				if (!looping) {
+					active = false;
+					return;
+				}
+
+				if (base->loop_mode == AudioStreamSample::LOOP_PING_PONG) {
+					sign = -1;
+				} else {
+					offset = loop_begin_fp;
+				}
+			}
+		} else {
+			int64_t step = MIN(advance, MAX(offset - begin_limit, (int64_t)0));
+			offset -= step;
+			advance -= step;
+
+			if (offset <= begin_limit) {
+				if (!looping) {
+					active = false;
+					return;
+				}
+
+				if (base->loop_mode == AudioStreamSample::LOOP_PING_PONG) {
+					sign = 1;
+				} else {
+					offset = loop_end_fp;
+				}
+			}
+		}
+	}
+}
+
 AudioStreamPlaybackSample::AudioStreamPlaybackSample() {
 	active = false;
 	offset = 0;
@@ -3,8 +3,8 @@
 
 
 #include "container.h"
-#include "core/object/message_queue.h"
 #include "scene/main/scene_string_names.h"
+#include "scene/main/scene_tree.h"
 
 void Container::_child_minsize_changed() {
 	//Size2 ms = get_combined_minimum_size();
@@ -61,6 +61,8 @@ void Container::_sort_children() {
 		return;
 	}
 
+	get_tree()->layout_passes++;
+
 	notification(NOTIFICATION_SORT_CHILDREN);
 	emit_signal(SceneStringNames::get_singleton()->sort_children);
 	pending_sort = false;
@@ -114,7 +116,7 @@ void Container::queue_sort() {
 		return;
 	}
 
-	MessageQueue::get_singleton()->push_call(this, "_sort_children");
+	get_tree()->_queue_container_sort(&sort_item);
 	pending_sort = true;
 }
 
@@ -124,6 +126,11 @@ void Container::_notification(int p_what) {
 			pending_sort = false;
 			queue_sort();
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			if (sort_item.in_list()) {
+				get_tree()->container_sort_list.remove(&sort_item);
+			}
+		} break;
 		case NOTIFICATION_RESIZED: {
 			queue_sort();
 		} break;
@@ -161,6 +168,7 @@ void Container::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("sort_children"));
 }
 
-Container::Container() {
+Container::Container() :
+		sort_item(this) {
 	pending_sort = false;
 }
@@ -9,7 +9,10 @@
 class Container : public Control {
 	GDCLASS(Container, Control);
 
+	friend class SceneTree;
+
 	bool pending_sort;
+	SelfList<Container> sort_item;
 	void _sort_children();
 	void _child_minsize_changed();
 
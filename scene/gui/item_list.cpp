@@ -47,6 +47,7 @@ void ItemList::set_item_text(int p_idx, const String &p_text) {
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	items.write[p_idx].text = p_text;
+	items.write[p_idx].min_size_version = 0;
 	update();
 	shape_changed = true;
 }
@@ -83,6 +84,7 @@ void ItemList::set_item_icon(int p_idx, const Ref<Texture> &p_icon) {
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	items.write[p_idx].icon = p_icon;
+	items.write[p_idx].min_size_version = 0;
 	update();
 	shape_changed = true;
 }
@@ -97,6 +99,7 @@ void ItemList::set_item_icon_transposed(int p_idx, const bool p_transposed) {
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	items.write[p_idx].icon_transposed = p_transposed;
+	items.write[p_idx].min_size_version = 0;
 	update();
 	shape_changed = true;
 }
@@ -111,6 +114,7 @@ void ItemList::set_item_icon_region(int p_idx, const Rect2 &p_region) {
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	items.write[p_idx].icon_region = p_region;
+	items.write[p_idx].min_size_version = 0;
 	update();
 	shape_changed = true;
 }
@@ -372,6 +376,7 @@ ItemList::IconMode ItemList::get_icon_mode() const {
 
 void ItemList::set_fixed_icon_size(const Size2 &p_size) {
 	fixed_icon_size = p_size;
+	shape_changed = true;
 	update();
 }
 
@@ -427,15 +432,20 @@ void ItemList::_gui_input(const Ref<InputEvent> &p_event) {
 
 		int closest = -1;
 
-		for (int i = 0; i < items.size(); i++) {
-			Rect2 rc = items[i].rect_cache;
-			if (i % current_columns == current_columns - 1) {
-				rc.size.width = get_size().width; //not right but works
-			}
+		int row = _get_row_at_position(pos.y);
+		if (row != -1) {
+			int from = row * current_columns;
+			int to = from + MIN(current_columns, items.size() - from);
+			for (int i = from; i < to; i++) {
+				Rect2 rc = _get_item_rect(i);
+				if (i % current_columns == current_columns - 1) {
+					rc.size.width = get_size().width; //not right but works
+				}
 
-			if (rc.has_point(pos)) {
-				closest = i;
-				break;
+				if (rc.has_point(pos)) {
+					closest = i;
+					break;
+				}
 			}
 		}
 
@@ -763,8 +773,31 @@ void ItemList::_notification(int p_what) {
 		if (shape_changed) {
 			float max_column_width = 0;
 
-			//1- compute item minimum sizes
+			//settings shared by all items, if any of them changed every cached minimum size is stale
+			uint32_t signature = hash_djb2_one_64((uint64_t)font.ptr());
+			signature = hash_djb2_one_32(font_height, signature);
+			signature = hash_djb2_one_32(hseparation, signature);
+			signature = hash_djb2_one_32(vseparation, signature);
+			signature = hash_djb2_one_32(icon_margin, signature);
+			signature = hash_djb2_one_32(line_separation, signature);
+			signature = hash_djb2_one_32(icon_mode, signature);
+			signature = hash_djb2_one_32(max_text_lines, signature);
+			signature = hash_djb2_one_32(fixed_column_width, signature);
+			signature = hash_djb2_one_float(fixed_icon_size.x, signature);
+			signature = hash_djb2_one_float(fixed_icon_size.y, signature);
+			signature = hash_djb2_one_float(icon_scale, signature);
+			if (signature != min_size_signature) {
+				min_size_signature = signature;
+				min_size_version++;
+			}
+
+			//1- compute item minimum sizes, only for items that changed since the last layout
 			for (int i = 0; i < items.size(); i++) {
+				if (items[i].min_size_version == min_size_version) {
+					max_column_width = MAX(max_column_width, items[i].min_rect_cache.size.x - hseparation);
+					continue;
+				}
+
 				Size2 minsize;
 				if (items[i].icon.is_valid()) {
 					if (fixed_icon_size.x > 0 && fixed_icon_size.y > 0) {
@@ -808,79 +841,90 @@ void ItemList::_notification(int p_what) {
 				// elements need to adapt to the selected size
 				minsize.y += vseparation;
 				minsize.x += hseparation;
-				items.write[i].rect_cache.size = minsize;
 				items.write[i].min_rect_cache.size = minsize;
+				items.write[i].min_size_version = min_size_version;
 			}
 
 			int fit_size = size.x - bg->get_minimum_size().width - mw;
 
-			//2-attempt best fit
+			//2-attempt best fit, only the widths are needed to find the amount of columns
 			current_columns = 0x7FFFFFFF;
 			if (max_columns > 0) {
 				current_columns = max_columns;
 			}
 
+			layout_column_width = max_column_width;
+			layout_hseparation = hseparation;
+
 			while (true) {
 				//repeat until all fits
 				bool all_fit = true;
-				Vector2 ofs;
+				float ofs_x = 0;
 				int col = 0;
-				int max_h = 0;
-				separators.clear();
 				for (int i = 0; i < items.size(); i++) {
-					if (current_columns > 1 && items[i].rect_cache.size.width + ofs.x > fit_size) {
+					float item_width = same_column_width ? max_column_width : items[i].min_rect_cache.size.x;
+					if (current_columns > 1 && item_width + ofs_x > fit_size) {
 						//went past
 						current_columns = MAX(col, 1);
 						all_fit = false;
 						break;
 					}
 
-					if (same_column_width) {
-						items.write[i].rect_cache.size.x = max_column_width;
-					}
-					items.write[i].rect_cache.position = ofs;
-					max_h = MAX(max_h, items[i].rect_cache.size.y);
-					ofs.x += items[i].rect_cache.size.x + hseparation;
+					ofs_x += item_width + hseparation;
 					col++;
 					if (col == current_columns) {
-						if (i < items.size() - 1) {
-							separators.push_back(ofs.y + max_h + vseparation / 2);
-						}
-
-						for (int j = i; j >= 0 && col > 0; j--, col--) {
-							items.write[j].rect_cache.size.y = max_h;
-						}
-
-						ofs.x = 0;
-						ofs.y += max_h + vseparation;
+						ofs_x = 0;
 						col = 0;
-						max_h = 0;
 					}
 				}
 
-				for (int j = items.size() - 1; j >= 0 && col > 0; j--, col--) {
-					items.write[j].rect_cache.size.y = max_h;
+				if (all_fit) {
+					break;
 				}
+			}
 
-				if (all_fit) {
-					float page = MAX(0, size.height - bg->get_minimum_size().height);
-					float max = MAX(page, ofs.y + max_h);
-					if (auto_height) {
-						auto_height_value = ofs.y + max_h + bg->get_minimum_size().height;
-					}
-					scroll_bar->set_max(max);
-					scroll_bar->set_page(page);
-					if (max <= page) {
-						scroll_bar->set_value(0);
-						scroll_bar->hide();
-					} else {
-						scroll_bar->show();
+			//3-row heights and positions, the item rects themselves are computed for the visible rows only
+			rows.clear();
+			separators.clear();
+			float ofs_y = 0;
+			int max_h = 0;
+			for (int from = 0; from < items.size(); from += MIN(current_columns, items.size() - from)) {
+				int to = from + MIN(current_columns, items.size() - from);
+				max_h = 0;
+				for (int i = from; i < to; i++) {
+					max_h = MAX(max_h, items[i].min_rect_cache.size.y);
+				}
 
-						if (do_autoscroll_to_bottom) {
-							scroll_bar->set_value(max);
-						}
+				Row row;
+				row.position = ofs_y;
+				row.height = max_h;
+				rows.push_back(row);
+
+				if (to - from == current_columns) {
+					//full row
+					if (to < items.size()) {
+						separators.push_back(ofs_y + max_h + vseparation / 2);
 					}
-					break;
+					ofs_y += max_h + vseparation;
+					max_h = 0;
+				}
+			}
+
+			float page = MAX(0, size.height - bg->get_minimum_size().height);
+			float max = MAX(page, ofs_y + max_h);
+			if (auto_height) {
+				auto_height_value = ofs_y + max_h + bg->get_minimum_size().height;
+			}
+			scroll_bar->set_max(max);
+			scroll_bar->set_page(page);
+			if (max <= page) {
+				scroll_bar->set_value(0);
+				scroll_bar->hide();
+			} else {
+				scroll_bar->show();
+
+				if (do_autoscroll_to_bottom) {
+					scroll_bar->set_value(max);
 				}
 			}
 
@@ -894,7 +938,7 @@ void ItemList::_notification(int p_what) {
 
 		//ensure_selected_visible needs to be checked before we draw the list.
 		if (ensure_selected_visible && current >= 0 && current < items.size()) {
-			Rect2 r = items[current].rect_cache;
+			Rect2 r = _get_item_rect(current);
 			int from = scroll_bar->get_value();
 			int to = from + scroll_bar->get_page();
 
@@ -912,34 +956,36 @@ void ItemList::_notification(int p_what) {
 
 		const Rect2 clip(-base_ofs, size); // visible frame, don't need to draw outside of there
 
-		int first_item_visible;
+		int first_item_visible = 0;
+		int last_item_visible = 0;
 		{
-			// do a binary search to find the first item whose rect reaches below clip.position.y
+			// do a binary search to find the first row that reaches below clip.position.y
 			int lo = 0;
-			int hi = items.size();
+			int hi = rows.size();
 			while (lo < hi) {
 				const int mid = (lo + hi) / 2;
-				const Rect2 &rcache = items[mid].rect_cache;
-				if (rcache.position.y + rcache.size.y < clip.position.y) {
+				if (rows[mid].position + rows[mid].height < clip.position.y) {
 					lo = mid + 1;
 				} else {
 					hi = mid;
 				}
 			}
-			// we might have ended up with column 2, or 3, ..., so let's find the first column
-			while (lo > 0 && items[lo - 1].rect_cache.position.y == items[lo].rect_cache.position.y) {
-				lo -= 1;
+
+			// only the rects of the rows in view are laid out
+			for (int r = lo; r < rows.size() && rows[r].position <= clip.position.y + clip.size.y; r++) {
+				int from = MIN(r * current_columns, items.size());
+				int to = from + MIN(current_columns, items.size() - from);
+				if (r == lo) {
+					first_item_visible = from;
+				}
+				last_item_visible = to;
+				_layout_row(r, from, to);
 			}
-			first_item_visible = lo;
 		}
 
-		for (int i = first_item_visible; i < items.size(); i++) {
+		for (int i = first_item_visible; i < last_item_visible; i++) {
 			Rect2 rcache = items[i].rect_cache;
 
-			if (rcache.position.y > clip.position.y + clip.size.y) {
-				break; // done
-			}
-
 			if (!clip.intersects(rcache)) {
 				continue;
 			}
@@ -1141,6 +1187,57 @@ void ItemList::_notification(int p_what) {
 	}
 }
 
+Rect2 ItemList::_make_item_rect(int p_idx, int p_row, float &r_x) const {
+	Size2 size = items[p_idx].min_rect_cache.size;
+	if (same_column_width) {
+		size.x = layout_column_width;
+	}
+	size.y = rows[p_row].height;
+
+	Rect2 rect(Point2(r_x, rows[p_row].position), size);
+	r_x += size.x + layout_hseparation;
+	return rect;
+}
+
+Rect2 ItemList::_get_item_rect(int p_idx) const {
+	int row = p_idx / current_columns;
+	if (row >= rows.size()) {
+		return Rect2(); // Not laid out yet.
+	}
+
+	// Items before it in the row give its horizontal position.
+	float x = 0;
+	for (int i = row * current_columns; i < p_idx; i++) {
+		_make_item_rect(i, row, x);
+	}
+	return _make_item_rect(p_idx, row, x);
+}
+
+void ItemList::_layout_row(int p_row, int p_from, int p_to) {
+	float x = 0;
+	for (int i = p_from; i < p_to; i++) {
+		items.write[i].rect_cache = _make_item_rect(i, p_row, x);
+	}
+}
+
+int ItemList::_get_row_at_position(float p_y) const {
+	int lo = 0;
+	int hi = rows.size();
+	while (lo < hi) {
+		const int mid = (lo + hi) / 2;
+		if (rows[mid].position + rows[mid].height <= p_y) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo < rows.size() && rows[lo].position <= p_y) {
+		return lo;
+	}
+	return -1; // Between two rows, or past the last one.
+}
+
 void ItemList::_scroll_changed(double) {
 	update();
 }
@@ -1151,24 +1248,44 @@ int ItemList::get_item_at_position(const Point2 &p_pos, bool p_exact) const {
 	pos -= bg->get_offset();
 	pos.y += scroll_bar->get_value();
 
-	int closest = -1;
-	int closest_dist = 0x7FFFFFFF;
+	int row = _get_row_at_position(pos.y);
+	if (row != -1) {
+		int from = row * current_columns;
+		int to = from + MIN(current_columns, items.size() - from);
+		for (int i = from; i < to; i++) {
+			Rect2 rc = _get_item_rect(i);
+			if (i % current_columns == current_columns - 1) {
+				rc.size.width = get_size().width - rc.position.x; //make sure you can still select the last item when clicking past the column
+			}
 
-	for (int i = 0; i < items.size(); i++) {
-		Rect2 rc = items[i].rect_cache;
-		if (i % current_columns == current_columns - 1) {
-			rc.size.width = get_size().width - rc.position.x; //make sure you can still select the last item when clicking past the column
+			if (rc.has_point(pos)) {
+				return i;
+			}
 		}
+	}
 
-		if (rc.has_point(pos)) {
-			closest = i;
-			break;
-		}
+	if (p_exact) {
+		return -1;
+	}
 
-		float dist = rc.distance_to(pos);
-		if (!p_exact && dist < closest_dist) {
-			closest = i;
-			closest_dist = dist;
+	int closest = -1;
+	int closest_dist = 0x7FFFFFFF;
+
+	for (int r = 0; r < rows.size(); r++) {
+		int from = r * current_columns;
+		int to = from + MIN(current_columns, items.size() - from);
+		float x = 0;
+		for (int i = from; i < to; i++) {
+			Rect2 rc = _make_item_rect(i, r, x);
+			if (i % current_columns == current_columns - 1) {
+				rc.size.width = get_size().width - rc.position.x;
+			}
+
+			float dist = rc.distance_to(pos);
+			if (dist < closest_dist) {
+				closest = i;
+				closest_dist = dist;
+			}
 		}
 	}
 
@@ -1185,7 +1302,7 @@ bool ItemList::is_pos_at_end_of_items(const Point2 &p_pos) const {
 	pos -= bg->get_offset();
 	pos.y += scroll_bar->get_value();
 
-	Rect2 endrect = items[items.size() - 1].rect_cache;
+	Rect2 endrect = _get_item_rect(items.size() - 1);
 	return (pos.y > endrect.position.y + endrect.size.y);
 }
 
@@ -1259,6 +1376,8 @@ bool ItemList::get_allow_search() const {
 void ItemList::set_icon_scale(real_t p_scale) {
 	ERR_FAIL_COND(Math::is_nan(p_scale) || Math::is_inf(p_scale));
 	icon_scale = p_scale;
+	shape_changed = true;
+	update();
 }
 
 real_t ItemList::get_icon_scale() const {
@@ -1492,10 +1611,14 @@ ItemList::ItemList() {
 	add_child(scroll_bar);
 
 	shape_changed = true;
+	min_size_version = 1;
+	min_size_signature = 0;
 	scroll_bar->connect("value_changed", this, "_scroll_changed");
 
 	set_focus_mode(FOCUS_ALL);
 	current_columns = 1;
+	layout_column_width = 0;
+	layout_hseparation = 0;
 	search_time_msec = 0;
 	ensure_selected_visible = false;
 	defer_select_single = -1;
@@ -39,18 +39,37 @@ private:
 		Color custom_fg;
 		Color custom_bg;
 
-		Rect2 rect_cache;
+		Rect2 rect_cache; //only up to date for the items drawn last, use _get_item_rect() otherwise
 		Rect2 min_rect_cache;
+		uint32_t min_size_version; //0 when min_rect_cache needs to be recomputed
 
 		Size2 get_icon_size() const;
 
 		bool operator<(const Item &p_another) const { return text < p_another.text; }
+
+		Item() {
+			min_size_version = 0;
+		}
 	};
 
 	int current;
 
 	bool shape_changed;
 
+	//the layout only keeps the rows, item rects are computed from them when needed (for the visible rows when drawing)
+	struct Row {
+		float position;
+		int height;
+	};
+
+	Vector<Row> rows;
+	float layout_column_width;
+	int layout_hseparation;
+
+	//bumped when a setting shared by all items affects their minimum size
+	uint32_t min_size_version;
+	uint32_t min_size_signature;
+
 	bool ensure_selected_visible;
 	bool same_column_width;
 	bool allow_search;
@@ -90,6 +109,11 @@ private:
 	Array _get_items() const;
 	void _set_items(const Array &p_items);
 
+	Rect2 _make_item_rect(int p_idx, int p_row, float &r_x) const;
+	Rect2 _get_item_rect(int p_idx) const;
+	void _layout_row(int p_row, int p_from, int p_to);
+	int _get_row_at_position(float p_y) const;
+
 	void _scroll_changed(double);
 	void _gui_input(const Ref<InputEvent> &p_event);
 
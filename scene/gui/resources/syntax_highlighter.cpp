@@ -53,16 +53,64 @@ Dictionary SyntaxHighlighter::get_line_syntax_highlighting(int p_line) {
 	return color_map;
 }
 
+// Drops the cached lines from p_from_line to p_old_to_line and renumbers the ones after them,
+// so they end up after p_new_to_line. Only the cached entries are visited.
+template <class T>
+static void _shift_cached_lines(RBMap<int, T> &r_cache, int p_from_line, int p_old_to_line, int p_new_to_line) {
+	typename RBMap<int, T>::Element *E = r_cache.find_closest(p_from_line - 1);
+	E = E ? E->next() : r_cache.front();
+	while (E && E->key() <= p_old_to_line) {
+		typename RBMap<int, T>::Element *next = E->next();
+		r_cache.erase(E);
+		E = next;
+	}
+
+	int line_delta = p_new_to_line - p_old_to_line;
+	if (line_delta > 0) {
+		// Walk backwards, so a line never lands on one that has not moved yet.
+		E = r_cache.back();
+		while (E && E->key() > p_old_to_line) {
+			typename RBMap<int, T>::Element *prev = E->prev();
+			r_cache.insert(E->key() + line_delta, E->get());
+			r_cache.erase(E);
+			E = prev;
+		}
+	} else if (line_delta < 0) {
+		while (E) {
+			typename RBMap<int, T>::Element *next = E->next();
+			r_cache.insert(E->key() + line_delta, E->get());
+			r_cache.erase(E);
+			E = next;
+		}
+	}
+}
+
 void SyntaxHighlighter::_lines_edited_from(int p_from_line, int p_to_line) {
 	if (highlighting_cache.size() < 1) {
 		return;
 	}
 
-	int cache_size = highlighting_cache.back()->key();
-	for (int i = MIN(p_from_line, p_to_line) - 1; i <= cache_size; i++) {
-		if (highlighting_cache.has(i)) {
-			highlighting_cache.erase(i);
-		}
+	// TextEdit passes the last line the edit touched before and after it was made,
+	// the edit itself starts at the smaller of the two.
+	int from_line = MIN(p_from_line, p_to_line) - 1;
+
+	// Script highlighters may carry any state from one line to the next, drop everything after the edit.
+	ScriptInstance *si = get_script_instance();
+	if (si && si->has_method("_get_line_syntax_highlighting")) {
+		_clear_highlighting_from(from_line);
+		return;
+	}
+
+	_shift_cached_lines(highlighting_cache, from_line, p_from_line, p_to_line);
+	_lines_edited(from_line, p_from_line, p_to_line);
+}
+
+void SyntaxHighlighter::_clear_highlighting_from(int p_line) {
+	RBMap<int, Dictionary>::Element *E = highlighting_cache.back();
+	while (E && E->key() >= p_line) {
+		RBMap<int, Dictionary>::Element *prev = E->prev();
+		highlighting_cache.erase(E);
+		E = prev;
 	}
 }
 
@@ -422,6 +470,29 @@ void CodeHighlighter::_clear_highlighting_cache() {
 	color_region_cache.clear();
 }
 
+void CodeHighlighter::_lines_edited(int p_from_line, int p_old_to_line, int p_new_to_line) {
+	int old_region = color_region_cache.has(p_old_to_line) ? color_region_cache[p_old_to_line] : -2;
+	_shift_cached_lines(color_region_cache, p_from_line, p_old_to_line, p_new_to_line);
+
+	RBMap<int, int>::Element *E = color_region_cache.back();
+	if (!E || E->key() <= p_new_to_line) {
+		return;
+	}
+
+	// The lines after the edit are only still valid if it did not open or close a region.
+	get_line_syntax_highlighting(p_new_to_line);
+	if (color_region_cache[p_new_to_line] == old_region) {
+		return;
+	}
+
+	while (E && E->key() > p_new_to_line) {
+		RBMap<int, int>::Element *prev = E->prev();
+		color_region_cache.erase(E);
+		E = prev;
+	}
+	_clear_highlighting_from(p_new_to_line + 1);
+}
+
 void CodeHighlighter::_update_cache() {
 	font_color = text_edit->get_theme_color("font_color");
 }
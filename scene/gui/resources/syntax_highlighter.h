@@ -58,6 +58,10 @@ protected:
 	ObjectID text_edit_instance_id; // For validity check
 	TextEdit *text_edit;
 
+	// Called after an edit, once the cached lines have been renumbered.
+	virtual void _lines_edited(int p_from_line, int p_old_to_line, int p_new_to_line) {}
+	void _clear_highlighting_from(int p_line);
+
 	static void _bind_methods();
 
 private:
@@ -118,6 +122,8 @@ public:
 	~CodeHighlighter();
 
 protected:
+	virtual void _lines_edited(int p_from_line, int p_old_to_line, int p_new_to_line);
+
 	static void _bind_methods();
 
 private:
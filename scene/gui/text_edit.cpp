@@ -84,10 +84,14 @@ static int _find_first_non_whitespace_column_of_line(const String &line) {
 
 void TextEdit::Text::set_font(const Ref<Font> &p_font) {
 	font = p_font;
+	version++;
+	layout_version++;
 }
 
 void TextEdit::Text::set_indent_size(int p_indent_size) {
 	indent_size = p_indent_size;
+	version++;
+	layout_version++;
 }
 
 void TextEdit::Text::_update_line_cache(int p_line) const {
@@ -132,12 +136,16 @@ void TextEdit::Text::clear_width_cache() {
 	for (int i = 0; i < text.size(); i++) {
 		text.write[i].width_cache = -1;
 	}
+	version++;
+	layout_version++;
 }
 
 void TextEdit::Text::clear_wrap_cache() {
 	for (int i = 0; i < text.size(); i++) {
 		text.write[i].wrap_amount_cache = -1;
 	}
+	version++;
+	layout_version++;
 }
 
 void TextEdit::Text::clear_info_icons() {
@@ -152,7 +160,11 @@ void TextEdit::Text::clear() {
 }
 
 int TextEdit::Text::get_max_width(bool p_exclude_hidden) const {
-	// Quite some work, but should be fast enough.
+	// Quite some work, so it's only done again after the text changed.
+	int cache_index = p_exclude_hidden ? 1 : 0;
+	if (max_width_version[cache_index] == version) {
+		return max_width_cache[cache_index];
+	}
 
 	int max = 0;
 	for (int i = 0; i < text.size(); i++) {
@@ -160,6 +172,9 @@ int TextEdit::Text::get_max_width(bool p_exclude_hidden) const {
 			max = MAX(max, get_line_width(i));
 		}
 	}
+
+	max_width_cache[cache_index] = max;
+	max_width_version[cache_index] = version;
 	return max;
 }
 
@@ -169,6 +184,21 @@ void TextEdit::Text::set(int p_line, const String &p_text) {
 	text.write[p_line].width_cache = -1;
 	text.write[p_line].wrap_amount_cache = -1;
 	text.write[p_line].data = p_text;
+	_line_changed(p_line);
+}
+
+void TextEdit::Text::_line_changed(int p_line) {
+	version++;
+	if (changed_lines.size() > 0 && changed_lines[changed_lines.size() - 1] == p_line) {
+		return;
+	}
+	// Past one entry per line, rebuilding everything is cheaper than catching up line by line.
+	if (changed_lines.size() >= text.size()) {
+		changed_lines.clear();
+		layout_version++;
+		return;
+	}
+	changed_lines.push_back(p_line);
 }
 
 void TextEdit::Text::insert(int p_at, const String &p_text) {
@@ -183,9 +213,15 @@ void TextEdit::Text::insert(int p_at, const String &p_text) {
 	line.wrap_amount_cache = -1;
 	line.data = p_text;
 	text.insert(p_at, line);
+	version++;
+	layout_version++;
+	changed_lines.clear();
 }
 void TextEdit::Text::remove(int p_at) {
 	text.remove(p_at);
+	version++;
+	layout_version++;
+	changed_lines.clear();
 }
 
 int TextEdit::Text::get_char_width(CharType c, CharType next_c, int px) const {
@@ -4343,29 +4379,94 @@ int TextEdit::get_total_visible_rows() const {
 		return text.size();
 	}
 
-	int total_rows = 0;
-	for (int i = 0; i < text.size(); i++) {
-		if (!text.is_hidden(i)) {
-			total_rows++;
-			total_rows += times_line_wraps(i);
+	_update_line_rows();
+	return _get_rows_before_line(text.size());
+}
+
+int TextEdit::_get_line_rows(int p_line) const {
+	if (text.is_hidden(p_line)) {
+		return 0;
+	}
+	return 1 + times_line_wraps(p_line);
+}
+
+void TextEdit::_update_line_rows() const {
+	int n = text.size();
+	int current_wrap_at = is_wrap_enabled() ? wrap_at : -1;
+
+	if (line_rows_version != text.get_layout_version() || line_rows_wrap_at != current_wrap_at || line_rows.size() != n) {
+		line_rows.resize(n);
+		line_rows_sums.resize(n + 1);
+		int *rows = line_rows.ptrw();
+		int *sums = line_rows_sums.ptrw();
+
+		sums[0] = 0;
+		for (int i = 0; i < n; i++) {
+			rows[i] = _get_line_rows(i);
+			sums[i + 1] = rows[i];
 		}
+		for (int i = 1; i <= n; i++) {
+			int parent = i + (i & -i);
+			if (parent <= n) {
+				sums[parent] += sums[i];
+			}
+		}
+
+		line_rows_version = text.get_layout_version();
+		line_rows_wrap_at = current_wrap_at;
+		text.clear_changed_lines();
+		return;
+	}
+
+	const Vector<int> &changed = text.get_changed_lines();
+	if (changed.size() == 0) {
+		return;
 	}
-	return total_rows;
+
+	int *rows = line_rows.ptrw();
+	int *sums = line_rows_sums.ptrw();
+	for (int i = 0; i < changed.size(); i++) {
+		int line = changed[i];
+		int delta = _get_line_rows(line) - rows[line];
+		if (delta == 0) {
+			continue;
+		}
+		rows[line] += delta;
+		for (int j = line + 1; j <= n; j += j & -j) {
+			sums[j] += delta;
+		}
+	}
+	text.clear_changed_lines();
+}
+
+int TextEdit::_get_rows_before_line(int p_line) const {
+	const int *sums = line_rows_sums.ptr();
+	int rows = 0;
+	for (int i = p_line; i > 0; i -= i & -i) {
+		rows += sums[i];
+	}
+	return rows;
+}
+
+int TextEdit::_get_line_at_row(int p_row) const {
+	// Skips the largest amount of lines whose rows add up to at most p_row; the row is in the next one.
+	const int *sums = line_rows_sums.ptr();
+	int n = line_rows.size();
+	int line = 0;
+	for (int step = next_power_of_2(n); step > 0; step >>= 1) {
+		if (line + step <= n && sums[line + step] <= p_row) {
+			line += step;
+			p_row -= sums[line];
+		}
+	}
+	return line;
 }
 
 void TextEdit::_update_wrap_at() {
 	wrap_at = get_size().width - cache.style_normal->get_minimum_size().width - cache.line_number_w - cache.breakpoint_gutter_width - cache.fold_gutter_width - cache.info_gutter_width - cache.minimap_width - wrap_right_offset;
 	update_cursor_wrap_offset();
+	// Wrap amounts are computed again on demand by times_line_wraps(), only for the lines that are queried.
 	text.clear_wrap_cache();
-
-	for (int i = 0; i < text.size(); i++) {
-		// Update all values that wrap.
-		if (!line_wraps(i)) {
-			continue;
-		}
-		Vector<String> rows = get_wrap_rows_text(i);
-		text.set_line_wrap_amount(i, rows.size() - 1);
-	}
 }
 
 void TextEdit::adjust_viewport_to_cursor() {
@@ -4732,24 +4833,22 @@ void TextEdit::_scroll_moved(double p_to_val) {
 	if (v_scroll->is_visible_in_tree()) {
 		// Set line ofs and wrap ofs.
 		int v_scroll_i = floor(get_v_scroll());
-		int sc = 0;
-		int n_line;
-		for (n_line = 0; n_line < text.size(); n_line++) {
-			if (!is_line_hidden(n_line)) {
-				sc++;
-				sc += times_line_wraps(n_line);
-				if (sc > v_scroll_i) {
-					break;
-				}
-			}
-		}
-		n_line = MIN(n_line, text.size() - 1);
-		int line_wrap_amount = times_line_wraps(n_line);
-		int wi = line_wrap_amount - (sc - v_scroll_i - 1);
-		wi = CLAMP(wi, 0, line_wrap_amount);
+		if (!is_wrap_enabled() && !is_hiding_enabled()) {
+			cursor.line_ofs = CLAMP(v_scroll_i, 0, text.size() - 1);
+			cursor.wrap_ofs = 0;
+		} else {
+			// Find the line holding row v_scroll_i, and the rows up to and including it.
+			_update_line_rows();
+			int n_line = _get_line_at_row(MAX(v_scroll_i, 0));
+			int sc = _get_rows_before_line(MIN(n_line + 1, text.size()));
+			n_line = MIN(n_line, text.size() - 1);
+			int line_wrap_amount = times_line_wraps(n_line);
+			int wi = line_wrap_amount - (sc - v_scroll_i - 1);
+			wi = CLAMP(wi, 0, line_wrap_amount);
 
-		cursor.line_ofs = n_line;
-		cursor.wrap_ofs = wi;
+			cursor.line_ofs = n_line;
+			cursor.wrap_ofs = wi;
+		}
 	}
 	update();
 }
@@ -5166,6 +5265,7 @@ String TextEdit::get_line(int line) const {
 
 void TextEdit::_clear() {
 	clear_undo_history();
+	int last_line = text.size() - 1;
 	text.clear();
 	cursor.column = 0;
 	cursor.line = 0;
@@ -5174,6 +5274,9 @@ void TextEdit::_clear() {
 	cursor.wrap_ofs = 0;
 	cursor.last_fit_x = 0;
 	selection.active = false;
+
+	// All lines were replaced by a single empty one.
+	emit_signal("lines_edited_from", last_line, 0);
 }
 
 void TextEdit::clear() {
@@ -6396,15 +6499,10 @@ double TextEdit::get_scroll_pos_for_line(int p_line, int p_wrap_index) const {
 		return p_line;
 	}
 
-	// Count the number of visible lines up to this line.
-	double new_line_scroll_pos = 0;
+	// Count the number of visible rows up to this line.
+	_update_line_rows();
 	int to = CLAMP(p_line, 0, text.size() - 1);
-	for (int i = 0; i < to; i++) {
-		if (!text.is_hidden(i)) {
-			new_line_scroll_pos++;
-			new_line_scroll_pos += times_line_wraps(i);
-		}
-	}
+	double new_line_scroll_pos = _get_rows_before_line(to);
 	new_line_scroll_pos += p_wrap_index;
 	return new_line_scroll_pos;
 }
@@ -7500,6 +7598,9 @@ TextEdit::TextEdit() {
 	first_draw = true;
 
 	executing_line = -1;
+
+	line_rows_version = 0;
+	line_rows_wrap_at = -1;
 }
 
 TextEdit::~TextEdit() {
@@ -7508,5 +7609,5 @@ TextEdit::~TextEdit() {
 ///////////////////////////////////////////////////////////////////////////////
 
 Dictionary TextEdit::_get_line_syntax_highlighting(int p_line) {
-	return syntax_highlighter.is_null() && !setting_text ? Dictionary() : syntax_highlighter->get_line_syntax_highlighting(p_line);
+	return syntax_highlighter.is_null() ? Dictionary() : syntax_highlighter->get_line_syntax_highlighting(p_line);
 }
@@ -48,7 +48,18 @@ public:
 		Ref<Font> font;
 		int indent_size;
 
+		//bumped whenever line widths, wrapping or visibility may have changed, so aggregates over all lines can be cached
+		uint32_t version;
+		mutable int max_width_cache[2];
+		mutable uint32_t max_width_version[2];
+
+		//bumped when lines are inserted or removed, or when every line may have changed;
+		//otherwise the lines that were set or hidden since the last check are listed in changed_lines
+		uint32_t layout_version;
+		mutable Vector<int> changed_lines;
+
 		void _update_line_cache(int p_line) const;
+		void _line_changed(int p_line);
 
 	public:
 		void set_indent_size(int p_indent_size);
@@ -67,7 +78,10 @@ public:
 		bool is_bookmark(int p_line) const { return text[p_line].bookmark; }
 		void set_breakpoint(int p_line, bool p_breakpoint) { text.write[p_line].breakpoint = p_breakpoint; }
 		bool is_breakpoint(int p_line) const { return text[p_line].breakpoint; }
-		void set_hidden(int p_line, bool p_hidden) { text.write[p_line].hidden = p_hidden; }
+		void set_hidden(int p_line, bool p_hidden) {
+			text.write[p_line].hidden = p_hidden;
+			_line_changed(p_line);
+		}
 		bool is_hidden(int p_line) const { return text[p_line].hidden; }
 		void set_safe(int p_line, bool p_safe) { text.write[p_line].safe = p_safe; }
 		bool is_safe(int p_line) const { return text[p_line].safe; }
@@ -88,6 +102,10 @@ public:
 		void remove(int p_at);
 
 		int size() const { return text.size(); }
+		uint32_t get_version() const { return version; }
+		uint32_t get_layout_version() const { return layout_version; }
+		const Vector<int> &get_changed_lines() const { return changed_lines; }
+		void clear_changed_lines() const { changed_lines.clear(); }
 
 		void clear();
 		void clear_width_cache();
@@ -96,7 +114,13 @@ public:
 
 		_FORCE_INLINE_ const String &operator[](int p_line) const { return text[p_line].data; }
 
-		Text() { indent_size = 4; }
+		Text() {
+			indent_size = 4;
+			version = 1;
+			max_width_cache[0] = max_width_cache[1] = 0;
+			max_width_version[0] = max_width_version[1] = 0;
+			layout_version = 1;
+		}
 	};
 
 private:
@@ -295,6 +319,13 @@ private:
 
 	bool wrap_enabled;
 	int wrap_at;
+
+	//rows taken by each line (0 when hidden) and a Fenwick tree of their sums, so row totals and row to line lookups don't walk every line;
+	//lines that were set or hidden are updated in place, inserting or removing lines and wrap width changes rebuild them
+	mutable Vector<int> line_rows;
+	mutable Vector<int> line_rows_sums;
+	mutable uint32_t line_rows_version;
+	mutable int line_rows_wrap_at;
 	int wrap_right_offset;
 
 	bool first_draw;
@@ -387,6 +418,11 @@ private:
 	int get_visible_rows() const;
 	int get_total_visible_rows() const;
 
+	int _get_line_rows(int p_line) const;
+	void _update_line_rows() const;
+	int _get_rows_before_line(int p_line) const;
+	int _get_line_at_row(int p_row) const;
+
 	int _get_minimap_visible_rows() const;
 
 	void update_cursor_wrap_offset();
@@ -26,8 +26,12 @@ void TreeItem::move_to_top() {
 	}
 	TreeItem *prev = get_prev();
 	prev->next = next;
+	if (parent->last_child == this) {
+		parent->last_child = prev;
+	}
 	next = parent->children;
 	parent->children = this;
+	tree->_invalidate_item_layout(parent);
 }
 
 void TreeItem::move_to_bottom() {
@@ -36,10 +40,7 @@ void TreeItem::move_to_bottom() {
 	}
 
 	TreeItem *prev = get_prev();
-	TreeItem *last = next;
-	while (last->next) {
-		last = last->next;
-	}
+	TreeItem *last = parent->last_child;
 
 	if (prev) {
 		prev->next = next;
@@ -48,6 +49,8 @@ void TreeItem::move_to_bottom() {
 	}
 	last->next = this;
 	next = nullptr;
+	parent->last_child = this;
+	tree->_invalidate_item_layout(parent);
 }
 
 Size2 TreeItem::Cell::get_icon_size() const {
@@ -398,6 +401,7 @@ TreeItem *TreeItem::get_next_visible(bool p_wrap) {
 void TreeItem::remove_child(TreeItem *p_item) {
 	ERR_FAIL_NULL(p_item);
 	TreeItem **c = &children;
+	TreeItem *prev = nullptr;
 
 	while (*c) {
 		if ((*c) == p_item) {
@@ -405,14 +409,20 @@ void TreeItem::remove_child(TreeItem *p_item) {
 
 			*c = (*c)->next;
 
+			if (last_child == aux) {
+				last_child = prev;
+			}
+
 			aux->parent = nullptr;
 
 			if (tree) {
+				tree->_invalidate_item_layout(this);
 				tree->update();
 			}
 			return;
 		}
 
+		prev = *c;
 		c = &(*c)->next;
 	}
 
@@ -809,6 +819,10 @@ void TreeItem::clear_children() {
 	}
 
 	children = nullptr;
+	last_child = nullptr;
+	if (tree) {
+		tree->_invalidate_item_layout(this);
+	}
 };
 
 TreeItem::TreeItem(Tree *p_tree) {
@@ -820,6 +834,14 @@ TreeItem::TreeItem(Tree *p_tree) {
 	parent = nullptr; // parent item
 	next = nullptr; // next in list
 	children = nullptr; //child items
+	last_child = nullptr;
+
+	height_cache = 0;
+	height_version = 0;
+	subtree_height_cache = 0;
+	subtree_height_version = 0;
+	children_index_version = 0;
+	index_in_parent = 0;
 }
 
 TreeItem::~TreeItem() {
@@ -911,6 +933,73 @@ void Tree::update_cache() {
 	cache.title_button_color = get_theme_color("title_button_color");
 
 	v_scroll->set_custom_step(cache.font->get_height());
+
+	//this runs on every draw, so only drop the cached heights when something they depend on changed
+	int font_height = cache.font->get_height();
+	int checked_height = cache.checked->get_height();
+	int custom_button_height = cache.custom_button->get_minimum_size().height;
+	if (font_height != cache.layout_font_height || checked_height != cache.layout_checked_height || custom_button_height != cache.layout_custom_button_height || cache.vseparation != cache.layout_vseparation) {
+		cache.layout_font_height = font_height;
+		cache.layout_checked_height = checked_height;
+		cache.layout_custom_button_height = custom_button_height;
+		cache.layout_vseparation = cache.vseparation;
+		_invalidate_layout();
+	}
+}
+
+void Tree::_invalidate_layout() {
+	layout_version++;
+	if (layout_version == 0) {
+		layout_version = 1; //0 is never valid
+	}
+}
+
+void Tree::_invalidate_item_layout(TreeItem *p_item) {
+	p_item->height_version = 0;
+
+	//the subtree heights of all ancestors, and the offsets of their children, depend on this item
+	for (TreeItem *it = p_item; it; it = it->parent) {
+		it->subtree_height_version = 0;
+		it->children_index_version = 0;
+	}
+}
+
+void Tree::_update_children_index(TreeItem *p_item) const {
+	if (p_item->children_index_version == layout_version) {
+		return;
+	}
+
+	p_item->children_index.clear();
+	p_item->children_offsets.clear();
+
+	int ofs = 0;
+	for (TreeItem *c = p_item->children; c; c = c->next) {
+		c->index_in_parent = p_item->children_index.size();
+		p_item->children_index.push_back(c);
+		p_item->children_offsets.push_back(ofs);
+		ofs += get_item_height(c);
+	}
+	p_item->children_offsets.push_back(ofs);
+
+	p_item->children_index_version = layout_version;
+}
+
+int Tree::_find_first_child_below(TreeItem *p_item, int p_ofs) const {
+	//index of the first child whose subtree ends below p_ofs (relative to the first child), or the child count if none
+	_update_children_index(p_item);
+
+	const LocalVector<int> &offsets = p_item->children_offsets;
+	int low = 0;
+	int high = p_item->children_index.size();
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (offsets[middle + 1] <= p_ofs) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
 }
 
 int Tree::compute_item_height(TreeItem *p_item) const {
@@ -919,6 +1008,16 @@ int Tree::compute_item_height(TreeItem *p_item) const {
 	}
 
 	ERR_FAIL_COND_V(cache.font.is_null(), 0);
+
+	if (p_item->height_version != layout_version) {
+		p_item->height_cache = _compute_item_height(p_item);
+		p_item->height_version = layout_version;
+	}
+
+	return p_item->height_cache;
+}
+
+int Tree::_compute_item_height(TreeItem *p_item) const {
 	int height = cache.font->get_height();
 
 	for (int i = 0; i < columns.size(); i++) {
@@ -971,6 +1070,10 @@ int Tree::compute_item_height(TreeItem *p_item) const {
 }
 
 int Tree::get_item_height(TreeItem *p_item) const {
+	if (p_item->subtree_height_version == layout_version) {
+		return p_item->subtree_height_cache;
+	}
+
 	int height = compute_item_height(p_item);
 	height += cache.vseparation;
 
@@ -985,6 +1088,8 @@ int Tree::get_item_height(TreeItem *p_item) const {
 		}
 	}
 
+	p_item->subtree_height_cache = height;
+	p_item->subtree_height_version = layout_version;
 	return height;
 }
 
@@ -1399,6 +1504,23 @@ int Tree::draw_item(const Point2i &p_pos, const Point2 &p_draw_ofs, const Size2
 
 		int prev_ofs = children_pos.y - cache.offset.y + p_draw_ofs.y;
 
+		if (c && htotal >= 0) {
+			//children (and their relationship lines) entirely above the visible area draw nothing, jump over them
+			int margin = label_h + (int)Math::ceil(MAX(p_draw_ofs.y, 0)) + 2;
+			int first = _find_first_child_below(p_item, cache.offset.y - children_pos.y - margin);
+
+			if (first > 0) {
+				if (cache.draw_relationship_lines > 0 && (!hide_root || p_item != root)) {
+					Point2i last_skipped_pos = Point2i(0, children_pos.y + p_item->children_offsets[first - 1] + label_h / 2) - cache.offset + p_draw_ofs;
+					prev_ofs = last_skipped_pos.y;
+				}
+
+				htotal += p_item->children_offsets[first];
+				children_pos.y += p_item->children_offsets[first];
+				c = first < (int)p_item->children_index.size() ? p_item->children_index[first] : nullptr;
+			}
+		}
+
 		while (c) {
 			int child_h = -1;
 			if (htotal >= 0) {
@@ -1910,6 +2032,18 @@ int Tree::propagate_mouse_event(const Point2i &p_pos, int x_ofs, int y_ofs, bool
 
 			TreeItem *c = p_item->children;
 
+			if (c && new_pos.y > 0) {
+				//children above the event can't handle it, jump over them
+				int first = _find_first_child_below(p_item, new_pos.y);
+				if (first > 0) {
+					int skipped_h = p_item->children_offsets[first];
+					new_pos.y -= skipped_h;
+					y_ofs += skipped_h;
+					item_h += skipped_h;
+					c = first < (int)p_item->children_index.size() ? p_item->children_index[first] : nullptr;
+				}
+			}
+
 			while (c) {
 				int child_h = propagate_mouse_event(new_pos, x_ofs, y_ofs, p_doubleclick, c, p_button, p_mod);
 
@@ -2943,16 +3077,21 @@ TreeItem *Tree::create_item(TreeItem *p_parent, int p_idx) {
 		ti->cells.resize(columns.size());
 
 		TreeItem *prev = nullptr;
-		TreeItem *c = p_parent->children;
-		int idx = 0;
 
-		while (c) {
-			if (idx++ == p_idx) {
-				ti->next = c;
-				break;
+		if (p_idx < 0) {
+			prev = p_parent->last_child; //appending is the common case, don't walk the list
+		} else {
+			TreeItem *c = p_parent->children;
+			int idx = 0;
+
+			while (c) {
+				if (idx++ == p_idx) {
+					ti->next = c;
+					break;
+				}
+				prev = c;
+				c = c->next;
 			}
-			prev = c;
-			c = c->next;
 		}
 
 		if (prev) {
@@ -2960,7 +3099,11 @@ TreeItem *Tree::create_item(TreeItem *p_parent, int p_idx) {
 		} else {
 			p_parent->children = ti;
 		}
+		if (!ti->next) {
+			p_parent->last_child = ti;
+		}
 		ti->parent = p_parent;
+		_invalidate_item_layout(p_parent);
 
 	} else {
 		if (!root) {
@@ -3009,6 +3152,7 @@ void Tree::item_edited(int p_column, TreeItem *p_item, bool p_lmb) {
 }
 
 void Tree::item_changed(int p_column, TreeItem *p_item) {
+	_invalidate_item_layout(p_item);
 	update();
 }
 
@@ -3101,6 +3245,7 @@ void Tree::clear() {
 
 void Tree::set_hide_root(bool p_enabled) {
 	hide_root = p_enabled;
+	_invalidate_layout();
 	update();
 }
 
@@ -3244,6 +3389,7 @@ void Tree::set_columns(int p_columns) {
 	if (root) {
 		propagate_set_columns(root);
 	}
+	_invalidate_layout();
 	if (selected_col >= p_columns) {
 		selected_col = p_columns - 1;
 	}
@@ -3263,40 +3409,28 @@ Rect2 Tree::get_custom_popup_rect() const {
 }
 
 int Tree::get_item_offset(TreeItem *p_item) const {
-	TreeItem *it = root;
 	int ofs = _get_title_button_height();
-	if (!it) {
+	if (!root) {
 		return 0;
 	}
 
-	while (true) {
-		if (it == p_item) {
-			return ofs;
+	//add up the rows of the ancestors and the subtrees of the siblings before each of them
+	for (TreeItem *it = p_item; it != root; it = it->parent) {
+		TreeItem *parent = it->parent;
+		if (!parent || parent->collapsed) {
+			return 0; //not visible, or not in this tree
 		}
 
-		ofs += compute_item_height(it);
-		if (it != root || !hide_root) {
-			ofs += cache.vseparation;
-		}
-
-		if (it->children && !it->collapsed) {
-			it = it->children;
-
-		} else if (it->next) {
-			it = it->next;
-		} else {
-			while (!it->next) {
-				it = it->parent;
-				if (it == nullptr) {
-					return 0;
-				}
-			}
+		_update_children_index(parent);
+		ofs += parent->children_offsets[it->index_in_parent];
 
-			it = it->next;
+		ofs += compute_item_height(parent);
+		if (parent != root || !hide_root) {
+			ofs += cache.vseparation;
 		}
 	}
 
-	return -1; //not found
+	return ofs;
 }
 
 void Tree::ensure_cursor_is_visible() {
@@ -3545,6 +3679,18 @@ TreeItem *Tree::_find_item_at_pos(TreeItem *p_item, const Point2 &p_pos, int &r_
 	}
 
 	TreeItem *n = p_item->get_children();
+
+	if (n && pos.y > 0) {
+		//children above the position can't contain it, jump over them
+		int first = _find_first_child_below(p_item, pos.y);
+		if (first > 0) {
+			int skipped_h = p_item->children_offsets[first];
+			pos.y -= skipped_h;
+			h += skipped_h;
+			n = first < (int)p_item->children_index.size() ? p_item->children_index[first] : nullptr;
+		}
+	}
+
 	while (n) {
 		int ch;
 		TreeItem *r = _find_item_at_pos(n, pos, r_column, ch, section);
@@ -3952,6 +4098,12 @@ Tree::Tree() {
 	pressed_button = -1;
 	show_column_titles = false;
 
+	layout_version = 1;
+	cache.layout_font_height = -1;
+	cache.layout_checked_height = -1;
+	cache.layout_custom_button_height = -1;
+	cache.layout_vseparation = -1;
+
 	cache.click_type = Cache::CLICK_NONE;
 	cache.hover_type = Cache::CLICK_NONE;
 	cache.hover_index = -1;
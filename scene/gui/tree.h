@@ -4,6 +4,7 @@
 /*  tree.h                                                               */
 
 
+#include "core/containers/local_vector.h"
 #include "core/object/object.h"
 #include "scene/main/control.h"
 
@@ -117,8 +118,19 @@ private:
 	TreeItem *parent; // parent item
 	TreeItem *next; // next in list
 	TreeItem *children; //child items
+	TreeItem *last_child; //so appending does not walk the whole list
 	Tree *tree; //tree (for reference)
 
+	//layout cache, valid while the version matches Tree::layout_version
+	int height_cache; //compute_item_height()
+	uint32_t height_version;
+	int subtree_height_cache; //get_item_height()
+	uint32_t subtree_height_version;
+	LocalVector<TreeItem *> children_index; //children in order, for random access
+	LocalVector<int> children_offsets; //children_offsets[i] is the height of the children before i, has one extra element with the total
+	uint32_t children_index_version;
+	int index_in_parent; //valid while the children index of the parent is
+
 	TreeItem(Tree *p_tree);
 
 	void _changed_notify(int p_cell);
@@ -342,6 +354,14 @@ private:
 	bool range_up_last;
 	void _range_click_timeout();
 
+	//row and subtree heights are cached per item, bumping the version invalidates all of them
+	uint32_t layout_version;
+	void _invalidate_layout();
+	void _invalidate_item_layout(TreeItem *p_item);
+	void _update_children_index(TreeItem *p_item) const;
+	int _find_first_child_below(TreeItem *p_item, int p_ofs) const;
+
+	int _compute_item_height(TreeItem *p_item) const;
 	int compute_item_height(TreeItem *p_item) const;
 	int get_item_height(TreeItem *p_item) const;
 	//void draw_item_text(String p_text,const Ref<Texture>& p_icon,int p_icon_max_w,bool p_tool,Rect2i p_rect,const Color& p_color);
@@ -409,6 +429,12 @@ private:
 		int scroll_border;
 		int scroll_speed;
 
+		//row heights depend on these, see update_cache()
+		int layout_font_height;
+		int layout_checked_height;
+		int layout_custom_button_height;
+		int layout_vseparation;
+
 		enum ClickType {
 			CLICK_NONE,
 			CLICK_TITLE,
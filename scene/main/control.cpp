@@ -652,7 +652,7 @@ Size2 Control::get_minimum_size() const {
 }
 
 template <class T>
-T Control::get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, List<StringName> p_theme_types) {
+T Control::get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, const List<StringName> &p_theme_types) {
 	ERR_FAIL_COND_V_MSG(p_theme_types.size() == 0, T(), "At least one theme type must be specified.");
 
 	// First, look through each control node in the branch, until no valid parent can be found.
@@ -661,7 +661,7 @@ T Control::get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_dat
 
 	while (theme_owner) {
 		// For each theme resource check the theme types provided and see if p_name exists with any of them.
-		for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+		for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 			if (theme_owner && theme_owner->data.theme->has_theme_item(p_data_type, p_name, E->get())) {
 				return theme_owner->data.theme->get_theme_item(p_data_type, p_name, E->get());
 			}
@@ -677,7 +677,7 @@ T Control::get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_dat
 
 	// Secondly, check the project-defined Theme resource.
 	if (Theme::get_project_default().is_valid()) {
-		for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+		for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 			if (Theme::get_project_default()->has_theme_item(p_data_type, p_name, E->get())) {
 				return Theme::get_project_default()->get_theme_item(p_data_type, p_name, E->get());
 			}
@@ -685,16 +685,16 @@ T Control::get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_dat
 	}
 
 	// Lastly, fall back on the items defined in the default Theme, if they exist.
-	for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+	for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 		if (Theme::get_default()->has_theme_item(p_data_type, p_name, E->get())) {
 			return Theme::get_default()->get_theme_item(p_data_type, p_name, E->get());
 		}
 	}
 	// If they don't exist, use any type to return the default/empty value.
-	return Theme::get_default()->get_theme_item(p_data_type, p_name, p_theme_types[0]);
+	return Theme::get_default()->get_theme_item(p_data_type, p_name, p_theme_types.front()->get());
 }
 
-bool Control::has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, List<StringName> p_theme_types) {
+bool Control::has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, const List<StringName> &p_theme_types) {
 	ERR_FAIL_COND_V_MSG(p_theme_types.size() == 0, false, "At least one theme type must be specified.");
 
 	// First, look through each control node in the branch, until no valid parent can be found.
@@ -703,7 +703,7 @@ bool Control::has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_
 
 	while (theme_owner) {
 		// For each theme resource check the theme types provided and see if p_name exists with any of them.
-		for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+		for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 			if (theme_owner && theme_owner->data.theme->has_theme_item(p_data_type, p_name, E->get())) {
 				return true;
 			}
@@ -719,7 +719,7 @@ bool Control::has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_
 
 	// Secondly, check the project-defined Theme resource.
 	if (Theme::get_project_default().is_valid()) {
-		for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+		for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 			if (Theme::get_project_default()->has_theme_item(p_data_type, p_name, E->get())) {
 				return true;
 			}
@@ -727,7 +727,7 @@ bool Control::has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_
 	}
 
 	// Lastly, fall back on the items defined in the default Theme, if they exist.
-	for (List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
+	for (const List<StringName>::Element *E = p_theme_types.front(); E; E = E->next()) {
 		if (Theme::get_default()->has_theme_item(p_data_type, p_name, E->get())) {
 			return true;
 		}
@@ -747,6 +747,15 @@ void Control::_get_theme_type_dependencies(const StringName &p_theme_type, List<
 	}
 }
 
+const List<StringName> &Control::_get_theme_type_dependencies_cached(const StringName &p_theme_type) const {
+	List<StringName> *theme_types = data.theme_type_dependency_cache.getptr(p_theme_type);
+	if (!theme_types) {
+		theme_types = &data.theme_type_dependency_cache[p_theme_type];
+		_get_theme_type_dependencies(p_theme_type, theme_types);
+	}
+	return *theme_types;
+}
+
 Ref<Texture> Control::get_theme_icon(const StringName &p_name, const StringName &p_theme_type) const {
 	if (p_theme_type == StringName() || p_theme_type == get_class_name() || p_theme_type == data.theme_type_variation) {
 		const Ref<Texture> *tex = data.icon_override.getptr(p_name);
@@ -755,15 +764,14 @@ Ref<Texture> Control::get_theme_icon(const StringName &p_name, const StringName
 		}
 	}
 
-	if (data.theme_icon_cache.has(p_theme_type) && data.theme_icon_cache[p_theme_type].has(p_name)) {
-		return data.theme_icon_cache[p_theme_type][p_name];
+	HashMap<StringName, Ref<Texture>> &type_cache = data.theme_icon_cache[p_theme_type];
+	const Ref<Texture> *cached = type_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-
-	Ref<Texture> icon = get_theme_item_in_types<Ref<Texture>>(data.theme_owner, Theme::DATA_TYPE_ICON, p_name, theme_types);
-	data.theme_icon_cache[p_theme_type][p_name] = icon;
+	Ref<Texture> icon = get_theme_item_in_types<Ref<Texture>>(data.theme_owner, Theme::DATA_TYPE_ICON, p_name, _get_theme_type_dependencies_cached(p_theme_type));
+	type_cache[p_name] = icon;
 	return icon;
 }
 
@@ -817,15 +825,14 @@ Ref<StyleBox> Control::get_theme_stylebox(const StringName &p_name, const String
 		}
 	}
 
-	if (data.theme_style_cache.has(p_theme_type) && data.theme_style_cache[p_theme_type].has(p_name)) {
-		return data.theme_style_cache[p_theme_type][p_name];
+	HashMap<StringName, Ref<StyleBox>> &type_cache = data.theme_style_cache[p_theme_type];
+	const Ref<StyleBox> *cached = type_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-
-	Ref<StyleBox> style = get_theme_item_in_types<Ref<StyleBox>>(data.theme_owner, Theme::DATA_TYPE_STYLEBOX, p_name, theme_types);
-	data.theme_style_cache[p_theme_type][p_name] = style;
+	Ref<StyleBox> style = get_theme_item_in_types<Ref<StyleBox>>(data.theme_owner, Theme::DATA_TYPE_STYLEBOX, p_name, _get_theme_type_dependencies_cached(p_theme_type));
+	type_cache[p_name] = style;
 	return style;
 }
 
@@ -837,15 +844,14 @@ Ref<Font> Control::get_theme_font(const StringName &p_name, const StringName &p_
 		}
 	}
 
-	if (data.theme_font_cache.has(p_theme_type) && data.theme_font_cache[p_theme_type].has(p_name)) {
-		return data.theme_font_cache[p_theme_type][p_name];
+	HashMap<StringName, Ref<Font>> &type_cache = data.theme_font_cache[p_theme_type];
+	const Ref<Font> *cached = type_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-
-	Ref<Font> font = get_theme_item_in_types<Ref<Font>>(data.theme_owner, Theme::DATA_TYPE_FONT, p_name, theme_types);
-	data.theme_font_cache[p_theme_type][p_name] = font;
+	Ref<Font> font = get_theme_item_in_types<Ref<Font>>(data.theme_owner, Theme::DATA_TYPE_FONT, p_name, _get_theme_type_dependencies_cached(p_theme_type));
+	type_cache[p_name] = font;
 	return font;
 }
 
@@ -857,15 +863,14 @@ Color Control::get_theme_color(const StringName &p_name, const StringName &p_the
 		}
 	}
 
-	if (data.theme_color_cache.has(p_theme_type) && data.theme_color_cache[p_theme_type].has(p_name)) {
-		return data.theme_color_cache[p_theme_type][p_name];
+	HashMap<StringName, Color> &type_cache = data.theme_color_cache[p_theme_type];
+	const Color *cached = type_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-
-	Color color = get_theme_item_in_types<Color>(data.theme_owner, Theme::DATA_TYPE_COLOR, p_name, theme_types);
-	data.theme_color_cache[p_theme_type][p_name] = color;
+	Color color = get_theme_item_in_types<Color>(data.theme_owner, Theme::DATA_TYPE_COLOR, p_name, _get_theme_type_dependencies_cached(p_theme_type));
+	type_cache[p_name] = color;
 	return color;
 }
 
@@ -877,15 +882,14 @@ int Control::get_theme_constant(const StringName &p_name, const StringName &p_th
 		}
 	}
 
-	if (data.theme_constant_cache.has(p_theme_type) && data.theme_constant_cache[p_theme_type].has(p_name)) {
-		return data.theme_constant_cache[p_theme_type][p_name];
+	HashMap<StringName, int> &type_cache = data.theme_constant_cache[p_theme_type];
+	const int *cached = type_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-
-	int constant = get_theme_item_in_types<int>(data.theme_owner, Theme::DATA_TYPE_CONSTANT, p_name, theme_types);
-	data.theme_constant_cache[p_theme_type][p_name] = constant;
+	int constant = get_theme_item_in_types<int>(data.theme_owner, Theme::DATA_TYPE_CONSTANT, p_name, _get_theme_type_dependencies_cached(p_theme_type));
+	type_cache[p_name] = constant;
 	return constant;
 }
 
@@ -926,9 +930,7 @@ bool Control::has_theme_icon(const StringName &p_name, const StringName &p_theme
 		}
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_ICON, p_name, theme_types);
+	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_ICON, p_name, _get_theme_type_dependencies_cached(p_theme_type));
 }
 
 bool Control::has_theme_shader(const StringName &p_name, const StringName &p_theme_type) const {
@@ -977,9 +979,7 @@ bool Control::has_theme_stylebox(const StringName &p_name, const StringName &p_t
 		}
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_STYLEBOX, p_name, theme_types);
+	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_STYLEBOX, p_name, _get_theme_type_dependencies_cached(p_theme_type));
 }
 
 bool Control::has_theme_font(const StringName &p_name, const StringName &p_theme_type) const {
@@ -989,9 +989,7 @@ bool Control::has_theme_font(const StringName &p_name, const StringName &p_theme
 		}
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_FONT, p_name, theme_types);
+	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_FONT, p_name, _get_theme_type_dependencies_cached(p_theme_type));
 }
 
 bool Control::has_theme_color(const StringName &p_name, const StringName &p_theme_type) const {
@@ -1001,9 +999,7 @@ bool Control::has_theme_color(const StringName &p_name, const StringName &p_them
 		}
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_COLOR, p_name, theme_types);
+	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_COLOR, p_name, _get_theme_type_dependencies_cached(p_theme_type));
 }
 
 bool Control::has_theme_constant(const StringName &p_name, const StringName &p_theme_type) const {
@@ -1013,9 +1009,7 @@ bool Control::has_theme_constant(const StringName &p_name, const StringName &p_t
 		}
 	}
 
-	List<StringName> theme_types;
-	_get_theme_type_dependencies(p_theme_type, &theme_types);
-	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_CONSTANT, p_name, theme_types);
+	return has_theme_item_in_types(data.theme_owner, Theme::DATA_TYPE_CONSTANT, p_name, _get_theme_type_dependencies_cached(p_theme_type));
 }
 
 Ref<Font> Control::get_theme_default_font() const {
@@ -1110,6 +1104,7 @@ void Control::_size_changed() {
 
 	if (is_inside_tree()) {
 		if (size_changed) {
+			get_tree()->resize_notifications++;
 			notification(NOTIFICATION_RESIZED);
 		}
 		if (pos_changed || size_changed) {
@@ -1995,6 +1990,7 @@ void Control::_invalidate_theme_cache() {
 	data.theme_font_cache.clear();
 	data.theme_color_cache.clear();
 	data.theme_constant_cache.clear();
+	data.theme_type_dependency_cache.clear();
 }
 
 void Control::set_theme(const Ref<Theme> &p_theme) {
@@ -2029,6 +2025,9 @@ Ref<Theme> Control::get_theme() const {
 }
 
 void Control::set_theme_type_variation(const StringName &p_theme_type) {
+	if (data.theme_type_variation == p_theme_type) {
+		return;
+	}
 	data.theme_type_variation = p_theme_type;
 	_propagate_theme_changed(this, data.theme_owner);
 }
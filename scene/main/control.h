@@ -189,6 +189,7 @@ private:
 		mutable HashMap<StringName, HashMap<StringName, Ref<Font>>> theme_font_cache;
 		mutable HashMap<StringName, HashMap<StringName, Color>> theme_color_cache;
 		mutable HashMap<StringName, HashMap<StringName, int>> theme_constant_cache;
+		mutable HashMap<StringName, List<StringName>> theme_type_dependency_cache;
 
 	} data;
 
@@ -228,9 +229,10 @@ private:
 	void _update_minimum_size_cache();
 
 	template <class T>
-	static T get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, List<StringName> p_theme_types);
-	static bool has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, List<StringName> p_theme_types);
+	static T get_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, const List<StringName> &p_theme_types);
+	static bool has_theme_item_in_types(Control *p_theme_owner, Theme::DataType p_data_type, const StringName &p_name, const List<StringName> &p_theme_types);
 	_FORCE_INLINE_ void _get_theme_type_dependencies(const StringName &p_theme_type, List<StringName> *p_list) const;
+	const List<StringName> &_get_theme_type_dependencies_cached(const StringName &p_theme_type) const;
 
 protected:
 	virtual void add_child_notify(Node *p_child);
@@ -276,8 +276,8 @@ void Node::_propagate_enter_tree() {
 
 	data.inside_tree = true;
 
-	for (RBMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
-		E->get().group = data.tree->add_to_group(E->key(), this);
+	for (HashMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next) {
+		E->value().group = data.tree->add_to_group(E->key(), this);
 	}
 
 	notification(NOTIFICATION_ENTER_TREE);
@@ -374,9 +374,9 @@ void Node::_propagate_exit_tree() {
 
 	// exit groups
 
-	for (RBMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
+	for (HashMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next) {
 		data.tree->remove_from_group(E->key(), this);
-		E->get().group = nullptr;
+		E->value().group = nullptr;
 	}
 
 	data.viewport = nullptr;
@@ -510,6 +510,8 @@ void Node::set_pause_mode(PauseMode p_mode) {
 	if (!is_inside_tree()) {
 		return; //pointless
 	}
+
+	data.tree->process_lists_version++; // The process lists cache whether each node runs while paused.
 	if ((data.pause_mode == PAUSE_MODE_INHERIT) == prev_inherits) {
 		return; ///nothing changed
 	}
@@ -542,9 +544,9 @@ void Node::_propagate_pause_owner(Node *p_owner) {
 }
 
 void Node::_propagate_groups_dirty() {
-	for (const RBMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
-		if (E->get().group) {
-			E->get().group->changed = true;
+	for (const HashMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next) {
+		if (E->value().group) {
+			E->value().group->changed = true;
 		}
 	}
 
@@ -1018,34 +1020,40 @@ bool Node::can_process_notification(int p_what) const {
 	return true;
 }
 
-bool Node::can_process() const {
-	ERR_FAIL_COND_V(!is_inside_tree(), false);
-
-	if (get_tree()->is_paused()) {
-		if (data.pause_mode == PAUSE_MODE_STOP) {
-			return false;
+bool Node::_can_process_when_paused() const {
+	if (data.pause_mode == PAUSE_MODE_STOP) {
+		return false;
+	}
+	if (data.pause_mode == PAUSE_MODE_PROCESS) {
+		return true;
+	}
+	if (data.pause_mode == PAUSE_MODE_INHERIT) {
+		if (!data.pause_owner) {
+			return false; //clearly no pause owner by default
 		}
-		if (data.pause_mode == PAUSE_MODE_PROCESS) {
+
+		if (data.pause_owner->data.pause_mode == PAUSE_MODE_PROCESS) {
 			return true;
 		}
-		if (data.pause_mode == PAUSE_MODE_INHERIT) {
-			if (!data.pause_owner) {
-				return false; //clearly no pause owner by default
-			}
-
-			if (data.pause_owner->data.pause_mode == PAUSE_MODE_PROCESS) {
-				return true;
-			}
 
-			if (data.pause_owner->data.pause_mode == PAUSE_MODE_STOP) {
-				return false;
-			}
+		if (data.pause_owner->data.pause_mode == PAUSE_MODE_STOP) {
+			return false;
 		}
 	}
 
 	return true;
 }
 
+bool Node::can_process() const {
+	ERR_FAIL_COND_V(!is_inside_tree(), false);
+
+	if (get_tree()->is_paused()) {
+		return _can_process_when_paused();
+	}
+
+	return true;
+}
+
 float Node::get_physics_process_delta_time() const {
 	if (data.tree) {
 		return data.tree->get_physics_process_time();
@@ -2154,15 +2162,11 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 void Node::remove_from_group(const StringName &p_identifier) {
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
 
-	RBMap<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
-
-	ERR_FAIL_COND(!E);
-
 	if (data.tree) {
-		data.tree->remove_from_group(E->key(), this);
+		data.tree->remove_from_group(p_identifier, this);
 	}
 
-	data.grouped.erase(E);
+	data.grouped.erase(p_identifier);
 }
 
 Array Node::_get_groups() const {
@@ -2177,10 +2181,10 @@ Array Node::_get_groups() const {
 }
 
 void Node::get_groups(List<GroupInfo> *p_groups) const {
-	for (const RBMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
+	for (const HashMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next) {
 		GroupInfo gi;
 		gi.name = E->key();
-		gi.persistent = E->get().persistent;
+		gi.persistent = E->value().persistent;
 		p_groups->push_back(gi);
 	}
 }
@@ -2188,8 +2192,8 @@ void Node::get_groups(List<GroupInfo> *p_groups) const {
 int Node::get_persistent_group_count() const {
 	int count = 0;
 
-	for (const RBMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
-		if (E->get().persistent) {
+	for (const HashMap<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next) {
+		if (E->value().persistent) {
 			count += 1;
 		}
 	}
@@ -3602,6 +3606,8 @@ Node::Node() {
 	data.display_folded = false;
 	data.ready_first = true;
 	data.editable_instance = false;
+	data.pooled = false;
+	data.scene_pool_id = 0;
 
 	orphan_node_count++;
 }
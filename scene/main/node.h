@@ -99,7 +99,7 @@ private:
 		World *world;
 		ProcessGroup *process_group;
 
-		RBMap<StringName, GroupData> grouped;
+		HashMap<StringName, GroupData> grouped;
 		List<Node *>::Element *OW; // owned element
 		List<Node *> owned;
 
@@ -148,12 +148,16 @@ private:
 		bool display_folded : 1;
 		bool editable_instance : 1;
 
+		bool pooled : 1; // Waiting in, or queued for, the SceneTree scene pool.
+
 		bool inside_tree : 1;
 		bool ready_notified : 1; //this is a small hack, so if a node is added during _ready() to the tree, it correctly gets the _ready() notification
 		bool ready_first : 1;
 
 		mutable NodePath *path_cache;
 
+		ObjectID scene_pool_id; // PackedScene this node was instanced from by the scene pool.
+
 	} data;
 
 	Ref<MultiplayerAPI> multiplayer;
@@ -177,6 +181,7 @@ private:
 	void _propagate_physics_interpolation_reset_requested();
 	void _print_stray_nodes();
 	void _propagate_pause_owner(Node *p_owner);
+	bool _can_process_when_paused() const;
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
@@ -195,6 +200,7 @@ private:
 	Variant _vrpc_unreliable_bind(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 
 	friend class SceneTree;
+	friend class ScenePool;
 
 	void _set_tree(SceneTree *p_tree);
 	void _release_unique_name_in_owner();
@@ -252,6 +258,8 @@ public:
 		NOTIFICATION_READY = 13,
 		NOTIFICATION_PAUSED = 14,
 		NOTIFICATION_UNPAUSED = 15,
+		// These two are for scripts only, SceneTree may call _process / _physics_process directly instead
+		// of sending them. Engine classes use NOTIFICATION_INTERNAL_PROCESS / NOTIFICATION_INTERNAL_PHYSICS_PROCESS.
 		NOTIFICATION_PHYSICS_PROCESS = 16,
 		NOTIFICATION_PROCESS = 17,
 		NOTIFICATION_PARENTED = 18,
@@ -0,0 +1,254 @@
+
+/*  scene_pool.cpp                                                       */
+
+
+#include "scene_pool.h"
+
+#include "core/core_string_names.h"
+#include "scene/main/node.h"
+#include "scene/resources/packed_scene.h"
+
+ScenePool::Pool *ScenePool::_get_pool(const Ref<PackedScene> &p_scene) {
+	Pool **E = pools.getptr(p_scene->get_instance_id());
+	if (E) {
+		return *E;
+	}
+
+	Pool *pool = memnew(Pool);
+	pool->scene = p_scene;
+	pools.set(p_scene->get_instance_id(), pool);
+	return pool;
+}
+
+Node *ScenePool::_instance_new(Pool *p_pool) {
+	Node *node = p_pool->scene->instance();
+	ERR_FAIL_COND_V(!node, nullptr);
+
+	node->data.scene_pool_id = p_pool->scene->get_instance_id();
+
+	if (!p_pool->reset_nodes_built) {
+		// Nothing touched this instance yet, so it holds the values every recycled instance goes back to.
+		_build_reset_nodes(p_pool, node, node);
+		p_pool->reset_nodes_built = true;
+	}
+
+	return node;
+}
+
+void ScenePool::_build_reset_nodes(Pool *p_pool, Node *p_root, Node *p_node) {
+	ResetNode reset_node;
+	if (p_node != p_root) {
+		reset_node.path = p_root->get_path_to(p_node);
+	}
+
+	List<PropertyInfo> plist;
+	p_node->get_property_list(&plist);
+
+	for (List<PropertyInfo>::Element *E = plist.front(); E; E = E->next()) {
+		const PropertyInfo &pi = E->get();
+		if (!(pi.usage & PROPERTY_USAGE_STORAGE) || pi.name == CoreStringNames::get_singleton()->_script) {
+			continue;
+		}
+
+		ResetProperty prop;
+		prop.name = pi.name;
+		prop.value = p_node->get(pi.name);
+
+		if (prop.value.get_type() == Variant::OBJECT && prop.value.operator Object *()) {
+			// Resources local to scene belong to the instance that duplicated them, keep whatever it has.
+			Ref<Resource> res = prop.value;
+			if (res.is_null() || res->is_local_to_scene()) {
+				continue;
+			}
+		} else if (prop.value.get_type() == Variant::ARRAY || prop.value.get_type() == Variant::DICTIONARY) {
+			prop.value = prop.value.duplicate(true); // Shared containers, the instance could modify them in place.
+		}
+
+		reset_node.properties.push_back(prop);
+	}
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	for (List<Node::GroupInfo>::Element *E = groups.front(); E; E = E->next()) {
+		reset_node.groups.push_back(E->get().name);
+	}
+	reset_node.child_count = p_node->get_child_count();
+
+	p_pool->reset_nodes.push_back(reset_node);
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_build_reset_nodes(p_pool, p_root, p_node->get_child(i));
+	}
+}
+
+bool ScenePool::_reset(Pool *p_pool, Node *p_root) {
+	for (uint32_t i = 0; i < p_pool->reset_nodes.size(); i++) {
+		const ResetNode &reset_node = p_pool->reset_nodes[i];
+
+		Node *node = reset_node.path.is_empty() ? p_root : p_root->get_node_or_null(reset_node.path);
+		if (!node || node->get_child_count() != reset_node.child_count) {
+			return false; // The structure changed, this instance can't be reused.
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		if (groups.size() != (int)reset_node.groups.size()) {
+			return false;
+		}
+		for (uint32_t j = 0; j < reset_node.groups.size(); j++) {
+			if (!node->is_in_group(reset_node.groups[j])) {
+				return false;
+			}
+		}
+
+		for (uint32_t j = 0; j < reset_node.properties.size(); j++) {
+			const ResetProperty &prop = reset_node.properties[j];
+
+			// Only set what changed, setters can be expensive and most properties are never touched.
+			Variant value = node->get(prop.name);
+			if (value.get_type() == prop.value.get_type() && value == prop.value) {
+				continue;
+			}
+
+			if (prop.value.get_type() == Variant::ARRAY || prop.value.get_type() == Variant::DICTIONARY) {
+				node->set(prop.name, prop.value.duplicate(true));
+			} else {
+				node->set(prop.name, prop.value);
+			}
+		}
+
+		node->request_ready();
+	}
+
+	return true;
+}
+
+void ScenePool::_free_pool(Pool *p_pool) {
+	for (uint32_t i = 0; i < p_pool->instances.size(); i++) {
+		Object *obj = ObjectDB::get_instance(p_pool->instances[i]);
+		if (obj) {
+			memdelete(obj);
+		}
+	}
+
+	memdelete(p_pool);
+}
+
+Node *ScenePool::instance(const Ref<PackedScene> &p_scene) {
+	ERR_FAIL_COND_V(p_scene.is_null(), nullptr);
+
+	Pool *pool = _get_pool(p_scene);
+
+	while (pool->instances.size()) {
+		ObjectID id = pool->instances[pool->instances.size() - 1];
+		pool->instances.resize(pool->instances.size() - 1);
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (node) {
+			node->data.pooled = false;
+			hits++;
+			return node;
+		}
+	}
+
+	misses++;
+	return _instance_new(pool);
+}
+
+void ScenePool::recycle(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->data.scene_pool_id == 0, "Only nodes created by SceneTree.instance_pooled() can be recycled.");
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't recycle a node that is queued for deletion.");
+
+	if (p_node->data.pooled) {
+		return; // Already recycled.
+	}
+
+	p_node->data.pooled = true;
+	recycle_queue.push_back(p_node->get_instance_id());
+}
+
+void ScenePool::flush() {
+	// Like the delete queue, recycling is deferred to the end of the frame so the node can be
+	// removed from its parent safely, even from within a signal or a physics callback.
+	for (uint32_t i = 0; i < recycle_queue.size(); i++) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(recycle_queue[i]));
+		if (!node) {
+			continue; // Freed meanwhile.
+		}
+
+		if (node->get_parent()) {
+			node->get_parent()->remove_child(node);
+		}
+
+		Pool **E = pools.getptr(node->data.scene_pool_id);
+		if (!E || (int)(*E)->instances.size() >= max_size || node->is_queued_for_deletion() || !_reset(*E, node)) {
+			memdelete(node);
+			continue;
+		}
+
+		(*E)->instances.push_back(node->get_instance_id());
+	}
+
+	recycle_queue.clear();
+}
+
+void ScenePool::prewarm(const Ref<PackedScene> &p_scene, int p_count) {
+	ERR_FAIL_COND(p_scene.is_null());
+
+	Pool *pool = _get_pool(p_scene);
+
+	while ((int)pool->instances.size() < MIN(p_count, max_size)) {
+		Node *node = _instance_new(pool);
+		ERR_FAIL_COND(!node);
+
+		node->data.pooled = true;
+		pool->instances.push_back(node->get_instance_id());
+	}
+}
+
+int ScenePool::get_pooled_count(const Ref<PackedScene> &p_scene) const {
+	ERR_FAIL_COND_V(p_scene.is_null(), 0);
+
+	Pool *const *E = pools.getptr(p_scene->get_instance_id());
+	return E ? (*E)->instances.size() : 0;
+}
+
+void ScenePool::clear(const Ref<PackedScene> &p_scene) {
+	ERR_FAIL_COND(p_scene.is_null());
+
+	Pool **E = pools.getptr(p_scene->get_instance_id());
+	if (E) {
+		_free_pool(*E);
+		pools.erase(p_scene->get_instance_id());
+	}
+}
+
+void ScenePool::clear_all() {
+	// Nodes still waiting to be recycled are freed along with the pools.
+	flush();
+
+	for (HashMap<ObjectID, Pool *>::Element *E = pools.front(); E; E = E->next) {
+		_free_pool(E->value());
+	}
+	pools.clear();
+}
+
+void ScenePool::set_max_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	max_size = p_size;
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+ScenePool::ScenePool() {
+	max_size = 256;
+	hits = 0;
+	misses = 0;
+}
+
+ScenePool::~ScenePool() {
+	clear_all();
+}
@@ -0,0 +1,79 @@
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+/*  scene_pool.h                                                         */
+
+
+#include "core/containers/hash_map.h"
+#include "core/containers/local_vector.h"
+#include "core/object/reference.h"
+
+class Node;
+class PackedScene;
+
+/**
+	Keeps detached instances of PackedScenes around so they can be handed out again
+	instead of being built from scratch.
+
+	Recycled nodes are removed from the tree, their stored properties are reset to the
+	values a fresh instance of their scene has, and they are stored until the next
+	SceneTree::instance_pooled() call for that scene. The reset values are captured from
+	the first instance made for the scene, so they include both the SceneState property
+	data and the class defaults. Instances whose children or groups changed are freed
+	instead, and every reused node gets _ready() again when it reenters the tree.
+*/
+
+class ScenePool {
+	struct ResetProperty {
+		StringName name;
+		Variant value;
+	};
+
+	struct ResetNode {
+		NodePath path; // Relative to the scene root, empty for the root itself.
+		LocalVector<ResetProperty> properties;
+		LocalVector<StringName> groups;
+		int child_count = 0;
+	};
+
+	struct Pool {
+		Ref<PackedScene> scene;
+		LocalVector<ObjectID> instances;
+		LocalVector<ResetNode> reset_nodes;
+		bool reset_nodes_built = false;
+	};
+
+	HashMap<ObjectID, Pool *> pools; // Keyed by the PackedScene instance ID.
+	LocalVector<ObjectID> recycle_queue;
+
+	int max_size;
+	uint64_t hits;
+	uint64_t misses;
+
+	Pool *_get_pool(const Ref<PackedScene> &p_scene);
+	Node *_instance_new(Pool *p_pool);
+	void _build_reset_nodes(Pool *p_pool, Node *p_root, Node *p_node);
+	bool _reset(Pool *p_pool, Node *p_root);
+	void _free_pool(Pool *p_pool);
+
+public:
+	Node *instance(const Ref<PackedScene> &p_scene);
+	void recycle(Node *p_node);
+	void flush();
+
+	void prewarm(const Ref<PackedScene> &p_scene, int p_count);
+	int get_pooled_count(const Ref<PackedScene> &p_scene) const;
+	void clear(const Ref<PackedScene> &p_scene);
+	void clear_all();
+
+	void set_max_size(int p_size);
+	int get_max_size() const;
+
+	uint64_t get_hits() const { return hits; }
+	uint64_t get_misses() const { return misses; }
+
+	ScenePool();
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
@@ -75,6 +75,7 @@ SceneStringNames::SceneStringNames() {
 
 	_physics_process = StaticCString::create("_physics_process");
 	_process = StaticCString::create("_process");
+	_notification = StaticCString::create("_notification");
 
 	_process_group_process = StaticCString::create("_process_group_process");
 	_process_group_physics_process = StaticCString::create("_process_group_physics_process");
@@ -93,6 +93,7 @@ public:
 
 	StringName _physics_process;
 	StringName _process;
+	StringName _notification;
 	StringName _process_group_process;
 	StringName _process_group_physics_process;
 	StringName _enter_world;
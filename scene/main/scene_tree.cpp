@@ -17,6 +17,7 @@
 #include "main/input_default.h"
 #include "node.h"
 #include "scene/animation/scene_tree_tween.h"
+#include "scene/gui/container.h"
 #include "scene/main/control.h"
 #include "scene/main/scene_string_names.h"
 #include "scene/resources/material/material.h"
@@ -95,9 +96,6 @@ void SceneTree::node_removed(Node *p_node) {
 		current_scene = nullptr;
 	}
 	emit_signal(node_removed_name, p_node);
-	if (call_lock > 0) {
-		call_skip.insert(p_node);
-	}
 }
 
 void SceneTree::node_renamed(Node *p_node) {
@@ -107,36 +105,46 @@ void SceneTree::node_renamed(Node *p_node) {
 SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
 	_THREAD_SAFE_METHOD_
 
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
-		E = group_map.insert(p_group, Group());
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
+		g = &group_map.insert(p_group, Group())->value();
 	}
 
-	ERR_FAIL_COND_V_MSG(E->get().nodes.find(p_node) != -1, &E->get(), "Already in group: " + p_group + ".");
-	E->get().nodes.push_back(p_node);
-	//E->get().last_tree_version=0;
-	E->get().changed = true;
-	return &E->get();
+	ERR_FAIL_COND_V_MSG(g->nodes.find(p_node) != -1, g, "Already in group: " + p_group + ".");
+	g->nodes.push_back(p_node);
+	g->changed = true;
+	return g;
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	_THREAD_SAFE_METHOD_
 
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	ERR_FAIL_COND(!E);
+	Group *g = group_map.getptr(p_group);
+	ERR_FAIL_COND(!g);
 
-	E->get().nodes.erase(p_node);
-	if (E->get().nodes.empty()) {
-		group_map.erase(E);
+	if (g->lock) {
+		// The group is being iterated, leave a hole so the remaining nodes keep their index.
+		int64_t idx = g->nodes.find(p_node);
+		if (idx != -1) {
+			g->nodes[idx] = nullptr;
+			g->removed++;
+		}
+		return;
+	}
+
+	g->nodes.erase(p_node);
+	if (g->nodes.empty()) {
+		group_map.erase(p_group);
+		process_lists_version++; // A new group could get the same address.
 	}
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
 	_THREAD_SAFE_METHOD_
 
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	if (E) {
-		E->get().changed = true;
+	Group *g = group_map.getptr(p_group);
+	if (g) {
+		g->changed = true;
 	}
 }
 
@@ -153,6 +161,49 @@ void SceneTree::flush_transform_notifications() {
 	}
 }
 
+void SceneTree::_queue_container_sort(SelfList<Container> *p_item) {
+	container_sort_list.add(p_item);
+
+	if (!container_sort_queued) {
+		MessageQueue::get_singleton()->push_call(this, "_flush_container_sorts");
+		container_sort_queued = true;
+	}
+}
+
+void SceneTree::_flush_container_sorts() {
+	//sorting a container resizes its children, which queues them again, so keep going until nothing is left
+	while (container_sort_list.first()) {
+		container_sort_batch.clear();
+
+		SelfList<Container> *E = container_sort_list.first();
+		while (E) {
+			Node *node = E->self();
+			SelfList<Container> *N = E->next();
+			container_sort_list.remove(E);
+
+			ContainerSort cs;
+			cs.depth = node->data.depth;
+			cs.id = node->get_instance_id();
+			container_sort_batch.push_back(cs);
+
+			E = N;
+		}
+
+		//parents first, so every child is sorted once with its final size
+		container_sort_batch.sort();
+
+		for (uint32_t i = 0; i < container_sort_batch.size(); i++) {
+			//a sort may free other containers, so they are looked up again
+			Container *container = Object::cast_to<Container>(ObjectDB::get_instance(container_sort_batch[i].id));
+			if (container) {
+				container->_sort_children();
+			}
+		}
+	}
+
+	container_sort_queued = false;
+}
+
 void SceneTree::_flush_ugc() {
 	ugc_locked = true;
 
@@ -177,11 +228,14 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 	if (!g.changed) {
 		return;
 	}
+	if (g.lock) {
+		return; // Sorted once nobody iterates it anymore.
+	}
 	if (g.nodes.empty()) {
 		return;
 	}
 
-	Node **nodes = g.nodes.ptrw();
+	Node **nodes = g.nodes.ptr();
 	int node_count = g.nodes.size();
 
 	if (p_use_priority) {
@@ -192,224 +246,160 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 		node_sort.sort(nodes, node_count);
 	}
 	g.changed = false;
+	g.generation++;
 }
 
-void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
-	Vector<Node *> nodes_copy;
-
-	{
-		_THREAD_SAFE_METHOD_
-
-		RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-		if (!E) {
-			return;
-		}
-		Group &g = E->get();
-		if (g.nodes.empty()) {
-			return;
-		}
-
-		if (p_call_flags & GROUP_CALL_UNIQUE && !(p_call_flags & GROUP_CALL_REALTIME)) {
-			ERR_FAIL_COND(ugc_locked);
+SceneTree::Group *SceneTree::_lock_group(const StringName &p_group, bool p_use_priority) {
+	_THREAD_SAFE_METHOD_
 
-			UGCall ug;
-			ug.call = p_function;
-			ug.group = p_group;
+	Group *g = group_map.getptr(p_group);
+	if (!g || g->get_node_count() == 0) {
+		return nullptr;
+	}
 
-			if (unique_group_calls.has(ug)) {
-				return;
-			}
+	_update_group_order(*g, p_use_priority);
+	g->lock++;
+	return g;
+}
 
-			VARIANT_ARGPTRS;
+void SceneTree::_unlock_group(const StringName &p_group, Group *p_group_data) {
+	_THREAD_SAFE_METHOD_
 
-			Vector<Variant> args;
-			for (int i = 0; i < VARIANT_ARG_MAX; i++) {
-				if (argptr[i]->get_type() == Variant::NIL) {
-					break;
-				}
-				args.push_back(*argptr[i]);
-			}
+	p_group_data->lock--;
+	if (p_group_data->lock > 0 || p_group_data->removed == 0) {
+		return;
+	}
 
-			unique_group_calls[ug] = args;
-			return;
+	// Drop the holes left by nodes that left the group while it was iterated, keeping the order.
+	Node **nodes = p_group_data->nodes.ptr();
+	uint32_t node_count = 0;
+	for (uint32_t i = 0; i < p_group_data->nodes.size(); i++) {
+		if (nodes[i]) {
+			nodes[node_count++] = nodes[i];
 		}
-
-		_update_group_order(g);
-
-		nodes_copy = g.nodes;
 	}
+	p_group_data->nodes.resize(node_count);
+	p_group_data->removed = 0;
+	p_group_data->generation++;
 
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
-
-	_THREAD_SAFE_LOCK_
-	call_lock++;
-	_THREAD_SAFE_UNLOCK_
-
-	if (p_call_flags & GROUP_CALL_REVERSE) {
-		for (int i = node_count - 1; i >= 0; i--) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
+	if (node_count == 0) {
+		group_map.erase(p_group);
+		process_lists_version++; // A new group could get the same address.
+	}
+}
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				if (p_call_flags & GROUP_CALL_MULTILEVEL) {
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
-				} else {
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
-				}
-			} else {
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
-			}
-		}
+SceneTree::GroupIterator::GroupIterator(SceneTree *p_tree, const StringName &p_group, bool p_reverse, bool p_use_priority) :
+		tree(p_tree),
+		group_name(p_group) {
+	group = tree->_lock_group(p_group, p_use_priority);
+	generation = group ? group->generation : 0;
 
+	// Only the nodes already in the group are visited, the ones added meanwhile go past the end.
+	int node_count = group ? group->nodes.size() : 0;
+	if (p_reverse) {
+		index = node_count - 1;
+		end = -1;
+		step = -1;
 	} else {
-		for (int i = 0; i < node_count; i++) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
-
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				if (p_call_flags & GROUP_CALL_MULTILEVEL) {
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
-				} else {
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
-				}
-			} else {
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
-			}
-		}
+		index = 0;
+		end = node_count;
+		step = 1;
 	}
+}
 
-	_THREAD_SAFE_LOCK_
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+SceneTree::GroupIterator::~GroupIterator() {
+	if (group) {
+		tree->_unlock_group(group_name, group);
 	}
-	_THREAD_SAFE_UNLOCK_
 }
 
-void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
-	Vector<Node *> nodes_copy;
-
-	{
-		_THREAD_SAFE_METHOD_
-		RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-		if (!E) {
-			return;
-		}
-		Group &g = E->get();
-		if (g.nodes.empty()) {
-			return;
-		}
-
-		_update_group_order(g);
-
-		nodes_copy = g.nodes;
+Node *SceneTree::GroupIterator::next() {
+	if (!group) {
+		return nullptr;
 	}
 
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
-
-	_THREAD_SAFE_LOCK_
-	call_lock++;
-	_THREAD_SAFE_UNLOCK_
-
-	if (p_call_flags & GROUP_CALL_REVERSE) {
-		for (int i = node_count - 1; i >= 0; i--) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
-
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->notification(p_notification);
-			} else {
-				MessageQueue::get_singleton()->push_notification(nodes[i], p_notification);
-			}
-		}
-
-	} else {
-		for (int i = 0; i < node_count; i++) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
+	// A locked group is never reordered or compacted, so the indices are still the ones the iteration started with.
+	ERR_FAIL_COND_V(group->generation != generation, nullptr);
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->notification(p_notification);
-			} else {
-				MessageQueue::get_singleton()->push_notification(nodes[i], p_notification);
-			}
+	while (index != end) {
+		// Read through the group every time, nodes joining it may have reallocated the list.
+		Node *node = group->nodes[index];
+		index += step;
+		if (node) {
+			return node;
 		}
 	}
 
-	_THREAD_SAFE_LOCK_
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
-	}
-	_THREAD_SAFE_UNLOCK_
+	return nullptr;
 }
 
-void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
-	Vector<Node *> nodes_copy;
-
-	{
+void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
+	if (p_call_flags & GROUP_CALL_UNIQUE && !(p_call_flags & GROUP_CALL_REALTIME)) {
 		_THREAD_SAFE_METHOD_
 
-		RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-		if (!E) {
-			return;
-		}
-		Group &g = E->get();
-		if (g.nodes.empty()) {
+		const Group *g = group_map.getptr(p_group);
+		if (!g || g->get_node_count() == 0) {
 			return;
 		}
 
-		_update_group_order(g);
+		ERR_FAIL_COND(ugc_locked);
 
-		nodes_copy = g.nodes;
-	}
+		UGCall ug;
+		ug.call = p_function;
+		ug.group = p_group;
 
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
+		if (unique_group_calls.has(ug)) {
+			return;
+		}
 
-	_THREAD_SAFE_LOCK_
-	call_lock++;
-	_THREAD_SAFE_UNLOCK_
+		VARIANT_ARGPTRS;
 
-	if (p_call_flags & GROUP_CALL_REVERSE) {
-		for (int i = node_count - 1; i >= 0; i--) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
-
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->set(p_name, p_value);
-			} else {
-				MessageQueue::get_singleton()->push_set(nodes[i], p_name, p_value);
+		Vector<Variant> args;
+		for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+			if (argptr[i]->get_type() == Variant::NIL) {
+				break;
 			}
+			args.push_back(*argptr[i]);
 		}
 
-	} else {
-		for (int i = 0; i < node_count; i++) {
-			if (call_lock && call_skip.has(nodes[i])) {
-				continue;
-			}
+		unique_group_calls[ug] = args;
+		return;
+	}
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->set(p_name, p_value);
+	GroupIterator it(this, p_group, p_call_flags & GROUP_CALL_REVERSE);
+	while (Node *node = it.next()) {
+		if (p_call_flags & GROUP_CALL_REALTIME) {
+			if (p_call_flags & GROUP_CALL_MULTILEVEL) {
+				node->call_multilevel(p_function, VARIANT_ARG_PASS);
 			} else {
-				MessageQueue::get_singleton()->push_set(nodes[i], p_name, p_value);
+				node->call(p_function, VARIANT_ARG_PASS);
 			}
+		} else {
+			MessageQueue::get_singleton()->push_call(node, p_function, VARIANT_ARG_PASS);
 		}
 	}
+}
+
+void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
+	GroupIterator it(this, p_group, p_call_flags & GROUP_CALL_REVERSE);
+	while (Node *node = it.next()) {
+		if (p_call_flags & GROUP_CALL_REALTIME) {
+			node->notification(p_notification);
+		} else {
+			MessageQueue::get_singleton()->push_notification(node, p_notification);
+		}
+	}
+}
 
-	_THREAD_SAFE_LOCK_
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
+	GroupIterator it(this, p_group, p_call_flags & GROUP_CALL_REVERSE);
+	while (Node *node = it.next()) {
+		if (p_call_flags & GROUP_CALL_REALTIME) {
+			node->set(p_name, p_value);
+		} else {
+			MessageQueue::get_singleton()->push_set(node, p_name, p_value);
+		}
 	}
-	_THREAD_SAFE_UNLOCK_
 }
 
 void SceneTree::call_group(const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
@@ -540,7 +530,7 @@ bool SceneTree::iteration(float p_time) {
 	if (GLOBAL_GET("physics/common/enable_pause_aware_picking")) {
 		call_group_flags(GROUP_CALL_REALTIME, "_viewports", "_process_picking", true);
 	}
-	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
+	_process_group(physics_process_list, "physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
 
 	// Wait for all ProcessGroups to finish
 	call_group_flags(GROUP_CALL_REALTIME, "_pg_process", "wait_physics_process");
@@ -580,6 +570,11 @@ bool SceneTree::idle(float p_time) {
 
 	idle_process_time = p_time;
 
+	layout_passes_in_frame = layout_passes;
+	layout_passes = 0;
+	resize_notifications_in_frame = resize_notifications;
+	resize_notifications = 0;
+
 	if (multiplayer_poll) {
 		multiplayer->poll();
 	}
@@ -596,7 +591,7 @@ bool SceneTree::idle(float p_time) {
 	call_group_flags(GROUP_CALL_REALTIME, "_pg_process", "trigger_process");
 
 	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
-	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
+	_process_group(idle_process_list, "idle_process", Node::NOTIFICATION_PROCESS);
 
 	// Wait for all ProcessGroups to finish
 	call_group_flags(GROUP_CALL_REALTIME, "_pg_process", "wait_process");
@@ -712,6 +707,8 @@ void SceneTree::finish() {
 	// E.g. if `queue_free()` was called for some node outside the tree when handling NOTIFICATION_PREDELETE for some node in the tree.
 	_flush_delete_queue();
 
+	scene_pool.clear_all();
+
 	// Cleanup timers.
 	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E; E = E->next()) {
 		E->get()->release_connections();
@@ -977,56 +974,118 @@ bool SceneTree::is_paused() const {
 }
 
 void SceneTree::_notify_group_pause(const StringName &p_group, int p_notification) {
-	Vector<Node *> nodes_copy;
+	bool use_priority = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS;
 
-	{
-		_THREAD_SAFE_METHOD_
-		RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-		if (!E) {
-			return;
+	GroupIterator it(this, p_group, false, use_priority);
+	while (Node *n = it.next()) {
+		if (!n->can_process()) {
+			continue;
 		}
-		Group &g = E->get();
-		if (g.nodes.empty()) {
-			return;
+		if (!n->can_process_notification(p_notification)) {
+			continue;
+		}
+
+		n->notification(p_notification);
+	}
+}
+
+static void _process_notify(Node *p_node, int p_notification) {
+	p_node->notification(p_notification);
+}
+
+// Engine classes only use the internal process notifications, so NOTIFICATION_PROCESS and NOTIFICATION_PHYSICS_PROCESS
+// only make Node::_notification() call the script. When the script doesn't take notifications, that call is all there is to do.
+
+static void _process_script(Node *p_node, int p_notification) {
+	Variant time = p_node->get_process_delta_time();
+	const Variant *ptr[1] = { &time };
+	p_node->get_script_instance()->call_multilevel(SceneStringNames::get_singleton()->_process, ptr, 1);
+}
+
+static void _physics_process_script(Node *p_node, int p_notification) {
+	Variant time = p_node->get_physics_process_delta_time();
+	const Variant *ptr[1] = { &time };
+	p_node->get_script_instance()->call_multilevel(SceneStringNames::get_singleton()->_physics_process, ptr, 1);
+}
+
+void SceneTree::_build_process_list(ProcessList &p_list, const Group *p_group, int p_notification) {
+	// Tool scripts can be reloaded in place in the editor, always go through the notification there.
+	bool direct = !Engine::get_singleton()->is_editor_hint();
+
+	p_list.entries.resize(p_group->nodes.size());
+
+	for (uint32_t i = 0; i < p_group->nodes.size(); i++) {
+		const Node *n = p_group->nodes[i];
+		ProcessEntry &entry = p_list.entries[i];
+
+		entry.callback = _process_notify;
+		entry.script_instance = nullptr;
+		entry.process_when_paused = false;
+
+		if (!n) {
+			continue;
 		}
 
-		_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+		entry.script_instance = n->get_script_instance();
+		entry.process_when_paused = n->_can_process_when_paused();
 
-		//copy, so copy on write happens in case something is removed from process while being called
-		//performance is not lost because only if something is added/removed the vector is copied.
-		nodes_copy = g.nodes;
+		if (direct) {
+			if (!entry.script_instance) {
+				entry.callback = nullptr;
+			} else if (!entry.script_instance->has_method(SceneStringNames::get_singleton()->_notification)) {
+				entry.callback = p_notification == Node::NOTIFICATION_PROCESS ? _process_script : _physics_process_script;
+			}
+		}
 	}
 
-	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	p_list.group = p_group;
+	p_list.group_generation = p_group->generation;
+	p_list.version = process_lists_version;
+}
 
-	_THREAD_SAFE_LOCK_
-	call_lock++;
-	_THREAD_SAFE_UNLOCK_
+void SceneTree::_process_group(ProcessList &p_list, const StringName &p_group, int p_notification) {
+	Group *g = _lock_group(p_group, true);
+	if (!g) {
+		return;
+	}
 
-	for (int i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n)) {
+	// Only the nodes already in the group are processed, like with GroupIterator.
+	uint32_t node_count = g->nodes.size();
+
+	if (p_list.group != g || p_list.group_generation != g->generation || p_list.version != process_lists_version || p_list.entries.size() != node_count) {
+		_build_process_list(p_list, g, p_notification);
+	}
+
+	bool paused = is_paused();
+
+	for (uint32_t i = 0; i < node_count; i++) {
+		// Read through the group every time, nodes leaving it meanwhile are set to null.
+		Node *n = g->nodes[i];
+		if (!n) {
 			continue;
 		}
 
-		if (!n->can_process()) {
+		ProcessEntry entry = p_list.entries[i];
+		if (paused && !entry.process_when_paused) {
 			continue;
 		}
 		if (!n->can_process_notification(p_notification)) {
 			continue;
 		}
 
-		n->notification(p_notification);
-		//ERR_FAIL_COND(node_count != g.nodes.size());
-	}
+		if (unlikely(n->get_script_instance() != entry.script_instance)) {
+			// The script changed since the list was built.
+			n->notification(p_notification);
+			p_list.group = nullptr;
+			continue;
+		}
 
-	_THREAD_SAFE_LOCK_
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+		if (entry.callback) {
+			entry.callback(n, p_notification);
+		}
 	}
-	_THREAD_SAFE_UNLOCK_
+
+	_unlock_group(p_group, g);
 }
 
 /*
@@ -1082,37 +1141,9 @@ Variant SceneTree::_call_group(const Variant **p_args, int p_argcount, Variant::
 }
 
 void SceneTree::_call_input_pause(const StringName &p_group, const CallInputType p_call_type, const Ref<InputEvent> &p_input) {
-	Vector<Node *> nodes_copy;
-
-	{
-		_THREAD_SAFE_METHOD_
-
-		RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-		if (!E) {
-			return;
-		}
-		Group &g = E->get();
-		if (g.nodes.empty()) {
-			return;
-		}
-
-		_update_group_order(g);
-
-		//copy, so copy on write happens in case something is removed from process while being called
-		//performance is not lost because only if something is added/removed the vector is copied.
-		nodes_copy = g.nodes;
-	}
-
-	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
-
 	Variant arg = p_input;
 	const Variant *v[1] = { &arg };
 
-	_THREAD_SAFE_LOCK_
-	call_lock++;
-	_THREAD_SAFE_UNLOCK_
-
 	StringName method;
 
 	switch (p_call_type) {
@@ -1130,37 +1161,28 @@ void SceneTree::_call_input_pause(const StringName &p_group, const CallInputType
 			break;
 	}
 
+	GroupIterator it(this, p_group, true);
+
 	if (p_call_type != CALL_INPUT_TYPE_SHORTCUT_INPUT) {
-		for (int i = node_count - 1; i >= 0; i--) {
+		while (Node *n = it.next()) {
 			if (input_handled) {
 				break;
 			}
 
-			Node *n = nodes[i];
-			if (call_lock && call_skip.has(n)) {
-				continue;
-			}
-
 			if (!n->can_process()) {
 				continue;
 			}
 
 			n->call_multilevel(method, (const Variant **)v, 1);
-			//ERR_FAIL_COND(node_count != g.nodes.size());
 		}
 	} else {
 		Vector<Node *> no_context_nodes;
 
-		for (int i = node_count - 1; i >= 0; i--) {
+		while (Node *n = it.next()) {
 			if (input_handled) {
 				break;
 			}
 
-			Node *n = nodes[i];
-			if (call_lock && call_skip.has(n)) {
-				continue;
-			}
-
 			if (!n->can_process()) {
 				continue;
 			}
@@ -1179,7 +1201,6 @@ void SceneTree::_call_input_pause(const StringName &p_group, const CallInputType
 			}
 
 			n->call_multilevel(method, (const Variant **)v, 1);
-			//ERR_FAIL_COND(node_count != g.nodes.size());
 		}
 
 		int ncns = no_context_nodes.size();
@@ -1194,13 +1215,6 @@ void SceneTree::_call_input_pause(const StringName &p_group, const CallInputType
 			n->call_multilevel(method, (const Variant **)v, 1);
 		}
 	}
-
-	_THREAD_SAFE_LOCK_
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
-	}
-	_THREAD_SAFE_UNLOCK_
 }
 
 int64_t SceneTree::get_frame() const {
@@ -1214,22 +1228,24 @@ Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
 	_THREAD_SAFE_METHOD_
 
 	Array ret;
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
 		return ret;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	_update_group_order(*g); //update order just in case
+	int nc = g->get_node_count();
 	if (nc == 0) {
 		return ret;
 	}
 
 	ret.resize(nc);
 
-	Node **ptr = E->get().nodes.ptrw();
-	for (int i = 0; i < nc; i++) {
-		ret[i] = ptr[i];
+	int idx = 0;
+	for (uint32_t i = 0; i < g->nodes.size(); i++) {
+		if (g->nodes[i]) {
+			ret[idx++] = g->nodes[i];
+		}
 	}
 
 	return ret;
@@ -1238,47 +1254,57 @@ Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
 bool SceneTree::has_group(const StringName &p_identifier) const {
 	_THREAD_SAFE_METHOD_
 
-	return group_map.has(p_identifier);
+	const Group *g = group_map.getptr(p_identifier);
+	return g && g->get_node_count() > 0;
 }
-void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_list) {
+void SceneTree::get_nodes_in_group(const StringName &p_group, LocalVector<Node *> *r_nodes) {
 	_THREAD_SAFE_METHOD_
 
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
 		return;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
-	if (nc == 0) {
-		return;
-	}
-	Node **ptr = E->get().nodes.ptrw();
-	for (int i = 0; i < nc; i++) {
-		p_list->push_back(ptr[i]);
+	_update_group_order(*g); //update order just in case
+	r_nodes->reserve(r_nodes->size() + g->get_node_count());
+	for (uint32_t i = 0; i < g->nodes.size(); i++) {
+		if (g->nodes[i]) {
+			r_nodes->push_back(g->nodes[i]);
+		}
 	}
 }
 Node *SceneTree::get_first_node_in_group(const StringName &p_group) {
 	_THREAD_SAFE_METHOD_
 
-	RBMap<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
 		return NULL;
 	}
 
-	_update_group_order(E->get()); //update order just in case
+	_update_group_order(*g); //update order just in case
 
-	int nc = E->get().nodes.size();
-	if (nc == 0) {
-		return NULL;
+	for (uint32_t i = 0; i < g->nodes.size(); i++) {
+		if (g->nodes[i]) {
+			return g->nodes[i];
+		}
 	}
 
-	return E->get().nodes[0];
+	return NULL;
+}
+
+int SceneTree::get_node_count_in_group(const StringName &p_group) const {
+	_THREAD_SAFE_METHOD_
+
+	const Group *g = group_map.getptr(p_group);
+	return g ? g->get_node_count() : 0;
 }
 
 void SceneTree::_flush_delete_queue() {
 	_THREAD_SAFE_METHOD_
 
+	// Recycled nodes leave the tree at the same point queued ones are deleted.
+	scene_pool.flush();
+
 	// Sorting the delete queue by child count (in respect to their parent)
 	// is an optimization because nodes benefit immensely from being deleted
 	// in reverse order to their child count. This is partly due to ordered_remove(), and partly
@@ -1551,6 +1577,38 @@ Ref<SceneTreeTimer> SceneTree::create_timer(float p_delay_sec, bool p_process_pa
 	return stt;
 }
 
+Node *SceneTree::instance_pooled(const Ref<PackedScene> &p_scene) {
+	return scene_pool.instance(p_scene);
+}
+
+void SceneTree::recycle(Node *p_node) {
+	scene_pool.recycle(p_node);
+}
+
+void SceneTree::prewarm_pool(const Ref<PackedScene> &p_scene, int p_count) {
+	scene_pool.prewarm(p_scene, p_count);
+}
+
+int SceneTree::get_pooled_count(const Ref<PackedScene> &p_scene) const {
+	return scene_pool.get_pooled_count(p_scene);
+}
+
+void SceneTree::clear_pool(const Ref<PackedScene> &p_scene) {
+	if (p_scene.is_null()) {
+		scene_pool.clear_all();
+	} else {
+		scene_pool.clear(p_scene);
+	}
+}
+
+void SceneTree::set_pool_max_size(int p_size) {
+	scene_pool.set_max_size(p_size);
+}
+
+int SceneTree::get_pool_max_size() const {
+	return scene_pool.get_max_size();
+}
+
 Ref<SceneTreeTween> SceneTree::create_tween() {
 	_THREAD_SAFE_METHOD_
 
@@ -1700,6 +1758,14 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_tween"), &SceneTree::create_tween);
 	ClassDB::bind_method(D_METHOD("get_processed_tweens"), &SceneTree::get_processed_tweens);
 
+	ClassDB::bind_method(D_METHOD("instance_pooled", "scene"), &SceneTree::instance_pooled);
+	ClassDB::bind_method(D_METHOD("recycle", "node"), &SceneTree::recycle);
+	ClassDB::bind_method(D_METHOD("prewarm_pool", "scene", "count"), &SceneTree::prewarm_pool);
+	ClassDB::bind_method(D_METHOD("get_pooled_count", "scene"), &SceneTree::get_pooled_count);
+	ClassDB::bind_method(D_METHOD("clear_pool", "scene"), &SceneTree::clear_pool, DEFVAL(Ref<PackedScene>()));
+	ClassDB::bind_method(D_METHOD("set_pool_max_size", "size"), &SceneTree::set_pool_max_size);
+	ClassDB::bind_method(D_METHOD("get_pool_max_size"), &SceneTree::get_pool_max_size);
+
 	ClassDB::bind_method(D_METHOD("get_node_count"), &SceneTree::get_node_count);
 	ClassDB::bind_method(D_METHOD("get_frame"), &SceneTree::get_frame);
 	ClassDB::bind_method(D_METHOD("quit", "exit_code"), &SceneTree::quit, DEFVAL(-1));
@@ -1731,6 +1797,7 @@ void SceneTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_nodes_in_group", "group"), &SceneTree::_get_nodes_in_group);
 	ClassDB::bind_method(D_METHOD("get_first_node_in_group", "group"), &SceneTree::get_first_node_in_group);
+	ClassDB::bind_method(D_METHOD("get_node_count_in_group", "group"), &SceneTree::get_node_count_in_group);
 
 	ClassDB::bind_method(D_METHOD("set_current_scene", "child_node"), &SceneTree::set_current_scene);
 	ClassDB::bind_method(D_METHOD("get_current_scene"), &SceneTree::get_current_scene);
@@ -1741,6 +1808,7 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reload_current_scene"), &SceneTree::reload_current_scene);
 
 	ClassDB::bind_method(D_METHOD("_change_scene"), &SceneTree::_change_scene);
+	ClassDB::bind_method(D_METHOD("_flush_container_sorts"), &SceneTree::_flush_container_sorts);
 
 	ClassDB::bind_method(D_METHOD("set_multiplayer", "multiplayer"), &SceneTree::set_multiplayer);
 	ClassDB::bind_method(D_METHOD("get_multiplayer"), &SceneTree::get_multiplayer);
@@ -1776,6 +1844,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", 0), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "set_multiplayer", "get_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "pool_max_size", PROPERTY_HINT_RANGE, "0,65536,1"), "set_pool_max_size", "get_pool_max_size");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
 	ADD_SIGNAL(MethodInfo("node_added", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
@@ -1900,6 +1969,12 @@ SceneTree::SceneTree() {
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
 	tree_version = 1;
+	process_lists_version = 1;
+	container_sort_queued = false;
+	layout_passes = 0;
+	layout_passes_in_frame = 0;
+	resize_notifications = 0;
+	resize_notifications_in_frame = 0;
 	physics_process_time = 0.f;
 	idle_process_time = 0.f;
 
@@ -1913,7 +1988,6 @@ SceneTree::SceneTree() {
 	node_removed_name = "node_removed";
 	node_renamed_name = "node_renamed";
 	ugc_locked = false;
-	call_lock = 0;
 	root_lock = 0;
 	node_count = 0;
 
@@ -4,11 +4,15 @@
 /*  scene_tree.h                                                         */
 
 
+#include "core/containers/hash_map.h"
+#include "core/containers/local_vector.h"
 #include "core/containers/self_list.h"
 #include "core/io/multiplayer_api.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "scene/main/scene_pool.h"
 
+class Container;
 class PackedScene;
 class Node;
 class SceneTreeTween;
@@ -69,15 +73,38 @@ public:
 
 private:
 	struct Group {
-		Vector<Node *> nodes;
-		//uint64_t last_tree_version;
-		bool changed;
-		Group() { changed = false; };
+		LocalVector<Node *> nodes;
+		uint32_t removed = 0; // Slots set to null because the node left the group while it was being iterated.
+		uint32_t lock = 0; // Iterations in progress, the node list can only be appended to meanwhile.
+		uint64_t generation = 0; // Changes every time the node list is reordered or compacted.
+		bool changed = false;
+
+		_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size() - removed; }
+	};
+
+	typedef void (*ProcessCallback)(Node *p_node, int p_notification);
+
+	struct ProcessEntry {
+		ProcessCallback callback; // Null when there is nothing to call.
+		ScriptInstance *script_instance; // The one the callback was picked for.
+		bool process_when_paused;
+	};
+
+	// What to call for each node of a processing group, so processing doesn't go through
+	// Node::notification() and Node::can_process() for every node.
+	struct ProcessList {
+		LocalVector<ProcessEntry> entries; // Same indices as the group nodes.
+		const Group *group = nullptr;
+		uint64_t group_generation = 0;
+		uint64_t version = 0;
 	};
 
 	Viewport *root;
 
 	uint64_t tree_version;
+	uint64_t process_lists_version; // Invalidates the process lists, e.g. when pause modes change.
+	ProcessList idle_process_list;
+	ProcessList physics_process_list;
 	float physics_process_time;
 	float idle_process_time;
 	bool accept_quit;
@@ -91,7 +118,7 @@ private:
 	bool pause;
 	int root_lock;
 
-	RBMap<StringName, Group> group_map;
+	HashMap<StringName, Group> group_map;
 	bool _quit;
 	bool initialized;
 	bool input_handled;
@@ -113,10 +140,6 @@ private:
 		bool operator<(const UGCall &p_with) const { return group == p_with.group ? call < p_with.call : group < p_with.group; }
 	};
 
-	//safety for when a node is deleted while a group is being called
-	int call_lock;
-	RBSet<Node *> call_skip; //skip erased nodes
-
 	StretchMode stretch_mode;
 	StretchAspect stretch_aspect;
 	Size2i stretch_min;
@@ -131,11 +154,15 @@ private:
 	};
 	LocalVector<DeleteQueueElement> delete_queue;
 
+	ScenePool scene_pool;
+
 	RBMap<UGCall, Vector<Variant>> unique_group_calls;
 	bool ugc_locked;
 	void _flush_ugc();
 
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
+	Group *_lock_group(const StringName &p_group, bool p_use_priority = false);
+	void _unlock_group(const StringName &p_group, Group *p_group_data);
 
 	Array _get_nodes_in_group(const StringName &p_group);
 
@@ -182,6 +209,8 @@ private:
 	void make_group_changed(const StringName &p_group);
 
 	void _notify_group_pause(const StringName &p_group, int p_notification);
+	void _build_process_list(ProcessList &p_list, const Group *p_group, int p_notification);
+	void _process_group(ProcessList &p_list, const StringName &p_group, int p_notification);
 	Variant _call_group_flags(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _call_group(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 
@@ -201,6 +230,28 @@ private:
 
 	SelfList<Node>::List xform_change_list;
 
+	//containers waiting for NOTIFICATION_SORT_CHILDREN, resolved in one batch with parents before children
+	friend class Container;
+	friend class Control;
+
+	struct ContainerSort {
+		int depth;
+		ObjectID id;
+		bool operator<(const ContainerSort &p_other) const { return depth < p_other.depth; }
+	};
+
+	SelfList<Container>::List container_sort_list;
+	LocalVector<ContainerSort> container_sort_batch;
+	bool container_sort_queued;
+
+	uint32_t layout_passes;
+	uint32_t layout_passes_in_frame;
+	uint32_t resize_notifications;
+	uint32_t resize_notifications_in_frame;
+
+	void _queue_container_sort(SelfList<Container> *p_item);
+	void _flush_container_sorts();
+
 	Ref<ShortCut> debugger_stop_shortcut;
 
 	enum {
@@ -228,6 +279,27 @@ public:
 		GROUP_CALL_MULTILEVEL = 8,
 	};
 
+	// Walks the nodes of a group in place, without copying the node list.
+	// The group may change while it's walked: nodes that leave it are skipped and nodes that join it aren't visited.
+	class GroupIterator {
+		SceneTree *tree;
+		StringName group_name;
+		Group *group;
+		uint64_t generation;
+		int index;
+		int end;
+		int step;
+
+		GroupIterator(const GroupIterator &);
+		GroupIterator &operator=(const GroupIterator &);
+
+	public:
+		Node *next();
+
+		GroupIterator(SceneTree *p_tree, const StringName &p_group, bool p_reverse = false, bool p_use_priority = false);
+		~GroupIterator();
+	};
+
 	_FORCE_INLINE_ Viewport *get_root() const {
 		return root;
 	}
@@ -323,10 +395,14 @@ public:
 
 	int get_node_count() const;
 
+	uint32_t get_layout_passes_in_frame() const { return layout_passes_in_frame; }
+	uint32_t get_resize_notifications_in_frame() const { return resize_notifications_in_frame; }
+
 	void queue_delete(Object *p_object);
 
-	void get_nodes_in_group(const StringName &p_group, List<Node *> *p_list);
+	void get_nodes_in_group(const StringName &p_group, LocalVector<Node *> *r_nodes);
 	Node *get_first_node_in_group(const StringName &p_group);
+	int get_node_count_in_group(const StringName &p_group) const;
 	bool has_group(const StringName &p_identifier) const;
 
 	void set_screen_stretch(StretchMode p_mode, StretchAspect p_aspect, const Size2 &p_minsize, real_t p_scale = 1.0);
@@ -343,6 +419,16 @@ public:
 	Error change_scene_to(const Ref<PackedScene> &p_scene);
 	Error reload_current_scene();
 
+	Node *instance_pooled(const Ref<PackedScene> &p_scene);
+	void recycle(Node *p_node);
+	void prewarm_pool(const Ref<PackedScene> &p_scene, int p_count);
+	int get_pooled_count(const Ref<PackedScene> &p_scene) const;
+	void clear_pool(const Ref<PackedScene> &p_scene);
+	void set_pool_max_size(int p_size);
+	int get_pool_max_size() const;
+	uint64_t get_pool_hits() const { return scene_pool.get_hits(); }
+	uint64_t get_pool_misses() const { return scene_pool.get_misses(); }
+
 	Ref<SceneTreeTimer> create_timer(float p_delay_sec, bool p_process_pause = true);
 	Ref<SceneTreeTween> create_tween();
 	Array get_processed_tweens();
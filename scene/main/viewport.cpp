@@ -758,12 +758,10 @@ Transform2D Viewport::get_final_transform() const {
 }
 
 void Viewport::assign_next_enabled_camera_2d(const StringName &p_camera_group) {
-	List<Node *> camera_list;
-	get_tree()->get_nodes_in_group(p_camera_group, &camera_list);
-
 	Camera2D *new_camera = nullptr;
-	for (List<Node *>::Element *E = camera_list.front(); E; E = E->next()) {
-		Camera2D *cam = Object::cast_to<Camera2D>(E->get());
+	SceneTree::GroupIterator it(get_tree(), p_camera_group);
+	while (Node *node = it.next()) {
+		Camera2D *cam = Object::cast_to<Camera2D>(node);
 		if (cam->is_enabled()) {
 			new_camera = cam;
 			break;
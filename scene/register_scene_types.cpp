@@ -285,6 +285,7 @@ void register_scene_types() {
 	/* REGISTER 3D */
 
 	ClassDB::register_class<AnimationPlayer>();
+	AnimationPlayer::init_thread_pool();
 	ClassDB::register_class<Tween>();
 	ClassDB::register_class<SceneTreeTween>();
 	ClassDB::register_virtual_class<Tweener>();
@@ -312,6 +313,7 @@ void register_scene_types() {
 	CanvasItemMaterial::init_shaders();
 	ClassDB::register_class<Node2D>();
 	ClassDB::register_class<CPUParticles2D>();
+	CPUParticles2D::init_thread_pool();
 	//ClassDB::register_class<ParticleAttractor2D>();
 	ClassDB::register_class<Sprite>();
 	//ClassDB::register_type<ViewportSprite>();
@@ -514,5 +516,7 @@ void unregister_scene_types() {
 	resource_loader_bmfont.unref();
 
 	CanvasItemMaterial::finish_shaders();
+	CPUParticles2D::finish_thread_pool();
+	AnimationPlayer::finish_thread_pool();
 	SceneStringNames::free();
 }
@@ -6,6 +6,16 @@
 
 #include "core/core_string_names.h"
 
+#if !defined(REAL_T_IS_DOUBLE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CURVE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CURVE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 template <class T>
 static _FORCE_INLINE_ T _bezier_interp_curve(real_t t, T start, T control_1, T control_2, T end) {
 	/* Formula from Wikipedia article on Bezier curves. */
@@ -22,7 +32,7 @@ const char *Curve::SIGNAL_RANGE_CHANGED = "range_changed";
 
 Curve::Curve() {
 	_bake_resolution = 100;
-	_baked_cache_dirty = false;
+	_baked_cache_dirty = true;
 	_min_value = 0;
 	_max_value = 1;
 	_minmax_set_once = 0b00;
@@ -399,20 +409,22 @@ void Curve::set_data(Array input) {
 }
 
 void Curve::bake() {
-	_baked_cache.clear();
-
-	_baked_cache.resize(_bake_resolution);
+	_baked_cache.resize(_bake_resolution + 1);
+	real_t *w = _baked_cache.ptr();
 
 	for (int i = 1; i < _bake_resolution - 1; ++i) {
 		real_t x = i / static_cast<real_t>(_bake_resolution);
-		real_t y = interpolate(x);
-		_baked_cache.write[i] = y;
+		w[i] = interpolate(x);
 	}
 
 	if (_points.size() != 0) {
-		_baked_cache.write[0] = _points[0].pos.y;
-		_baked_cache.write[_baked_cache.size() - 1] = _points[_points.size() - 1].pos.y;
+		w[0] = _points[0].pos.y;
+		w[_bake_resolution - 1] = _points[_points.size() - 1].pos.y;
+	} else {
+		w[0] = 0;
+		w[_bake_resolution - 1] = 0;
 	}
+	w[_bake_resolution] = w[_bake_resolution - 1];
 
 	_baked_cache_dirty = false;
 }
@@ -430,34 +442,82 @@ real_t Curve::interpolate_baked(real_t offset) {
 		bake();
 	}
 
-	// Special cases if the cache is too small
-	if (_baked_cache.size() == 0) {
-		if (_points.size() == 0) {
-			return 0;
-		}
-		return _points[0].pos.y;
-	} else if (_baked_cache.size() == 1) {
-		return _baked_cache[0];
+	// Get interpolation index, offsets outside of the curve (and NaN) are clamped to the first or last sample.
+	real_t last = _bake_resolution - 1;
+	real_t fi = offset * _bake_resolution;
+	if (!(fi > 0)) {
+		fi = 0;
+	} else if (fi > last) {
+		fi = last;
 	}
+	int i = int(fi);
 
-	// Get interpolation index
-	real_t fi = offset * _baked_cache.size();
-	int i = Math::floor(fi);
-	if (i < 0) {
-		i = 0;
-		fi = 0;
-	} else if (i >= _baked_cache.size()) {
-		i = _baked_cache.size() - 1;
-		fi = 0;
+	return Math::lerp(_baked_cache[i], _baked_cache[i + 1], fi - i);
+}
+
+void Curve::interpolate_baked_array(const real_t *p_offsets, real_t *r_values, int p_count) {
+	if (_baked_cache_dirty) {
+		bake();
 	}
 
-	// Interpolate
-	if (i + 1 < _baked_cache.size()) {
-		real_t t = fi - i;
-		return Math::lerp(_baked_cache[i], _baked_cache[i + 1], t);
-	} else {
-		return _baked_cache[_baked_cache.size() - 1];
+	const real_t *cache = _baked_cache.ptr();
+	int i = 0;
+
+#if defined(CURVE_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 last = _mm_set1_ps(_bake_resolution - 1);
+	const __m128 resolution = _mm_set1_ps(_bake_resolution);
+	int32_t idx[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		// max() returns its second operand for NaN, so those end up at the first sample.
+		__m128 fi = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(p_offsets + i), resolution), zero), last);
+		__m128i fi_int = _mm_cvttps_epi32(fi);
+		__m128 t = _mm_sub_ps(fi, _mm_cvtepi32_ps(fi_int));
+		_mm_storeu_si128((__m128i *)idx, fi_int);
+
+		__m128 a = _mm_setr_ps(cache[idx[0]], cache[idx[1]], cache[idx[2]], cache[idx[3]]);
+		__m128 b = _mm_setr_ps(cache[idx[0] + 1], cache[idx[1] + 1], cache[idx[2] + 1], cache[idx[3] + 1]);
+		_mm_storeu_ps(r_values + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
 	}
+#elif defined(CURVE_NEON)
+	const float32x4_t zero = vdupq_n_f32(0);
+	const float32x4_t last = vdupq_n_f32(_bake_resolution - 1);
+	int32_t idx[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4_t fi = vmulq_n_f32(vld1q_f32(p_offsets + i), _bake_resolution);
+		fi = vbslq_f32(vceqq_f32(fi, fi), fi, zero); // NaN to 0.
+		fi = vminq_f32(vmaxq_f32(fi, zero), last);
+		int32x4_t fi_int = vcvtq_s32_f32(fi);
+		float32x4_t t = vsubq_f32(fi, vcvtq_f32_s32(fi_int));
+		vst1q_s32(idx, fi_int);
+
+		float a_arr[4] = { cache[idx[0]], cache[idx[1]], cache[idx[2]], cache[idx[3]] };
+		float b_arr[4] = { cache[idx[0] + 1], cache[idx[1] + 1], cache[idx[2] + 1], cache[idx[3] + 1] };
+		float32x4_t a = vld1q_f32(a_arr);
+		vst1q_f32(r_values + i, vmlaq_f32(a, vsubq_f32(vld1q_f32(b_arr), a), t));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_values[i] = interpolate_baked(p_offsets[i]);
+	}
+}
+
+PoolRealArray Curve::sample_array(const PoolRealArray &p_offsets) {
+	PoolRealArray values;
+	int count = p_offsets.size();
+	if (count == 0) {
+		return values;
+	}
+
+	values.resize(count);
+	PoolRealArray::Read r = p_offsets.read();
+	PoolRealArray::Write w = values.write();
+	interpolate_baked_array(r.ptr(), w.ptr(), count);
+
+	return values;
 }
 
 void Curve::ensure_default_setup(float p_min, float p_max) {
@@ -479,6 +539,7 @@ void Curve::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_point_offset", "index", "offset"), &Curve::set_point_offset);
 	ClassDB::bind_method(D_METHOD("interpolate", "offset"), &Curve::interpolate);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset"), &Curve::interpolate_baked);
+	ClassDB::bind_method(D_METHOD("sample_array", "offsets"), &Curve::sample_array);
 	ClassDB::bind_method(D_METHOD("get_point_left_tangent", "index"), &Curve::get_point_left_tangent);
 	ClassDB::bind_method(D_METHOD("get_point_right_tangent", "index"), &Curve::get_point_right_tangent);
 	ClassDB::bind_method(D_METHOD("get_point_left_mode", "index"), &Curve::get_point_left_mode);
@@ -718,6 +779,30 @@ float Curve2D::get_baked_length() const {
 
 	return baked_max_ofs;
 }
+// Samples the baked points at p_offset, which must be within [0, baked length[.
+static _FORCE_INLINE_ Vector2 _interpolate_baked_points(const Vector2 *r, int bpc, float p_offset, float p_bake_interval, float p_baked_max_ofs, bool p_cubic) {
+	int idx = Math::floor((double)p_offset / (double)p_bake_interval);
+	float frac = Math::fmod(p_offset, p_bake_interval);
+
+	if (idx >= bpc - 1) {
+		return r[bpc - 1];
+	} else if (idx == bpc - 2) {
+		if (frac > 0) {
+			frac /= Math::fmod(p_baked_max_ofs, p_bake_interval);
+		}
+	} else {
+		frac /= p_bake_interval;
+	}
+
+	if (p_cubic) {
+		Vector2 pre = idx > 0 ? r[idx - 1] : r[idx];
+		Vector2 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
+		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
+	} else {
+		return r[idx].linear_interpolate(r[idx + 1], frac);
+	}
+}
+
 Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 	if (baked_cache_dirty) {
 		_bake();
@@ -741,26 +826,44 @@ Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 		return r[bpc - 1];
 	}
 
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, (float)bake_interval);
+	return _interpolate_baked_points(r.ptr(), bpc, p_offset, bake_interval, baked_max_ofs, p_cubic);
+}
 
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		if (frac > 0) {
-			frac /= Math::fmod(baked_max_ofs, bake_interval);
-		}
-	} else {
-		frac /= bake_interval;
+PoolVector2Array Curve2D::sample_array(const PoolRealArray &p_offsets, bool p_cubic) const {
+	if (baked_cache_dirty) {
+		_bake();
 	}
 
-	if (p_cubic) {
-		Vector2 pre = idx > 0 ? r[idx - 1] : r[idx];
-		Vector2 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
-		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
-	} else {
-		return r[idx].linear_interpolate(r[idx + 1], frac);
+	PoolVector2Array ret;
+	int count = p_offsets.size();
+
+	//validate//
+	int bpc = baked_point_cache.size();
+	ERR_FAIL_COND_V_MSG(bpc == 0, ret, "No points in Curve2D.");
+
+	if (count == 0) {
+		return ret;
 	}
+
+	ret.resize(count);
+	PoolRealArray::Read offsets = p_offsets.read();
+	PoolVector2Array::Write w = ret.write();
+	PoolVector2Array::Read r = baked_point_cache.read();
+
+	// Bake state, bounds and the point array are resolved once for the whole batch.
+	for (int i = 0; i < count; i++) {
+		float offset = offsets[i];
+
+		if (bpc == 1 || !(offset > 0)) {
+			w[i] = r[0];
+		} else if (offset >= baked_max_ofs) {
+			w[i] = r[bpc - 1];
+		} else {
+			w[i] = _interpolate_baked_points(r.ptr(), bpc, offset, bake_interval, baked_max_ofs, p_cubic);
+		}
+	}
+
+	return ret;
 }
 
 PoolVector2Array Curve2D::get_baked_points() const {
@@ -953,6 +1056,7 @@ void Curve2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_baked_length"), &Curve2D::get_baked_length);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset", "cubic"), &Curve2D::interpolate_baked, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("sample_array", "offsets", "cubic"), &Curve2D::sample_array, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_baked_points"), &Curve2D::get_baked_points);
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Curve2D::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_offset", "to_point"), &Curve2D::get_closest_offset);
@@ -4,6 +4,7 @@
 /*  curve.h                                                              */
 
 
+#include "core/containers/local_vector.h"
 #include "core/object/resource.h"
 
 // y(x) curve
@@ -100,6 +101,8 @@ public:
 	int get_bake_resolution() const { return _bake_resolution; }
 	void set_bake_resolution(int p_resolution);
 	real_t interpolate_baked(real_t offset);
+	void interpolate_baked_array(const real_t *p_offsets, real_t *r_values, int p_count);
+	PoolRealArray sample_array(const PoolRealArray &p_offsets);
 
 	void ensure_default_setup(float p_min, float p_max);
 
@@ -111,7 +114,9 @@ private:
 
 	Vector<Point> _points;
 	bool _baked_cache_dirty;
-	Vector<real_t> _baked_cache;
+	// _bake_resolution uniformly spaced samples, followed by a copy of the last one,
+	// so interpolation never has to check whether the next sample exists.
+	LocalVector<real_t> _baked_cache;
 	int _bake_resolution;
 	float _min_value;
 	float _max_value;
@@ -171,6 +176,7 @@ public:
 
 	float get_baked_length() const;
 	Vector2 interpolate_baked(float p_offset, bool p_cubic = false) const;
+	PoolVector2Array sample_array(const PoolRealArray &p_offsets, bool p_cubic = false) const;
 	PoolVector2Array get_baked_points() const; //useful for going through
 	Vector2 get_closest_point(const Vector2 &p_to_point) const;
 	float get_closest_offset(const Vector2 &p_to_point) const;
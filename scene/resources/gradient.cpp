@@ -6,6 +6,14 @@
 
 #include "core/core_string_names.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRADIENT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GRADIENT_NEON
+#include <arm_neon.h>
+#endif
+
 //setter and getter names for property serialization
 #define COLOR_RAMP_GET_OFFSETS "get_offsets"
 #define COLOR_RAMP_GET_COLORS "get_colors"
@@ -20,6 +28,7 @@ Gradient::Gradient() {
 	points.write[1].color = Color(1, 1, 1, 1);
 	points.write[1].offset = 1;
 	is_sorted = true;
+	baked_dirty = true;
 }
 
 Gradient::~Gradient() {
@@ -36,6 +45,8 @@ void Gradient::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_color", "point"), &Gradient::get_color);
 
 	ClassDB::bind_method(D_METHOD("interpolate", "offset"), &Gradient::get_color_at_offset);
+	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset"), &Gradient::interpolate_baked);
+	ClassDB::bind_method(D_METHOD("sample_array", "offsets"), &Gradient::sample_array);
 
 	ClassDB::bind_method(D_METHOD("get_point_count"), &Gradient::get_points_count);
 
@@ -79,7 +90,7 @@ Vector<Color> Gradient::get_colors() const {
 
 void Gradient::set_interpolation_mode(Gradient::InterpolationMode p_interp_mode) {
 	interpolation_mode = p_interp_mode;
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 Gradient::InterpolationMode Gradient::get_interpolation_mode() {
@@ -92,7 +103,7 @@ void Gradient::set_offsets(const Vector<float> &p_offsets) {
 		points.write[i].offset = p_offsets[i];
 	}
 	is_sorted = false;
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 void Gradient::set_colors(const Vector<Color> &p_colors) {
@@ -103,10 +114,12 @@ void Gradient::set_colors(const Vector<Color> &p_colors) {
 	for (int i = 0; i < points.size(); i++) {
 		points.write[i].color = p_colors[i];
 	}
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 Vector<Gradient::Point> &Gradient::get_points() {
+	// The caller may modify the points.
+	baked_dirty = true;
 	return points;
 }
 
@@ -117,20 +130,20 @@ void Gradient::add_point(float p_offset, const Color &p_color) {
 	is_sorted = false;
 	points.push_back(p);
 
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 void Gradient::remove_point(int p_index) {
 	ERR_FAIL_INDEX(p_index, points.size());
 	ERR_FAIL_COND(points.size() <= 1);
 	points.remove(p_index);
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 void Gradient::set_points(Vector<Gradient::Point> &p_points) {
 	points = p_points;
 	is_sorted = false;
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 void Gradient::set_offset(int pos, const float offset) {
@@ -138,7 +151,7 @@ void Gradient::set_offset(int pos, const float offset) {
 	_update_sorting();
 	points.write[pos].offset = offset;
 	is_sorted = false;
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 float Gradient::get_offset(int pos) {
@@ -151,7 +164,7 @@ void Gradient::set_color(int pos, const Color &color) {
 	ERR_FAIL_INDEX(pos, points.size());
 	_update_sorting();
 	points.write[pos].color = color;
-	emit_signal(CoreStringNames::get_singleton()->changed);
+	_points_changed();
 }
 
 Color Gradient::get_color(int pos) {
@@ -160,6 +173,108 @@ Color Gradient::get_color(int pos) {
 	return points[pos].color;
 }
 
+void Gradient::_points_changed() {
+	baked_dirty = true;
+	emit_signal(CoreStringNames::get_singleton()->changed);
+}
+
+void Gradient::_bake() {
+	baked_colors.resize(BAKE_RESOLUTION + 2);
+	Color *w = baked_colors.ptr();
+
+	for (int i = 0; i <= BAKE_RESOLUTION; i++) {
+		w[i] = get_color_at_offset(float(i) / BAKE_RESOLUTION);
+	}
+	w[BAKE_RESOLUTION + 1] = w[BAKE_RESOLUTION];
+
+	baked_dirty = false;
+}
+
+void Gradient::interpolate_baked_array(const float *p_offsets, Color *r_colors, int p_count) {
+	if (baked_dirty) {
+		_bake();
+	}
+
+	if (interpolation_mode == GRADIENT_INTERPOLATE_CONSTANT) {
+		for (int i = 0; i < p_count; i++) {
+			r_colors[i] = interpolate_baked(p_offsets[i]);
+		}
+		return;
+	}
+
+	const Color *baked = baked_colors.ptr();
+	int i = 0;
+
+	// A Color is four floats, so a whole color is interpolated per register.
+#if defined(GRADIENT_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 resolution = _mm_set1_ps(BAKE_RESOLUTION);
+	int32_t idx[4];
+	float t[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		// max() returns its second operand for NaN, so those end up at offset 0.
+		__m128 x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p_offsets + i), zero), one), resolution);
+		__m128i x_int = _mm_cvttps_epi32(x);
+		_mm_storeu_ps(t, _mm_sub_ps(x, _mm_cvtepi32_ps(x_int)));
+		_mm_storeu_si128((__m128i *)idx, x_int);
+
+		for (int j = 0; j < 4; j++) {
+			__m128 a = _mm_loadu_ps(&baked[idx[j]].r);
+			__m128 b = _mm_loadu_ps(&baked[idx[j] + 1].r);
+			_mm_storeu_ps(&r_colors[i + j].r, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t[j]))));
+		}
+	}
+#elif defined(GRADIENT_NEON)
+	const float32x4_t zero = vdupq_n_f32(0);
+	const float32x4_t one = vdupq_n_f32(1);
+	int32_t idx[4];
+	float t[4];
+
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4_t offset = vld1q_f32(p_offsets + i);
+		offset = vbslq_f32(vceqq_f32(offset, offset), offset, zero); // NaN to 0.
+		float32x4_t x = vmulq_n_f32(vminq_f32(vmaxq_f32(offset, zero), one), BAKE_RESOLUTION);
+		int32x4_t x_int = vcvtq_s32_f32(x);
+		vst1q_f32(t, vsubq_f32(x, vcvtq_f32_s32(x_int)));
+		vst1q_s32(idx, x_int);
+
+		for (int j = 0; j < 4; j++) {
+			float32x4_t a = vld1q_f32(&baked[idx[j]].r);
+			float32x4_t b = vld1q_f32(&baked[idx[j] + 1].r);
+			vst1q_f32(&r_colors[i + j].r, vmlaq_n_f32(a, vsubq_f32(b, a), t[j]));
+		}
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_colors[i] = interpolate_baked(p_offsets[i]);
+	}
+}
+
+PoolColorArray Gradient::sample_array(const PoolRealArray &p_offsets) {
+	PoolColorArray colors;
+	int count = p_offsets.size();
+	if (count == 0) {
+		return colors;
+	}
+
+	colors.resize(count);
+	PoolRealArray::Read r = p_offsets.read();
+	PoolColorArray::Write w = colors.write();
+
+#if defined(REAL_T_IS_DOUBLE)
+	for (int i = 0; i < count; i++) {
+		w[i] = interpolate_baked(r[i]);
+	}
+#else
+	interpolate_baked_array(r.ptr(), w.ptr(), count);
+#endif
+
+	return colors;
+}
+
 int Gradient::get_points_count() const {
 	return points.size();
 }
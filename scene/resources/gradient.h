@@ -4,6 +4,7 @@
 /*  gradient.h                                                           */
 
 
+#include "core/containers/local_vector.h"
 #include "core/object/resource.h"
 
 class Gradient : public Resource {
@@ -26,10 +27,21 @@ public:
 	};
 
 private:
+	enum {
+		BAKE_RESOLUTION = 256,
+	};
+
 	Vector<Point> points;
 	bool is_sorted;
 	InterpolationMode interpolation_mode = GRADIENT_INTERPOLATE_LINEAR;
 
+	// BAKE_RESOLUTION + 1 colors sampled uniformly over offsets 0 to 1, followed by a copy of the last one.
+	LocalVector<Color> baked_colors;
+	bool baked_dirty;
+
+	void _bake();
+	void _points_changed();
+
 	_FORCE_INLINE_ void _update_sorting() {
 		if (!is_sorted) {
 			points.sort();
@@ -147,6 +159,25 @@ public:
 		}
 	}
 
+	// Approximations of get_color_at_offset() read from a lookup table which is rebuilt when the gradient changes.
+	_FORCE_INLINE_ Color interpolate_baked(float p_offset) {
+		if (baked_dirty) {
+			_bake();
+		}
+
+		float x = p_offset > 0 ? (p_offset < 1 ? p_offset : 1) : 0; // Also catches NaN.
+		x *= BAKE_RESOLUTION;
+		int i = int(x);
+
+		if (interpolation_mode == GRADIENT_INTERPOLATE_CONSTANT) {
+			return baked_colors[i];
+		}
+		return baked_colors[i].linear_interpolate(baked_colors[i + 1], x - i);
+	}
+
+	void interpolate_baked_array(const float *p_offsets, Color *r_colors, int p_count);
+	PoolColorArray sample_array(const PoolRealArray &p_offsets);
+
 	int get_points_count() const;
 };
 
@@ -0,0 +1,147 @@
+
+/*  audio_mix.cpp                                                        */
+
+
+#include "audio_mix.h"
+
+void AudioMix::accumulate(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames) {
+	int i = 0;
+
+#if defined(AUDIO_MIX_SSE2)
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 src = _mm_loadu_ps((const float *)(p_src + i));
+		__m128 dst = _mm_loadu_ps((const float *)(p_dst + i));
+		_mm_storeu_ps((float *)(p_dst + i), _mm_add_ps(dst, src));
+	}
+#elif defined(AUDIO_MIX_NEON)
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t src = vld1q_f32((const float *)(p_src + i));
+		float32x4_t dst = vld1q_f32((const float *)(p_dst + i));
+		vst1q_f32((float *)(p_dst + i), vaddq_f32(dst, src));
+	}
+#endif
+
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void AudioMix::accumulate_ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol, const AudioFrame &p_vol_inc, int p_frames) {
+	AudioFrame vol = p_vol;
+	int i = 0;
+
+#if defined(AUDIO_MIX_SSE2)
+	__m128 vol4 = _mm_setr_ps(vol.l, vol.r, vol.l + p_vol_inc.l, vol.r + p_vol_inc.r);
+	__m128 inc4 = _mm_setr_ps(p_vol_inc.l * 2, p_vol_inc.r * 2, p_vol_inc.l * 2, p_vol_inc.r * 2);
+
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 src = _mm_loadu_ps((const float *)(p_src + i));
+		__m128 dst = _mm_loadu_ps((const float *)(p_dst + i));
+		_mm_storeu_ps((float *)(p_dst + i), _mm_add_ps(dst, _mm_mul_ps(src, vol4)));
+		vol4 = _mm_add_ps(vol4, inc4);
+	}
+
+	_mm_storel_pi((__m64 *)&vol, vol4);
+#elif defined(AUDIO_MIX_NEON)
+	AudioFrame vol_next = vol + p_vol_inc;
+	AudioFrame inc2 = p_vol_inc * 2;
+	float32x4_t vol4 = vcombine_f32(vld1_f32((const float *)&vol), vld1_f32((const float *)&vol_next));
+	float32x4_t inc4 = vcombine_f32(vld1_f32((const float *)&inc2), vld1_f32((const float *)&inc2));
+
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t src = vld1q_f32((const float *)(p_src + i));
+		float32x4_t dst = vld1q_f32((const float *)(p_dst + i));
+		vst1q_f32((float *)(p_dst + i), vmlaq_f32(dst, src, vol4));
+		vol4 = vaddq_f32(vol4, inc4);
+	}
+
+	vst1_f32((float *)&vol, vget_low_f32(vol4));
+#endif
+
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * vol;
+		vol += p_vol_inc;
+	}
+}
+
+void AudioMix::scale_ramp(AudioFrame *p_buffer, const AudioFrame &p_vol, const AudioFrame &p_vol_inc, int p_frames) {
+	AudioFrame vol = p_vol;
+	int i = 0;
+
+#if defined(AUDIO_MIX_SSE2)
+	__m128 vol4 = _mm_setr_ps(vol.l, vol.r, vol.l + p_vol_inc.l, vol.r + p_vol_inc.r);
+	__m128 inc4 = _mm_setr_ps(p_vol_inc.l * 2, p_vol_inc.r * 2, p_vol_inc.l * 2, p_vol_inc.r * 2);
+
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 buf = _mm_loadu_ps((const float *)(p_buffer + i));
+		_mm_storeu_ps((float *)(p_buffer + i), _mm_mul_ps(buf, vol4));
+		vol4 = _mm_add_ps(vol4, inc4);
+	}
+
+	_mm_storel_pi((__m64 *)&vol, vol4);
+#elif defined(AUDIO_MIX_NEON)
+	AudioFrame vol_next = vol + p_vol_inc;
+	AudioFrame inc2 = p_vol_inc * 2;
+	float32x4_t vol4 = vcombine_f32(vld1_f32((const float *)&vol), vld1_f32((const float *)&vol_next));
+	float32x4_t inc4 = vcombine_f32(vld1_f32((const float *)&inc2), vld1_f32((const float *)&inc2));
+
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t buf = vld1q_f32((const float *)(p_buffer + i));
+		vst1q_f32((float *)(p_buffer + i), vmulq_f32(buf, vol4));
+		vol4 = vaddq_f32(vol4, inc4);
+	}
+
+	vst1_f32((float *)&vol, vget_low_f32(vol4));
+#endif
+
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= vol;
+		vol += p_vol_inc;
+	}
+}
+
+AudioFrame AudioMix::scale_peak(AudioFrame *p_buffer, float p_volume, int p_frames) {
+	AudioFrame peak = AudioFrame(0, 0);
+	int i = 0;
+
+#if defined(AUDIO_MIX_SSE2)
+	__m128 vol4 = _mm_set1_ps(p_volume);
+	__m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 peak4 = _mm_setzero_ps();
+
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 buf = _mm_mul_ps(_mm_loadu_ps((const float *)(p_buffer + i)), vol4);
+		_mm_storeu_ps((float *)(p_buffer + i), buf);
+		peak4 = _mm_max_ps(peak4, _mm_and_ps(buf, abs_mask));
+	}
+
+	//fold the two frames of the register into one
+	peak4 = _mm_max_ps(peak4, _mm_movehl_ps(peak4, peak4));
+	_mm_storel_pi((__m64 *)&peak, peak4);
+#elif defined(AUDIO_MIX_NEON)
+	float32x4_t peak4 = vdupq_n_f32(0);
+
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t buf = vmulq_n_f32(vld1q_f32((const float *)(p_buffer + i)), p_volume);
+		vst1q_f32((float *)(p_buffer + i), buf);
+		peak4 = vmaxq_f32(peak4, vabsq_f32(buf));
+	}
+
+	vst1_f32((float *)&peak, vmax_f32(vget_low_f32(peak4), vget_high_f32(peak4)));
+#endif
+
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= p_volume;
+
+		float l = ABS(p_buffer[i].l);
+		if (l > peak.l) {
+			peak.l = l;
+		}
+		float r = ABS(p_buffer[i].r);
+		if (r > peak.r) {
+			peak.r = r;
+		}
+	}
+
+	return peak;
+}
@@ -0,0 +1,87 @@
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+/*  audio_mix.h                                                          */
+
+
+#include "core/math/audio_frame.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AUDIO_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+// Mixing kernels used by the AudioServer and the stream players.
+// An AudioFrame is two packed floats, so the SIMD paths process two frames per 128 bit register,
+// and fall back to scalar code for the remaining frame (and on platforms without SSE2 / NEON).
+class AudioMix {
+public:
+	// p_dst[i] += p_src[i]
+	static void accumulate(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames);
+
+	// p_dst[i] += p_src[i] * vol, vol starts at p_vol and is incremented by p_vol_inc every frame.
+	static void accumulate_ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol, const AudioFrame &p_vol_inc, int p_frames);
+
+	// p_buffer[i] *= vol, vol starts at p_vol and is incremented by p_vol_inc every frame.
+	static void scale_ramp(AudioFrame *p_buffer, const AudioFrame &p_vol, const AudioFrame &p_vol_inc, int p_frames);
+
+	// p_buffer[i] *= p_volume, returns the absolute peak of both channels after scaling.
+	static AudioFrame scale_peak(AudioFrame *p_buffer, float p_volume, int p_frames);
+
+	// Cubic interpolation between p_y[1] and p_y[2], p_y points to 4 consecutive history frames.
+	static _FORCE_INLINE_ AudioFrame cubic_interpolate(const AudioFrame *p_y, float p_mu) {
+		const AudioFrame &y0 = p_y[0];
+		const AudioFrame &y1 = p_y[1];
+		const AudioFrame &y2 = p_y[2];
+		const AudioFrame &y3 = p_y[3];
+
+		float mu2 = p_mu * p_mu;
+		AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
+		AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
+		AudioFrame a2 = y2 - y0;
+		AudioFrame a3 = 2 * y1;
+
+		return (a0 * p_mu * mu2 + a1 * mu2 + a2 * p_mu + a3) / 2;
+	}
+
+	// Same as cubic_interpolate(), for two output frames at once. The results are written to r_dst[0] and r_dst[1].
+	static _FORCE_INLINE_ void cubic_interpolate_2(AudioFrame *r_dst, const AudioFrame *p_a, float p_mu_a, const AudioFrame *p_b, float p_mu_b) {
+#if defined(AUDIO_MIX_SSE2)
+		__m128 y0 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&p_a[0]), (const __m64 *)&p_b[0]);
+		__m128 y1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&p_a[1]), (const __m64 *)&p_b[1]);
+		__m128 y2 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&p_a[2]), (const __m64 *)&p_b[2]);
+		__m128 y3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&p_a[3]), (const __m64 *)&p_b[3]);
+		__m128 mu = _mm_setr_ps(p_mu_a, p_mu_a, p_mu_b, p_mu_b);
+
+		__m128 a0 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(3.0f), _mm_sub_ps(y1, y2)), y3), y0);
+		__m128 a1 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), y0), _mm_mul_ps(_mm_set1_ps(5.0f), y1)), _mm_mul_ps(_mm_set1_ps(4.0f), y2)), y3);
+		__m128 a2 = _mm_sub_ps(y2, y0);
+		__m128 a3 = _mm_add_ps(y1, y1);
+
+		__m128 res = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a0, mu), a1), mu), a2), mu), a3);
+		_mm_storeu_ps((float *)r_dst, _mm_mul_ps(res, _mm_set1_ps(0.5f)));
+#elif defined(AUDIO_MIX_NEON)
+		float32x4_t y0 = vcombine_f32(vld1_f32((const float *)&p_a[0]), vld1_f32((const float *)&p_b[0]));
+		float32x4_t y1 = vcombine_f32(vld1_f32((const float *)&p_a[1]), vld1_f32((const float *)&p_b[1]));
+		float32x4_t y2 = vcombine_f32(vld1_f32((const float *)&p_a[2]), vld1_f32((const float *)&p_b[2]));
+		float32x4_t y3 = vcombine_f32(vld1_f32((const float *)&p_a[3]), vld1_f32((const float *)&p_b[3]));
+		float32x4_t mu = vcombine_f32(vdup_n_f32(p_mu_a), vdup_n_f32(p_mu_b));
+
+		float32x4_t a0 = vsubq_f32(vmlaq_n_f32(y3, vsubq_f32(y1, y2), 3.0f), y0);
+		float32x4_t a1 = vsubq_f32(vmlaq_n_f32(vmlsq_n_f32(vmulq_n_f32(y0, 2.0f), y1, 5.0f), y2, 4.0f), y3);
+		float32x4_t a2 = vsubq_f32(y2, y0);
+		float32x4_t a3 = vaddq_f32(y1, y1);
+
+		float32x4_t res = vmlaq_f32(a3, vmlaq_f32(a2, vmlaq_f32(a1, a0, mu), mu), mu);
+		vst1q_f32((float *)r_dst, vmulq_n_f32(res, 0.5f));
+#else
+		r_dst[0] = cubic_interpolate(p_a, p_mu_a);
+		r_dst[1] = cubic_interpolate(p_b, p_mu_b);
+#endif
+	}
+};
+
+#endif // AUDIO_MIX_H
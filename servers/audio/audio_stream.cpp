@@ -6,9 +6,29 @@
 
 #include "core/os/os.h"
 #include "core/config/project_settings.h"
+#include "servers/audio/audio_mix.h"
 
 //////////////////////////////
 
+void AudioStreamPlayback::skip(float p_rate_scale, int p_frames) {
+	AudioFrame discard[256];
+
+	while (p_frames > 0 && is_playing()) {
+		int to_mix = MIN(p_frames, 256);
+		mix(discard, p_rate_scale, to_mix);
+		p_frames -= to_mix;
+	}
+}
+
+//////////////////////////////
+
+uint64_t AudioStreamPlaybackResampled::_get_mix_increment(float p_rate_scale) {
+	float target_rate = AudioServer::get_singleton()->get_mix_rate();
+	float global_rate_scale = AudioServer::get_singleton()->get_global_rate_scale();
+
+	return uint64_t(((get_stream_sampling_rate() * p_rate_scale) / double(target_rate * global_rate_scale)) * double(FP_LEN));
+}
+
 void AudioStreamPlaybackResampled::_begin_resample() {
 	//clear cubic interpolation history
 	internal_buffer[0] = AudioFrame(0.0, 0.0);
@@ -18,33 +38,55 @@ void AudioStreamPlaybackResampled::_begin_resample() {
 	//mix buffer
 	_mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
 	mix_offset = 0;
+	begin_resample_pending = false;
+}
+
+// Returns how far the decoder position has to move (in stream frames) so the next mix continues exactly
+// where p_frames output frames of regular mixing would have left off. The internal buffer is refilled lazily.
+int64_t AudioStreamPlaybackResampled::_skip_resample(float p_rate_scale, int p_frames) {
+	int64_t advance = int64_t((mix_offset + _get_mix_increment(p_rate_scale) * p_frames) >> FP_BITS);
+
+	if (!begin_resample_pending) {
+		//decoder is ahead of the playback position by whatever is still buffered
+		advance -= INTERNAL_BUFFER_LEN;
+		begin_resample_pending = true;
+	}
+
+	mix_offset = 0;
+	return advance;
 }
 
 void AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
-	float target_rate = AudioServer::get_singleton()->get_mix_rate();
-	float global_rate_scale = AudioServer::get_singleton()->get_global_rate_scale();
+	if (begin_resample_pending && is_playing()) {
+		_begin_resample();
+	}
 
-	uint64_t mix_increment = uint64_t(((get_stream_sampling_rate() * p_rate_scale) / double(target_rate * global_rate_scale)) * double(FP_LEN));
+	uint64_t mix_increment = _get_mix_increment(p_rate_scale);
 
-	for (int i = 0; i < p_frames; i++) {
+	int i = 0;
+	while (i < p_frames) {
 		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
 		//standard cubic interpolation (great quality/performance ratio)
 		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
 		float mu = (mix_offset & FP_MASK) / float(FP_LEN);
-		AudioFrame y0 = internal_buffer[idx - 3];
-		AudioFrame y1 = internal_buffer[idx - 2];
-		AudioFrame y2 = internal_buffer[idx - 1];
-		AudioFrame y3 = internal_buffer[idx - 0];
 
-		float mu2 = mu * mu;
-		AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
-		AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
-		AudioFrame a2 = y2 - y0;
-		AudioFrame a3 = 2 * y1;
+		uint64_t next_offset = mix_offset + mix_increment;
 
-		p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+		if (i + 1 < p_frames && (next_offset >> FP_BITS) < INTERNAL_BUFFER_LEN) {
+			//both frames are inside the internal buffer, interpolate them together
+			uint32_t next_idx = CUBIC_INTERP_HISTORY + uint32_t(next_offset >> FP_BITS);
+			float next_mu = (next_offset & FP_MASK) / float(FP_LEN);
 
-		mix_offset += mix_increment;
+			AudioMix::cubic_interpolate_2(p_buffer + i, internal_buffer + idx - 3, mu, internal_buffer + next_idx - 3, next_mu);
+
+			mix_offset = next_offset + mix_increment;
+			i += 2;
+		} else {
+			p_buffer[i] = AudioMix::cubic_interpolate(internal_buffer + idx - 3, mu);
+
+			mix_offset = next_offset;
+			i++;
+		}
 
 		while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
 			internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
@@ -327,6 +369,12 @@ void AudioStreamPlaybackRandomPitch::mix(AudioFrame *p_buffer, float p_rate_scal
 	}
 }
 
+void AudioStreamPlaybackRandomPitch::skip(float p_rate_scale, int p_frames) {
+	if (playing.is_valid()) {
+		playing->skip(p_rate_scale * pitch_scale, p_frames);
+	}
+}
+
 AudioStreamPlaybackRandomPitch::~AudioStreamPlaybackRandomPitch() {
 	random_pitch->playbacks.erase(this);
 }
@@ -23,6 +23,10 @@ public:
 	virtual void seek(float p_time) = 0;
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) = 0;
+
+	// Advances playback by p_frames output frames without producing audio, used for virtualized voices.
+	// The default implementation mixes into a scratch buffer, streams that can seek cheaply should override it.
+	virtual void skip(float p_rate_scale, int p_frames);
 };
 
 class AudioStreamPlaybackResampled : public AudioStreamPlayback {
@@ -38,16 +42,23 @@ class AudioStreamPlaybackResampled : public AudioStreamPlayback {
 
 	AudioFrame internal_buffer[INTERNAL_BUFFER_LEN + CUBIC_INTERP_HISTORY];
 	uint64_t mix_offset;
+	bool begin_resample_pending;
+
+	uint64_t _get_mix_increment(float p_rate_scale);
 
 protected:
 	void _begin_resample();
+	int64_t _skip_resample(float p_rate_scale, int p_frames);
 	virtual void _mix_internal(AudioFrame *p_buffer, int p_frames) = 0;
 	virtual float get_stream_sampling_rate() = 0;
 
 public:
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames);
 
-	AudioStreamPlaybackResampled() { mix_offset = 0; }
+	AudioStreamPlaybackResampled() {
+		mix_offset = 0;
+		begin_resample_pending = false;
+	}
 };
 
 class AudioStream : public Resource {
@@ -165,6 +176,7 @@ public:
 	virtual void seek(float p_time);
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames);
+	virtual void skip(float p_rate_scale, int p_frames);
 
 	~AudioStreamPlaybackRandomPitch();
 };
@@ -10,6 +10,7 @@
 #include "core/os/os.h"
 #include "scene/audio/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
 #ifdef TOOLS_ENABLED
@@ -476,135 +477,261 @@ void AudioServer::_mix_step() {
 		E->get().callback(E->get().userdata);
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
+	_mix_voices();
+
+	mix_solo_mode = solo_mode;
+	mix_processing_allowed = processing_allowed;
+
+	_update_bus_graph();
+
+	//buses of the same level only send to lower levels, so their effects can be processed in parallel
+	uint32_t level_from = 0;
+	for (uint32_t l = 0; l < bus_level_ends.size(); l++) {
+		uint32_t level_to = bus_level_ends[l];
+		uint32_t level_size = level_to - level_from;
+		const int *level_buses = bus_order.ptr() + level_from;
+
+		int buses_with_effects = 0;
+		if (processing_allowed && effect_thread_pool.get_thread_count() > 0) {
+			for (uint32_t i = 0; i < level_size; i++) {
+				if (buses[level_buses[i]]->has_active_effects()) {
+					buses_with_effects++;
+				}
+			}
+		}
+
+		if (buses_with_effects > 1) {
+			effect_thread_pool.do_work(level_size, this, &AudioServer::_process_bus_threaded, level_buses);
+		} else {
+			for (uint32_t i = 0; i < level_size; i++) {
+				_process_bus(level_buses[i]);
+			}
+		}
+
+		//several buses of a level may send to the same bus, so sends are mixed serially
+		for (uint32_t i = 0; i < level_size; i++) {
+			_send_bus(level_buses[i]);
+		}
+
+		level_from = level_to;
+	}
+
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
+
+void AudioServer::_update_bus_graph() {
+	int bus_count = buses.size();
+	int max_depth = 0;
+
+	for (int i = 0; i < bus_count; i++) {
 		Bus *bus = buses[i];
 
-		if (processing_allowed) {
-			for (int k = 0; k < bus->channels.size(); k++) {
-				if (bus->channels[k].active && !bus->channels[k].used) {
-					//buffer was not used, but it's still active, so it must be cleaned
-					AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		if (i == 0) {
+			bus->send_index = -1;
+			bus->depth = 0;
+			continue;
+		}
 
-					for (uint32_t j = 0; j < buffer_size; j++) {
-						buf[j] = AudioFrame(0, 0);
-					}
+		//everything has a send save for master bus
+		bus->send_index = 0;
+		const RBMap<StringName, Bus *>::Element *E = bus_map.find(bus->send);
+		if (E && E->get()->index_cache < bus->index_cache) { //otherwise invalid, send to master
+			bus->send_index = E->get()->index_cache;
+		}
+
+		bus->depth = buses[bus->send_index]->depth + 1;
+		max_depth = MAX(max_depth, bus->depth);
+	}
+
+	bus_order.resize(bus_count);
+	bus_level_ends.resize(max_depth + 1);
+
+	uint32_t pos = 0;
+	for (int d = max_depth; d >= 0; d--) {
+		for (int i = bus_count - 1; i >= 0; i--) {
+			if (buses[i]->depth == d) {
+				bus_order[pos++] = i;
+			}
+		}
+		bus_level_ends[max_depth - d] = pos;
+	}
+}
+
+void AudioServer::_process_bus(int p_bus) {
+	Bus *bus = buses[p_bus];
+
+	if (mix_processing_allowed) {
+		for (int k = 0; k < bus->channels.size(); k++) {
+			if (bus->channels[k].active && !bus->channels[k].used) {
+				//buffer was not used, but it's still active, so it must be cleaned
+				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+
+				for (uint32_t j = 0; j < buffer_size; j++) {
+					buf[j] = AudioFrame(0, 0);
 				}
 			}
+		}
 
-			//process effects
-			if (!bus->bypass) {
-				for (int j = 0; j < bus->effects.size(); j++) {
-					if (!bus->effects[j].enabled) {
-						continue;
-					}
+		//process effects
+		if (!bus->bypass) {
+#ifdef DEBUG_ENABLED
+			uint64_t bus_ticks = OS::get_singleton()->get_ticks_usec();
+#endif
+
+			for (int j = 0; j < bus->effects.size(); j++) {
+				if (!bus->effects[j].enabled) {
+					continue;
+				}
 
 #ifdef DEBUG_ENABLED
-					uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-					for (int k = 0; k < bus->channels.size(); k++) {
-						if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-							continue;
-						}
-						bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
+				for (int k = 0; k < bus->channels.size(); k++) {
+					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+						continue;
 					}
+					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), bus->channels.write[k].temp_buffer.ptrw(), buffer_size);
+				}
 
-					//swap buffers, so internal buffer always has the right data
-					for (int k = 0; k < bus->channels.size(); k++) {
-						if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-							continue;
-						}
-						SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+				//swap buffers, so internal buffer always has the right data
+				for (int k = 0; k < bus->channels.size(); k++) {
+					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+						continue;
 					}
+					SWAP(bus->channels.write[k].buffer, bus->channels.write[k].temp_buffer);
+				}
 
 #ifdef DEBUG_ENABLED
-					bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
-				}
 			}
-		} // if processing allowed
 
-		//process send
+#ifdef DEBUG_ENABLED
+			bus->prof_time += OS::get_singleton()->get_ticks_usec() - bus_ticks;
+#endif
+		}
+	} // if processing allowed
+
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (!bus->channels[k].active) {
+			bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
 
-		Bus *send = nullptr;
+		AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+		AudioFrame peak = AudioFrame(0, 0);
+
+		float volume = Math::db2linear(bus->volume_db);
+
+		if (mix_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
 			}
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
-				continue;
+		if (mix_processing_allowed) {
+			//apply volume and compute peak
+			peak = AudioMix::scale_peak(buf, volume, buffer_size);
+		}
+
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + AUDIO_PEAK_OFFSET), Math::linear2db(peak.r + AUDIO_PEAK_OFFSET));
+
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false; //went inactive, don't mix.
 			}
+		}
+	}
+}
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+void AudioServer::_process_bus_threaded(uint32_t p_index, const int *p_buses) {
+	_process_bus(p_buses[p_index]);
+}
 
-			AudioFrame peak = AudioFrame(0, 0);
+void AudioServer::_send_bus(int p_bus) {
+	Bus *bus = buses[p_bus];
 
-			float volume = Math::db2linear(bus->volume_db);
+	if (bus->send_index < 0 || !mix_processing_allowed) {
+		return;
+	}
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
-			}
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (!bus->channels[k].active) {
+			continue;
+		}
 
-			if (processing_allowed) {
-				//apply volume and compute peak
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] *= volume;
+		AudioFrame *target_buf = thread_get_channel_mix_buffer(bus->send_index, k);
 
-					float l = ABS(buf[j].l);
-					if (l > peak.l) {
-						peak.l = l;
-					}
-					float r = ABS(buf[j].r);
-					if (r > peak.r) {
-						peak.r = r;
-					}
-				}
-			}
+		AudioMix::accumulate(target_buf, bus->channels[k].buffer.ptr(), buffer_size);
+	}
+}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + AUDIO_PEAK_OFFSET), Math::linear2db(peak.r + AUDIO_PEAK_OFFSET));
+void AudioServer::_mix_voices() {
+	voice_order.clear();
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+	for (uint32_t i = 0; i < voices.size(); i++) {
+		Voice &voice = voices[i];
+		voice.virtualized = false;
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
-			}
+		VoiceOrder order;
+		order.state.bus_index = 0;
+		order.state.priority = 0;
+		order.state.audibility = 1.0;
+		order.voice = i;
 
-			if (send && processing_allowed) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+		if (voice.query_callback(voice.userdata, order.state)) {
+			voice_order.push_back(order);
+		}
+	}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
-			}
+	voice_order.sort();
+
+	uint32_t active = 0;
+	uint32_t virtualized = 0;
+	int bus_index = -1;
+	int bus_voices = 0;
+
+	for (uint32_t i = 0; i < voice_order.size(); i++) {
+		const VoiceOrder &order = voice_order[i];
+
+		if (order.state.bus_index != bus_index) {
+			bus_index = order.state.bus_index;
+			bus_voices = 0;
+		}
+
+		if (order.state.audibility < voice_virtualize_threshold || (max_voices_per_bus > 0 && bus_voices >= max_voices_per_bus)) {
+			voices[order.voice].virtualized = true;
+			virtualized++;
+		} else {
+			bus_voices++;
+			active++;
 		}
 	}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+	//idle voices still get their mix callback, they may need to finish a fade out
+	for (uint32_t i = 0; i < voices.size(); i++) {
+		const Voice &voice = voices[i];
+
+		if (voice.virtualized) {
+			voice.skip_callback(voice.userdata, buffer_size);
+		} else {
+			voice.mix_callback(voice.userdata);
+		}
+	}
+
+	active_voice_count.set(active);
+	virtual_voice_count.set(virtualized);
 }
 
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
@@ -691,6 +818,7 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -760,6 +888,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].temp_buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
@@ -1063,16 +1192,11 @@ float AudioServer::get_global_rate_scale() const {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
-
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
-	}
-
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1084,6 +1208,16 @@ void AudioServer::init() {
 	ProjectSettings::get_singleton()->set_custom_property_info("audio/channel_disable_time", PropertyInfo(Variant::REAL, "audio/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
 	buffer_size = 1024; //hardcoded for now
 
+	max_voices_per_bus = GLOBAL_DEF("audio/voices/max_voices_per_bus", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/voices/max_voices_per_bus", PropertyInfo(Variant::INT, "audio/voices/max_voices_per_bus", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
+	voice_virtualize_threshold = Math::db2linear(float(GLOBAL_DEF("audio/voices/virtualize_threshold_db", -80.0)));
+
+	int effect_threads = GLOBAL_DEF_RST("audio/buses/effect_threads", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/buses/effect_threads", PropertyInfo(Variant::INT, "audio/buses/effect_threads", PROPERTY_HINT_RANGE, "0,16,1"));
+	if (effect_threads > 0) {
+		effect_thread_pool.init(effect_threads);
+	}
+
 	init_channels_and_buffers();
 
 	mix_count = 0;
@@ -1122,6 +1256,12 @@ void AudioServer::update() {
 				continue;
 			}
 
+			// Whole effect chain of the bus, effects of different buses may run in parallel
+			if (bus->has_active_effects()) {
+				values.push_back(String(bus->name));
+				values.push_back(USEC_TO_SEC(bus->prof_time));
+			}
+
 			for (int j = 0; j < bus->effects.size(); j++) {
 				if (!bus->effects[j].enabled) {
 					continue;
@@ -1151,6 +1291,7 @@ void AudioServer::update() {
 	// Reset profiling times
 	for (int i = buses.size() - 1; i >= 0; i--) {
 		Bus *bus = buses[i];
+		bus->prof_time = 0;
 		if (bus->bypass) {
 			continue;
 		}
@@ -1206,6 +1347,8 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	effect_thread_pool.finish();
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1323,6 +1466,39 @@ void AudioServer::remove_update_callback(AudioCallback p_callback, void *p_userd
 	unlock();
 }
 
+void AudioServer::add_voice(AudioCallback p_mix_callback, AudioVoiceQueryCallback p_query_callback, AudioVoiceSkipCallback p_skip_callback, void *p_userdata) {
+	lock();
+	Voice voice;
+	voice.mix_callback = p_mix_callback;
+	voice.query_callback = p_query_callback;
+	voice.skip_callback = p_skip_callback;
+	voice.userdata = p_userdata;
+	voice.virtualized = false;
+	voices.push_back(voice);
+	//avoid allocating on the audio thread when ranking voices
+	voice_order.reserve(voices.size());
+	unlock();
+}
+
+void AudioServer::remove_voice(void *p_userdata) {
+	lock();
+	for (uint32_t i = 0; i < voices.size(); i++) {
+		if (voices[i].userdata == p_userdata) {
+			voices.remove_unordered(i);
+			break;
+		}
+	}
+	unlock();
+}
+
+int AudioServer::get_active_voice_count() const {
+	return active_voice_count.get();
+}
+
+int AudioServer::get_virtual_voice_count() const {
+	return virtual_voice_count.get();
+}
+
 void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 	ERR_FAIL_COND(p_bus_layout.is_null() || p_bus_layout->buses.size() == 0);
 
@@ -1366,6 +1542,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1490,6 +1667,9 @@ void AudioServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_time_since_last_mix"), &AudioServer::get_time_since_last_mix);
 	ClassDB::bind_method(D_METHOD("get_output_latency"), &AudioServer::get_output_latency);
 
+	ClassDB::bind_method(D_METHOD("get_active_voice_count"), &AudioServer::get_active_voice_count);
+	ClassDB::bind_method(D_METHOD("get_virtual_voice_count"), &AudioServer::get_virtual_voice_count);
+
 	ClassDB::bind_method(D_METHOD("capture_get_device_list"), &AudioServer::capture_get_device_list);
 	ClassDB::bind_method(D_METHOD("capture_get_device"), &AudioServer::capture_get_device);
 	ClassDB::bind_method(D_METHOD("capture_set_device", "name"), &AudioServer::capture_set_device);
@@ -1530,6 +1710,10 @@ AudioServer::AudioServer() {
 	mix_size = 0;
 	global_rate_scale = 1;
 	last_sound_played_ms = 0;
+	max_voices_per_bus = 0;
+	voice_virtualize_threshold = 0;
+	mix_solo_mode = false;
+	mix_processing_allowed = true;
 }
 
 AudioServer::~AudioServer() {
@@ -4,9 +4,12 @@
 /*  audio_server.h                                                       */
 
 
+#include "core/containers/local_vector.h"
 #include "core/math/audio_frame.h"
 #include "core/object/object.h"
 #include "core/os/os.h"
+#include "core/os/safe_refcount.h"
+#include "core/os/thread_work_pool.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
 
@@ -173,6 +176,16 @@ public:
 
 	typedef void (*AudioCallback)(void *p_userdata);
 
+	struct VoiceState {
+		int bus_index;
+		int priority;
+		float audibility; //estimated linear gain of the voice at the listener
+	};
+
+	//return false if the voice is not playing (or needs a regular mix to handle a state change)
+	typedef bool (*AudioVoiceQueryCallback)(void *p_userdata, VoiceState &r_state);
+	typedef void (*AudioVoiceSkipCallback)(void *p_userdata, int p_frames);
+
 private:
 	uint64_t mix_time;
 	int mix_size;
@@ -206,6 +219,7 @@ private:
 			bool active;
 			AudioFrame peak_volume;
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> temp_buffer; //effects write here, then it is swapped with buffer
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio;
 			Channel() {
@@ -237,12 +251,57 @@ private:
 		float volume_db;
 		StringName send;
 		int index_cache;
+
+		//resolved every mix step, see _update_bus_graph()
+		int send_index;
+		int depth;
+
+#ifdef DEBUG_ENABLED
+		uint64_t prof_time; //time spent in the effect chain, for the profiler
+#endif
+
+		bool has_active_effects() const {
+			if (bypass) {
+				return false;
+			}
+			for (int i = 0; i < effects.size(); i++) {
+				if (effects[i].enabled) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		Bus() {
+			solo = false;
+			mute = false;
+			bypass = false;
+			soloed = false;
+			volume_db = 0;
+			index_cache = 0;
+			send_index = -1;
+			depth = 0;
+#ifdef DEBUG_ENABLED
+			prof_time = 0;
+#endif
+		}
 	};
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<Bus *> buses;
 	RBMap<StringName, Bus *> bus_map;
 
+	//buses sorted by depth in the send graph (deepest first), bus_level_ends marks where each depth ends
+	LocalVector<int> bus_order;
+	LocalVector<uint32_t> bus_level_ends;
+	ThreadWorkPool effect_thread_pool;
+	bool mix_solo_mode;
+	bool mix_processing_allowed;
+
+	void _update_bus_graph();
+	void _process_bus(int p_bus);
+	void _process_bus_threaded(uint32_t p_index, const int *p_buses);
+	void _send_bus(int p_bus);
+
 	void _update_bus_effects(int p_bus);
 
 	static AudioServer *singleton;
@@ -275,6 +334,39 @@ private:
 	RBSet<CallbackItem> callbacks;
 	RBSet<CallbackItem> update_callbacks;
 
+	struct Voice {
+		AudioCallback mix_callback;
+		AudioVoiceQueryCallback query_callback;
+		AudioVoiceSkipCallback skip_callback;
+		void *userdata;
+		bool virtualized;
+	};
+
+	struct VoiceOrder {
+		VoiceState state;
+		uint32_t voice;
+
+		bool operator<(const VoiceOrder &p_order) const {
+			if (state.bus_index != p_order.state.bus_index) {
+				return state.bus_index < p_order.state.bus_index;
+			}
+			if (state.priority != p_order.state.priority) {
+				return state.priority > p_order.state.priority;
+			}
+			return state.audibility > p_order.state.audibility;
+		}
+	};
+
+	LocalVector<Voice> voices;
+	LocalVector<VoiceOrder> voice_order;
+	int max_voices_per_bus;
+	float voice_virtualize_threshold;
+
+	SafeNumeric<uint32_t> active_voice_count;
+	SafeNumeric<uint32_t> virtual_voice_count;
+
+	void _mix_voices();
+
 	friend class AudioDriver;
 	void _driver_process(int p_frames, int32_t *p_buffer);
 
@@ -384,6 +476,15 @@ public:
 	void add_update_callback(AudioCallback p_callback, void *p_userdata);
 	void remove_update_callback(AudioCallback p_callback, void *p_userdata);
 
+	// Voices are mix callbacks that are subject to polyphony limits. Each mix the voices on a bus are ranked
+	// by priority and audibility, the ones over the limit (or below the audibility threshold) are virtualized:
+	// p_skip_callback is called instead of p_mix_callback, which should only advance the playback position.
+	void add_voice(AudioCallback p_mix_callback, AudioVoiceQueryCallback p_query_callback, AudioVoiceSkipCallback p_skip_callback, void *p_userdata);
+	void remove_voice(void *p_userdata);
+
+	int get_active_voice_count() const;
+	int get_virtual_voice_count() const;
+
 	void set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout);
 	Ref<AudioBusLayout> generate_bus_layout() const;
 
@@ -375,6 +375,8 @@ void Body2DSW::_compute_area_gravity_and_dampenings(const Area2DSW *p_area) {
 }
 
 void Body2DSW::integrate_forces(real_t p_step) {
+	integration_motion_pending = false;
+
 	if (mode == Physics2DServer::BODY_MODE_STATIC) {
 		return;
 	}
@@ -497,8 +499,9 @@ void Body2DSW::integrate_forces(real_t p_step) {
 	biased_angular_velocity = 0;
 	biased_linear_velocity = Vector2();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+	if (do_motion) { //shapes temporarily extend for raycast, done in integrate_forces_finish()
+		integration_motion = motion;
+		integration_motion_pending = true;
 	}
 
 	// damp_area=NULL; // clear the area, so it is set in the next frame
@@ -506,21 +509,21 @@ void Body2DSW::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
+void Body2DSW::integrate_forces_finish() {
+	if (integration_motion_pending) {
+		_update_shapes_with_motion(integration_motion);
+		integration_motion_pending = false;
+	}
+}
+
 void Body2DSW::integrate_velocities(real_t p_step) {
 	if (mode == Physics2DServer::BODY_MODE_STATIC) {
 		return;
 	}
 
-	if (fi_callback) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	if (mode == Physics2DServer::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
-		}
 		return;
 	}
 
@@ -530,7 +533,7 @@ void Body2DSW::integrate_velocities(real_t p_step) {
 	real_t angle = get_transform().get_rotation() + total_angular_velocity * p_step;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == Physics2DServer::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false); // Shapes are updated in integrate_velocities_finish().
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != Physics2DServer::CCD_MODE_DISABLED) {
@@ -540,6 +543,27 @@ void Body2DSW::integrate_velocities(real_t p_step) {
 	//_update_inertia_tensor();
 }
 
+void Body2DSW::integrate_velocities_finish() {
+	if (mode == Physics2DServer::BODY_MODE_STATIC) {
+		return;
+	}
+
+	if (fi_callback) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == Physics2DServer::BODY_MODE_KINEMATIC) {
+		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
+			set_active(false); //stopped moving, deactivate
+		}
+		return;
+	}
+
+	if (continuous_cd_mode == Physics2DServer::CCD_MODE_DISABLED) {
+		_set_transform(get_transform());
+	}
+}
+
 void Body2DSW::wakeup_neighbours() {
 	for (RBMap<Constraint2DSW *, int>::Element *E = constraint_map.front(); E; E = E->next()) {
 		const Constraint2DSW *c = E->key();
@@ -645,6 +669,7 @@ Body2DSW::Body2DSW() :
 	contact_count = 0;
 	gravity_scale = 1.0;
 	first_integration = false;
+	integration_motion_pending = false;
 
 	still_time = 0;
 	continuous_cd_mode = Physics2DServer::CCD_MODE_DISABLED;
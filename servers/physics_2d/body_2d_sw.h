@@ -56,6 +56,9 @@ class Body2DSW : public CollisionObject2DSW {
 	bool can_sleep;
 	bool first_time_kinematic;
 	bool first_integration;
+
+	Vector2 integration_motion;
+	bool integration_motion_pending;
 	void _update_inertia();
 	virtual void _shapes_changed();
 	Transform2D new_transform;
@@ -251,8 +254,12 @@ public:
 	_FORCE_INLINE_ real_t get_linear_damp() const { return linear_damp; }
 	_FORCE_INLINE_ real_t get_angular_damp() const { return angular_damp; }
 
+	// Integration runs in two parts. The first one only touches the body itself, so it can run
+	// for many bodies at once, the *_finish() one updates the broadphase and the space lists.
 	void integrate_forces(real_t p_step);
+	void integrate_forces_finish();
 	void integrate_velocities(real_t p_step);
+	void integrate_velocities_finish();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
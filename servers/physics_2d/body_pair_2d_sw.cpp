@@ -184,6 +184,42 @@ bool BodyPair2DSW::_test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const
 	return true;
 }
 
+bool BodyPair2DSW::_can_reuse_narrowphase(const Transform2D &p_xform_A, const Transform2D &p_xform_B, const Shape2DSW *p_shape_A, const Shape2DSW *p_shape_B) const {
+	if (!narrowphase_cache.valid || narrowphase_cache.shape_ptr_A != p_shape_A || narrowphase_cache.shape_ptr_B != p_shape_B) {
+		return false;
+	}
+
+	if (narrowphase_cache.version_A != p_shape_A->get_version() || narrowphase_cache.version_B != p_shape_B->get_version()) {
+		return false;
+	}
+
+	if (narrowphase_cache.collided && contact_count != narrowphase_cache.contact_count) {
+		return false; // Some contact got dropped, the solver would add it back.
+	}
+
+	// Small enough to stay well inside the recycle radius, so a new run would find the same contacts.
+	real_t origin_tolerance = space->get_contact_recycle_radius() * 0.01;
+	real_t origin_tolerance_2 = origin_tolerance * origin_tolerance;
+	const real_t basis_tolerance = 1e-4;
+
+	const Transform2D *xforms[2] = { &p_xform_A, &p_xform_B };
+	const Transform2D *cached[2] = { &narrowphase_cache.xform_A, &narrowphase_cache.xform_B };
+
+	for (int i = 0; i < 2; i++) {
+		if (xforms[i]->columns[2].distance_squared_to(cached[i]->columns[2]) > origin_tolerance_2) {
+			return false;
+		}
+		for (int j = 0; j < 2; j++) {
+			Vector2 diff = xforms[i]->columns[j] - cached[i]->columns[j];
+			if (ABS(diff.x) > basis_tolerance || ABS(diff.y) > basis_tolerance) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 real_t combine_bounce(Body2DSW *A, Body2DSW *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -196,6 +232,7 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		narrowphase_cache.valid = false;
 		return false;
 	}
 
@@ -205,6 +242,7 @@ bool BodyPair2DSW::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			narrowphase_cache.valid = false;
 			return false;
 		}
 	}
@@ -236,7 +274,35 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
 	bool prev_collided = collided;
 
-	collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+	if (motion_A == Vector2() && motion_B == Vector2() && _can_reuse_narrowphase(xform_A, xform_B, shape_A_ptr, shape_B_ptr)) {
+		// Same result as last time, the contacts that survived validation are the ones the solver would report again.
+		collided = narrowphase_cache.collided;
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].reused = true;
+		}
+		space->add_narrowphase_cached();
+	} else {
+		collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+		space->add_narrowphase_solved();
+
+		// Results of shape casts depend on the motion, don't keep them.
+		narrowphase_cache.valid = motion_A == Vector2() && motion_B == Vector2();
+		if (narrowphase_cache.valid) {
+			narrowphase_cache.xform_A = xform_A;
+			narrowphase_cache.xform_B = xform_B;
+			narrowphase_cache.shape_ptr_A = shape_A_ptr;
+			narrowphase_cache.shape_ptr_B = shape_B_ptr;
+			narrowphase_cache.version_A = shape_A_ptr->get_version();
+			narrowphase_cache.version_B = shape_B_ptr->get_version();
+			narrowphase_cache.collided = collided;
+			narrowphase_cache.contact_count = 0;
+			for (int i = 0; i < contact_count; i++) {
+				if (contacts[i].reused) {
+					narrowphase_cache.contact_count++;
+				}
+			}
+		}
+	}
 	if (!collided) {
 		//test ccd (currently just a raycast)
 
@@ -475,6 +541,7 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	contact_count = 0;
 	collided = false;
 	oneway_disabled = false;
+	narrowphase_cache.valid = false;
 }
 
 BodyPair2DSW::~BodyPair2DSW() {
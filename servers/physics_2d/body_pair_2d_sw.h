@@ -51,6 +51,22 @@ class BodyPair2DSW : public Constraint2DSW {
 	bool oneway_disabled;
 	int cc;
 
+	// Inputs and result of the last narrowphase run. While the shapes and their transforms
+	// relative to A stay within tolerance, the contacts found back then are reused as is.
+	struct NarrowphaseCache {
+		Transform2D xform_A;
+		Transform2D xform_B;
+		const Shape2DSW *shape_ptr_A;
+		const Shape2DSW *shape_ptr_B;
+		uint32_t version_A;
+		uint32_t version_B;
+		int contact_count;
+		bool collided;
+		bool valid;
+	} narrowphase_cache;
+
+	bool _can_reuse_narrowphase(const Transform2D &p_xform_A, const Transform2D &p_xform_B, const Shape2DSW *p_shape_A, const Shape2DSW *p_shape_B) const;
+
 	bool _test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result = false);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
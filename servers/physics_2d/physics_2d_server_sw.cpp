@@ -14,7 +14,7 @@
 #define FLUSH_QUERY_CHECK(m_object) \
 	ERR_FAIL_COND_MSG(m_object->get_space() && flushing_queries, "Can't change this state while flushing queries. Use call_deferred() or set_deferred() to change monitoring state instead.");
 
-RID Physics2DServerSW::_shape_create(ShapeType p_shape) {
+Shape2DSW *Physics2DServerSW::_create_shape(ShapeType p_shape) {
 	Shape2DSW *shape = nullptr;
 	switch (p_shape) {
 		case SHAPE_LINE: {
@@ -42,12 +42,21 @@ RID Physics2DServerSW::_shape_create(ShapeType p_shape) {
 			shape = memnew(ConcavePolygonShape2DSW);
 		} break;
 		case SHAPE_CUSTOM: {
-			ERR_FAIL_V(RID());
+			ERR_FAIL_V(nullptr);
 
 		} break;
 	}
 
+	return shape;
+}
+
+RID Physics2DServerSW::_shape_create(ShapeType p_shape) {
+	Shape2DSW *shape = _create_shape(p_shape);
+	ERR_FAIL_COND_V(!shape, RID());
+
+	query_owner_lock.write_lock();
 	RID id = shape_owner.make_rid(shape);
+	query_owner_lock.write_unlock();
 	shape->set_self(id);
 
 	return id;
@@ -83,12 +92,14 @@ RID Physics2DServerSW::concave_polygon_shape_create() {
 void Physics2DServerSW::shape_set_data(RID p_shape, const Variant &p_data) {
 	Shape2DSW *shape = shape_owner.get(p_shape);
 	ERR_FAIL_COND(!shape);
+	_retire_snapshot_shape(shape);
 	shape->set_data(p_data);
 };
 
 void Physics2DServerSW::shape_set_custom_solver_bias(RID p_shape, real_t p_bias) {
 	Shape2DSW *shape = shape_owner.get(p_shape);
 	ERR_FAIL_COND(!shape);
+	_retire_snapshot_shape(shape);
 	shape->set_custom_bias(p_bias);
 }
 
@@ -184,7 +195,9 @@ bool Physics2DServerSW::shape_collide(RID p_shape_A, const Transform2D &p_xform_
 
 RID Physics2DServerSW::space_create() {
 	Space2DSW *space = memnew(Space2DSW);
+	query_owner_lock.write_lock();
 	RID id = space_owner.make_rid(space);
+	query_owner_lock.write_unlock();
 	space->set_self(id);
 	RID area_id = RID_PRIME(area_create());
 	Area2DSW *area = area_owner.get(area_id);
@@ -203,6 +216,12 @@ void Physics2DServerSW::space_set_active(RID p_space, bool p_active) {
 		active_spaces.insert(space);
 	} else {
 		active_spaces.erase(space);
+
+		// Its snapshots won't be rebuilt anymore, empty them so they don't hold on to retired shapes.
+		if (snapshot_spaces.has(space)) {
+			snapshot_spaces.erase(space);
+			space->reset_snapshots();
+		}
 	}
 }
 
@@ -252,6 +271,17 @@ Physics2DDirectSpaceState *Physics2DServerSW::space_get_direct_state(RID p_space
 	return space->get_direct_state();
 }
 
+// The returned state belongs to the space. Freeing the space waits for the queries already running on it,
+// callers must make sure no new ones start on other threads by then.
+Physics2DDirectSpaceState *Physics2DServerSW::space_get_snapshot_state(RID p_space) {
+	RWLockRead read_lock(query_owner_lock);
+
+	Space2DSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, nullptr);
+
+	return space->get_snapshot_state();
+}
+
 RID Physics2DServerSW::area_create() {
 	Area2DSW *area = memnew(Area2DSW);
 	RID rid = area_owner.make_rid(area);
@@ -1110,8 +1140,20 @@ void Physics2DServerSW::free(RID p_rid) {
 			so->remove_shape(shape);
 		}
 
+		query_owner_lock.write_lock();
 		shape_owner.free(p_rid);
-		memdelete(shape);
+		query_owner_lock.write_unlock();
+
+		_retire_snapshot_shape(shape);
+
+		if (snapshot_spaces.size()) {
+			PendingShapeFree pending;
+			pending.shape = shape;
+			pending.pass = step_pass;
+			pending_shape_frees.push_back(pending);
+		} else {
+			memdelete(shape);
+		}
 	} else if (body_owner.owns(p_rid)) {
 		Body2DSW *body = body_owner.get(p_rid);
 
@@ -1157,8 +1199,12 @@ void Physics2DServerSW::free(RID p_rid) {
 		}
 
 		active_spaces.erase(space);
+		snapshot_spaces.erase(space);
 		free(space->get_default_area()->get_self());
+		query_owner_lock.write_lock();
 		space_owner.free(p_rid);
+		query_owner_lock.write_unlock();
+		space->reset_snapshots(); // Waits for the snapshot queries already running.
 		memdelete(space);
 	} else if (joint_owner.owns(p_rid)) {
 		Joint2DSW *joint = joint_owner.get(p_rid);
@@ -1195,14 +1241,91 @@ void Physics2DServerSW::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	narrowphase_solved = 0;
+	narrowphase_cached = 0;
+	step_pass++;
+
 	for (RBSet<const Space2DSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
 		stepper->step((Space2DSW *)E->get(), p_step, iterations);
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
 		collision_pairs += E->get()->get_collision_pairs();
+		narrowphase_solved += E->get()->get_narrowphase_solved();
+		narrowphase_cached += E->get()->get_narrowphase_cached();
 	}
+
+	_publish_snapshots();
 };
 
+void Physics2DServerSW::_publish_snapshots() {
+	for (RBSet<const Space2DSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
+		Space2DSW *space = (Space2DSW *)E->get();
+		if (!space->is_snapshot_requested()) {
+			continue;
+		}
+
+		snapshot_spaces.insert(space);
+		space->publish_snapshot(step_pass);
+	}
+
+	if (pending_shape_frees.empty()) {
+		return;
+	}
+
+	// A shape can be deleted once both snapshots of every space were rebuilt after it was retired.
+	uint64_t oldest_pass = UINT64_MAX;
+	for (RBSet<Space2DSW *>::Element *E = snapshot_spaces.front(); E; E = E->next()) {
+		oldest_pass = MIN(oldest_pass, E->get()->get_snapshot_oldest_pass());
+	}
+
+	uint32_t i = 0;
+	while (i < pending_shape_frees.size()) {
+		if (pending_shape_frees[i].pass < oldest_pass) {
+			memdelete(pending_shape_frees[i].shape);
+			pending_shape_frees.remove_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+// Snapshots reference a copy of each shape, so the shape itself can be modified while they are being read.
+Shape2DSW *Physics2DServerSW::_get_snapshot_shape(Shape2DSW *p_shape) {
+	Shape2DSW *snapshot_shape = p_shape->get_snapshot_shape();
+	if (!snapshot_shape) {
+		snapshot_shape = _create_shape(p_shape->get_type());
+		snapshot_shape->set_data(p_shape->get_data());
+		snapshot_shape->set_custom_bias(p_shape->get_custom_bias());
+		p_shape->set_snapshot_shape(snapshot_shape);
+	}
+
+	return snapshot_shape;
+}
+
+// Called before the shape changes, the next snapshots get a new copy and the current one is freed once no snapshot uses it.
+void Physics2DServerSW::_retire_snapshot_shape(Shape2DSW *p_shape) {
+	Shape2DSW *snapshot_shape = p_shape->get_snapshot_shape();
+	if (!snapshot_shape) {
+		return;
+	}
+
+	p_shape->set_snapshot_shape(nullptr);
+
+	if (snapshot_spaces.size()) {
+		PendingShapeFree pending;
+		pending.shape = snapshot_shape;
+		pending.pass = step_pass;
+		pending_shape_frees.push_back(pending);
+	} else {
+		memdelete(snapshot_shape);
+	}
+}
+
+Shape2DSW *Physics2DServerSW::_get_query_shape(RID p_shape) {
+	RWLockRead read_lock(query_owner_lock);
+	return shape_owner.get(p_shape);
+}
+
 void Physics2DServerSW::sync() {
 	doing_sync = true;
 };
@@ -1262,6 +1385,12 @@ void Physics2DServerSW::end_sync() {
 
 void Physics2DServerSW::finish() {
 	memdelete(stepper);
+
+	for (uint32_t i = 0; i < pending_shape_frees.size(); i++) {
+		memdelete(pending_shape_frees[i].shape);
+	}
+	pending_shape_frees.clear();
+	snapshot_spaces.clear();
 };
 
 void Physics2DServerSW::_update_shapes() {
@@ -1282,6 +1411,12 @@ int Physics2DServerSW::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_NARROWPHASE_SOLVED: {
+			return narrowphase_solved;
+		} break;
+		case INFO_NARROWPHASE_CACHED: {
+			return narrowphase_cached;
+		} break;
 	}
 
 	return 0;
@@ -1298,6 +1433,8 @@ Physics2DServerSW::Physics2DServerSW() {
 	GLOBAL_DEF("physics/2d/large_object_surface_threshold_in_cells", 512);
 	GLOBAL_DEF("physics/2d/bvh_collision_margin", 1.0);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/bvh_collision_margin", PropertyInfo(Variant::REAL, "physics/2d/bvh_collision_margin", PROPERTY_HINT_RANGE, "0.0,20.0,0.1"));
+	GLOBAL_DEF_RST("physics/2d/integration_thread_count", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/integration_thread_count", PropertyInfo(Variant::INT, "physics/2d/integration_thread_count", PROPERTY_HINT_RANGE, "-1,64,1"));
 
 	bool use_bvh = GLOBAL_GET("physics/2d/use_bvh");
 
@@ -1311,12 +1448,15 @@ Physics2DServerSW::Physics2DServerSW() {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	narrowphase_solved = 0;
+	narrowphase_cached = 0;
 #ifdef NO_THREADS
 	using_threads = false;
 #else
 	using_threads = int(GLOBAL_GET("physics/2d/thread_model")) == 2;
 #endif
 	flushing_queries = false;
+	step_pass = 0;
 };
 
 Physics2DServerSW::~Physics2DServerSW(){
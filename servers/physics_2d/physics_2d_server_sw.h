@@ -4,6 +4,7 @@
 /*  physics_2d_server_sw.h                                               */
 
 
+#include "core/os/rw_lock.h"
 #include "joints_2d_sw.h"
 #include "servers/physics_2d_server.h"
 #include "shape_2d_sw.h"
@@ -14,6 +15,8 @@ class Physics2DServerSW : public Physics2DServer {
 	GDCLASS(Physics2DServerSW, Physics2DServer);
 
 	friend class Physics2DDirectSpaceStateSW;
+	friend class Physics2DDirectSpaceStateSnapshotSW;
+	friend class Space2DSnapshotSW;
 	friend class Physics2DDirectBodyStateSW;
 	bool active;
 	int iterations;
@@ -22,6 +25,8 @@ class Physics2DServerSW : public Physics2DServer {
 	int island_count;
 	int active_objects;
 	int collision_pairs;
+	int narrowphase_solved;
+	int narrowphase_cached;
 
 	bool using_threads;
 
@@ -36,6 +41,24 @@ class Physics2DServerSW : public Physics2DServer {
 	mutable RID_Owner<Body2DSW> body_owner;
 	mutable RID_Owner<Joint2DSW> joint_owner;
 
+	// Snapshot queries look shapes and spaces up from other threads.
+	RWLock query_owner_lock;
+
+	struct PendingShapeFree {
+		Shape2DSW *shape;
+		uint64_t pass;
+	};
+
+	uint64_t step_pass;
+	RBSet<Space2DSW *> snapshot_spaces;
+	LocalVector<PendingShapeFree> pending_shape_frees; // Shapes that published snapshots may still use.
+
+	static Shape2DSW *_create_shape(ShapeType p_shape);
+	Shape2DSW *_get_snapshot_shape(Shape2DSW *p_shape);
+	void _retire_snapshot_shape(Shape2DSW *p_shape);
+	void _publish_snapshots();
+	Shape2DSW *_get_query_shape(RID p_shape);
+
 	static Physics2DServerSW *singletonsw;
 
 	//void _clear_query(Query2DSW *p_query);
@@ -91,6 +114,7 @@ public:
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual Physics2DDirectSpaceState *space_get_direct_state(RID p_space);
+	virtual Physics2DDirectSpaceState *space_get_snapshot_state(RID p_space);
 
 	/* AREA API */
 
@@ -85,6 +85,11 @@ public:
 		return physics_2d_server->space_get_direct_state(p_space);
 	}
 
+	// Snapshots are immutable once published, so this one works from any thread.
+	Physics2DDirectSpaceState *space_get_snapshot_state(RID p_space) {
+		return physics_2d_server->space_get_snapshot_state(p_space);
+	}
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<Vector2>());
@@ -10,6 +10,7 @@
 void Shape2DSW::configure(const Rect2 &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
+	version++;
 	for (RBMap<ShapeOwner2DSW *, int>::Element *E = owners.front(); E; E = E->next()) {
 		ShapeOwner2DSW *co = (ShapeOwner2DSW *)E->key();
 		co->_shape_changed();
@@ -52,9 +53,14 @@ const RBMap<ShapeOwner2DSW *, int> &Shape2DSW::get_owners() const {
 Shape2DSW::Shape2DSW() {
 	custom_bias = 0;
 	configured = false;
+	version = 0;
+	snapshot_shape = nullptr;
 }
 
 Shape2DSW::~Shape2DSW() {
+	if (snapshot_shape) {
+		memdelete(snapshot_shape);
+	}
 	ERR_FAIL_COND(owners.size());
 }
 
@@ -34,6 +34,8 @@ class Shape2DSW : public RID_Data {
 	Rect2 aabb;
 	bool configured;
 	real_t custom_bias;
+	uint32_t version; // Bumped every time the shape data changes.
+	Shape2DSW *snapshot_shape; // Copy of the shape that space snapshots reference, see Physics2DServerSW::_get_snapshot_shape().
 
 	RBMap<ShapeOwner2DSW *, int> owners;
 
@@ -48,6 +50,10 @@ public:
 
 	_FORCE_INLINE_ Rect2 get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
+	_FORCE_INLINE_ uint32_t get_version() const { return version; }
+
+	_FORCE_INLINE_ void set_snapshot_shape(Shape2DSW *p_shape) { snapshot_shape = p_shape; }
+	_FORCE_INLINE_ Shape2DSW *get_snapshot_shape() const { return snapshot_shape; }
 
 	virtual bool is_concave() const { return false; }
 
@@ -0,0 +1,622 @@
+
+/*  space_2d_snapshot_sw.cpp                                             */
+
+
+#include "space_2d_snapshot_sw.h"
+
+#include "body_2d_sw.h"
+#include "collision_solver_2d_sw.h"
+#include "core/containers/sort_array.h"
+#include "physics_2d_server_sw.h"
+#include "space_2d_sw.h"
+
+#define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+#define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+
+void Space2DSnapshotSW::_build_tree(uint32_t p_first, uint32_t p_count, uint32_t p_depth) {
+	uint32_t node_index = nodes.size();
+	nodes.push_back(TreeNode());
+
+	Rect2 aabb = build_shapes[build_entries[p_first].shape].aabb;
+	Rect2 center_bounds(build_entries[p_first].center, Vector2());
+	for (uint32_t i = p_first + 1; i < p_first + p_count; i++) {
+		aabb = aabb.merge(build_shapes[build_entries[i].shape].aabb);
+		center_bounds.expand_to(build_entries[i].center);
+	}
+	nodes[node_index].aabb = aabb;
+
+	if (p_count <= LEAF_SIZE_MAX || p_depth >= TREE_DEPTH_MAX - 1) {
+		nodes[node_index].first = p_first;
+		nodes[node_index].count = p_count;
+		return;
+	}
+
+	// Median split along the longest axis of the shape centers.
+	SortArray<BuildEntry, BuildEntryComparator> sorter;
+	sorter.compare.axis = center_bounds.size.x >= center_bounds.size.y ? 0 : 1;
+
+	uint32_t half = p_count / 2;
+	sorter.nth_element(p_first, p_first + p_count, p_first + half, build_entries.ptr());
+
+	_build_tree(p_first, half, p_depth + 1);
+
+	nodes[node_index].first = nodes.size();
+	nodes[node_index].count = 0;
+
+	_build_tree(p_first + half, p_count - half, p_depth + 1);
+}
+
+int Space2DSnapshotSW::cull_aabb(const Rect2 &p_aabb, uint32_t *r_results, int p_result_max) const {
+	if (nodes.empty()) {
+		return 0;
+	}
+
+	uint32_t stack[TREE_DEPTH_MAX * 2];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	int amount = 0;
+
+	while (stack_size) {
+		uint32_t node_index = stack[--stack_size];
+		const TreeNode &node = nodes[node_index];
+
+		if (!node.aabb.intersects(p_aabb)) {
+			continue;
+		}
+
+		if (node.count) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				if (!shapes[i].aabb.intersects(p_aabb)) {
+					continue;
+				}
+				if (amount >= p_result_max) {
+					return amount;
+				}
+				r_results[amount++] = i;
+			}
+		} else {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node_index + 1;
+		}
+	}
+
+	return amount;
+}
+
+int Space2DSnapshotSW::cull_segment(const Vector2 &p_from, const Vector2 &p_to, uint32_t *r_results, int p_result_max) const {
+	if (nodes.empty()) {
+		return 0;
+	}
+
+	uint32_t stack[TREE_DEPTH_MAX * 2];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	int amount = 0;
+
+	while (stack_size) {
+		uint32_t node_index = stack[--stack_size];
+		const TreeNode &node = nodes[node_index];
+
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				if (!shapes[i].aabb.intersects_segment(p_from, p_to)) {
+					continue;
+				}
+				if (amount >= p_result_max) {
+					return amount;
+				}
+				r_results[amount++] = i;
+			}
+		} else {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node_index + 1;
+		}
+	}
+
+	return amount;
+}
+
+void Space2DSnapshotSW::build(const Space2DSW *p_space, uint64_t p_pass) {
+	build_shapes.clear();
+
+	const RBSet<CollisionObject2DSW *> &objects = p_space->get_objects();
+	for (const RBSet<CollisionObject2DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		const CollisionObject2DSW *col_obj = E->get();
+
+		for (int i = 0; i < col_obj->get_shape_count(); i++) {
+			if (col_obj->is_shape_disabled(i)) {
+				continue; // Not in the broadphase either.
+			}
+
+			Shape s;
+			s.aabb = col_obj->get_shape_aabb(i);
+			s.xform = col_obj->get_transform() * col_obj->get_shape_transform(i);
+			s.inv_xform = col_obj->get_shape_inv_transform(i) * col_obj->get_inv_transform();
+			s.shape = Physics2DServerSW::singletonsw->_get_snapshot_shape(col_obj->get_shape(i));
+			s.rid = col_obj->get_self();
+			s.instance_id = col_obj->get_instance_id();
+			s.canvas_instance_id = col_obj->get_canvas_instance_id();
+			s.collision_layer = col_obj->get_collision_layer();
+			s.shape_index = i;
+			s.type = col_obj->get_type();
+			s.pickable = col_obj->is_pickable();
+			s.metadata = col_obj->get_shape_metadata(i);
+
+			if (s.type == CollisionObject2DSW::TYPE_BODY) {
+				const Body2DSW *body = static_cast<const Body2DSW *>(col_obj);
+				s.origin = body->get_transform().get_origin();
+				s.linear_velocity = body->get_linear_velocity();
+				s.angular_velocity = body->get_angular_velocity();
+			} else {
+				s.angular_velocity = 0;
+			}
+
+			build_shapes.push_back(s);
+		}
+	}
+
+	pass = p_pass;
+
+	uint32_t shape_count = build_shapes.size();
+
+	build_entries.resize(shape_count);
+	for (uint32_t i = 0; i < shape_count; i++) {
+		build_entries[i].center = build_shapes[i].aabb.position + build_shapes[i].aabb.size * 0.5;
+		build_entries[i].shape = i;
+	}
+
+	nodes.clear();
+	if (shape_count) {
+		_build_tree(0, shape_count, 0);
+	}
+
+	// Store the shapes in tree order, so leaves read contiguous memory.
+	shapes.resize(shape_count);
+	for (uint32_t i = 0; i < shape_count; i++) {
+		shapes[i] = build_shapes[build_entries[i].shape];
+	}
+}
+
+void Space2DSnapshotSW::clear() {
+	shapes.clear();
+	nodes.clear();
+	pass = UINT64_MAX;
+}
+
+Space2DSnapshotSW::Space2DSnapshotSW() {
+	pass = UINT64_MAX; // Never built, so it doesn't reference any shape.
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Keeps the published snapshot of a space from being rebuilt while a query reads it.
+class Space2DSnapshotReadSW {
+	Space2DSW *space;
+	uint32_t index;
+	const Space2DSnapshotSW *snapshot;
+
+public:
+	_FORCE_INLINE_ const Space2DSnapshotSW *operator->() const { return snapshot; }
+	_FORCE_INLINE_ const Space2DSnapshotSW *get() const { return snapshot; }
+
+	Space2DSnapshotReadSW(Space2DSW *p_space) {
+		space = p_space;
+		snapshot = space->lock_snapshot(index);
+	}
+	~Space2DSnapshotReadSW() {
+		space->unlock_snapshot(index);
+	}
+};
+
+_FORCE_INLINE_ static bool _can_collide_with(const Space2DSnapshotSW::Shape &p_shape, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	if (!(p_shape.collision_layer & p_collision_mask)) {
+		return false;
+	}
+
+	if (p_shape.type == CollisionObject2DSW::TYPE_AREA && !p_collide_with_areas) {
+		return false;
+	}
+
+	if (p_shape.type == CollisionObject2DSW::TYPE_BODY && !p_collide_with_bodies) {
+		return false;
+	}
+
+	return true;
+}
+
+int Physics2DDirectSpaceStateSnapshotSW::_intersect_point_impl(const Space2DSnapshotSW *p_snapshot, const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point, bool p_filter_by_canvas, ObjectID p_canvas_instance_id) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	Rect2 aabb;
+	aabb.position = p_point - Vector2(0.00001, 0.00001);
+	aabb.size = Vector2(0.00002, 0.00002);
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = p_snapshot->cull_aabb(aabb, results, INTERSECTION_QUERY_MAX);
+
+	int cc = 0;
+
+	for (int i = 0; i < amount; i++) {
+		const Space2DSnapshotSW::Shape &s = p_snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue;
+		}
+
+		if (p_pick_point && !s.pickable) {
+			continue;
+		}
+
+		if (p_filter_by_canvas && s.canvas_instance_id != p_canvas_instance_id) {
+			continue;
+		}
+
+		if (!s.shape->contains_point(s.inv_xform.xform(p_point))) {
+			continue;
+		}
+
+		if (cc >= p_result_max) {
+			continue;
+		}
+
+		r_results[cc].collider_id = s.instance_id;
+		if (r_results[cc].collider_id != 0) {
+			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+		}
+		r_results[cc].rid = s.rid;
+		r_results[cc].shape = s.shape_index;
+		r_results[cc].metadata = s.metadata;
+
+		cc++;
+	}
+
+	return cc;
+}
+
+int Physics2DDirectSpaceStateSnapshotSW::intersect_point(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point) {
+	Space2DSnapshotReadSW snapshot(space);
+	return _intersect_point_impl(snapshot.get(), p_point, r_results, p_result_max, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_point);
+}
+
+int Physics2DDirectSpaceStateSnapshotSW::intersect_point_on_canvas(const Vector2 &p_point, ObjectID p_canvas_instance_id, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point) {
+	Space2DSnapshotReadSW snapshot(space);
+	return _intersect_point_impl(snapshot.get(), p_point, r_results, p_result_max, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_point, true, p_canvas_instance_id);
+}
+
+bool Physics2DDirectSpaceStateSnapshotSW::intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	Space2DSnapshotReadSW snapshot(space);
+
+	Vector2 normal = (p_to - p_from).normalized();
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = snapshot->cull_segment(p_from, p_to, results, INTERSECTION_QUERY_MAX);
+
+	bool collided = false;
+	Vector2 res_point, res_normal;
+	const Space2DSnapshotSW::Shape *res_shape = nullptr;
+	real_t min_d = 1e10;
+
+	for (int i = 0; i < amount; i++) {
+		const Space2DSnapshotSW::Shape &s = snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue;
+		}
+
+		Vector2 local_from = s.inv_xform.xform(p_from);
+		Vector2 local_to = s.inv_xform.xform(p_to);
+
+		Vector2 shape_point, shape_normal;
+
+		if (s.shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+			shape_point = s.xform.xform(shape_point);
+
+			real_t ld = normal.dot(shape_point);
+
+			if (ld < min_d) {
+				min_d = ld;
+				res_point = shape_point;
+				res_normal = s.inv_xform.basis_xform_inv(shape_normal).normalized();
+				res_shape = &s;
+				collided = true;
+			}
+		}
+	}
+
+	if (!collided) {
+		return false;
+	}
+
+	r_result.collider_id = res_shape->instance_id;
+	if (r_result.collider_id != 0) {
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	}
+	r_result.normal = res_normal;
+	r_result.metadata = res_shape->metadata;
+	r_result.position = res_point;
+	r_result.rid = res_shape->rid;
+	r_result.shape = res_shape->shape_index;
+
+	return true;
+}
+
+int Physics2DDirectSpaceStateSnapshotSW::intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->_get_query_shape(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	Rect2 aabb = p_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+
+	Space2DSnapshotReadSW snapshot(space);
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = snapshot->cull_aabb(aabb, results, INTERSECTION_QUERY_MAX);
+
+	int cc = 0;
+
+	for (int i = 0; i < amount; i++) {
+		if (cc >= p_result_max) {
+			break;
+		}
+
+		const Space2DSnapshotSW::Shape &s = snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue;
+		}
+
+		if (!CollisionSolver2DSW::solve(shape, p_xform, p_motion, s.shape, s.xform, Vector2(), nullptr, nullptr, nullptr, p_margin)) {
+			continue;
+		}
+
+		r_results[cc].collider_id = s.instance_id;
+		if (r_results[cc].collider_id != 0) {
+			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+		}
+		r_results[cc].rid = s.rid;
+		r_results[cc].shape = s.shape_index;
+		r_results[cc].metadata = s.metadata;
+
+		cc++;
+	}
+
+	return cc;
+}
+
+bool Physics2DDirectSpaceStateSnapshotSW::cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->_get_query_shape(p_shape);
+	ERR_FAIL_COND_V(!shape, false);
+
+	Rect2 aabb = p_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+
+	Space2DSnapshotReadSW snapshot(space);
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = snapshot->cull_aabb(aabb, results, INTERSECTION_QUERY_MAX);
+
+	real_t best_safe = 1;
+	real_t best_unsafe = 1;
+
+	for (int i = 0; i < amount; i++) {
+		const Space2DSnapshotSW::Shape &s = snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue; //ignore excluded
+		}
+
+		//test initial overlap, does it collide if going all the way?
+		if (!CollisionSolver2DSW::solve(shape, p_xform, p_motion, s.shape, s.xform, Vector2(), nullptr, nullptr, nullptr, p_margin)) {
+			continue;
+		}
+
+		//test initial overlap, ignore objects it's inside of.
+		if (CollisionSolver2DSW::solve(shape, p_xform, Vector2(), s.shape, s.xform, Vector2(), nullptr, nullptr, nullptr, p_margin)) {
+			continue;
+		}
+
+		Vector2 mnormal = p_motion.normalized();
+
+		//just do kinematic solving, converging like Physics2DDirectSpaceStateSW::cast_motion()
+		real_t low = 0.0;
+		real_t hi = 1.0;
+		real_t fraction_coeff = 0.5;
+		for (int j = 0; j < 8; j++) {
+			real_t fraction = low + (hi - low) * fraction_coeff;
+
+			Vector2 sep = mnormal; //important optimization for this to work fast enough
+			bool collided = CollisionSolver2DSW::solve(shape, p_xform, p_motion * fraction, s.shape, s.xform, Vector2(), nullptr, nullptr, &sep, p_margin);
+
+			if (collided) {
+				hi = fraction;
+				fraction_coeff = ((j == 0) || (low > 0.0)) ? 0.5 : 0.25;
+			} else {
+				low = fraction;
+				fraction_coeff = ((j == 0) || (hi < 1.0)) ? 0.5 : 0.75;
+			}
+		}
+
+		if (low < best_safe) {
+			best_safe = low;
+			best_unsafe = hi;
+		}
+	}
+
+	p_closest_safe = best_safe;
+	p_closest_unsafe = best_unsafe;
+
+	return true;
+}
+
+bool Physics2DDirectSpaceStateSnapshotSW::collide_shape(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	if (p_result_max <= 0) {
+		return false;
+	}
+
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->_get_query_shape(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	Rect2 aabb = p_shape_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+
+	Space2DSnapshotReadSW snapshot(space);
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = snapshot->cull_aabb(aabb, results, INTERSECTION_QUERY_MAX);
+
+	bool collided = false;
+	r_result_count = 0;
+
+	Physics2DServerSW::CollCbkData cbk;
+	cbk.max = p_result_max;
+	cbk.amount = 0;
+	cbk.passed = 0;
+	cbk.ptr = r_results;
+	CollisionSolver2DSW::CallbackResult cbkres = Physics2DServerSW::_shape_col_cbk;
+
+	Physics2DServerSW::CollCbkData *cbkptr = &cbk;
+
+	for (int i = 0; i < amount; i++) {
+		const Space2DSnapshotSW::Shape &s = snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue;
+		}
+
+		cbk.valid_dir = Vector2();
+		cbk.valid_depth = 0;
+
+		if (CollisionSolver2DSW::solve(shape, p_shape_xform, p_motion, s.shape, s.xform, Vector2(), cbkres, cbkptr, nullptr, p_margin)) {
+			collided = cbk.amount > 0;
+		}
+	}
+
+	r_result_count = cbk.amount;
+
+	return collided;
+}
+
+struct _SnapshotRestCallbackData2D {
+	const Space2DSnapshotSW::Shape *shape;
+	const Space2DSnapshotSW::Shape *best_shape;
+	Vector2 best_contact;
+	Vector2 best_normal;
+	real_t best_len;
+	real_t min_allowed_depth;
+};
+
+static void _snapshot_rest_cbk_result(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_userdata) {
+	_SnapshotRestCallbackData2D *rd = (_SnapshotRestCallbackData2D *)p_userdata;
+
+	Vector2 contact_rel = p_point_B - p_point_A;
+	real_t len = contact_rel.length();
+
+	if (len < rd->min_allowed_depth) {
+		return;
+	}
+
+	if (len <= rd->best_len) {
+		return;
+	}
+
+	rd->best_len = len;
+	rd->best_contact = p_point_B;
+	rd->best_normal = contact_rel / len;
+	rd->best_shape = rd->shape;
+}
+
+bool Physics2DDirectSpaceStateSnapshotSW::rest_info(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, ShapeRestInfo *r_info, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->_get_query_shape(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	real_t margin = MAX(p_margin, TEST_MOTION_MARGIN_MIN_VALUE);
+
+	Rect2 aabb = p_shape_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(margin);
+
+	Space2DSnapshotReadSW snapshot(space);
+
+	uint32_t results[INTERSECTION_QUERY_MAX];
+	int amount = snapshot->cull_aabb(aabb, results, INTERSECTION_QUERY_MAX);
+
+	_SnapshotRestCallbackData2D rcd;
+	rcd.best_len = 0;
+	rcd.best_shape = nullptr;
+	rcd.min_allowed_depth = margin * TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR;
+
+	for (int i = 0; i < amount; i++) {
+		const Space2DSnapshotSW::Shape &s = snapshot->get_shape(results[i]);
+
+		if (!_can_collide_with(s, p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+			continue;
+		}
+
+		if (p_exclude.has(s.rid)) {
+			continue;
+		}
+
+		rcd.shape = &s;
+		CollisionSolver2DSW::solve(shape, p_shape_xform, p_motion, s.shape, s.xform, Vector2(), _snapshot_rest_cbk_result, &rcd, nullptr, margin);
+	}
+
+	if (rcd.best_len == 0 || !rcd.best_shape) {
+		return false;
+	}
+
+	const Space2DSnapshotSW::Shape &best = *rcd.best_shape;
+
+	r_info->collider_id = best.instance_id;
+	r_info->shape = best.shape_index;
+	r_info->normal = rcd.best_normal;
+	r_info->point = rcd.best_contact;
+	r_info->rid = best.rid;
+	r_info->metadata = best.metadata;
+	if (best.type == CollisionObject2DSW::TYPE_BODY) {
+		Vector2 rel_vec = r_info->point - best.origin;
+		r_info->linear_velocity = Vector2(-best.angular_velocity * rel_vec.y, best.angular_velocity * rel_vec.x) + best.linear_velocity;
+	} else {
+		r_info->linear_velocity = Vector2();
+	}
+
+	return true;
+}
+
+Physics2DDirectSpaceStateSnapshotSW::Physics2DDirectSpaceStateSnapshotSW() {
+	space = nullptr;
+}
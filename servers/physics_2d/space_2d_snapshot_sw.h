@@ -0,0 +1,115 @@
+#ifndef SPACE_2D_SNAPSHOT_SW_H
+#define SPACE_2D_SNAPSHOT_SW_H
+
+/*  space_2d_snapshot_sw.h                                               */
+
+
+#include "collision_object_2d_sw.h"
+#include "core/containers/local_vector.h"
+#include "servers/physics_2d_server.h"
+
+class Space2DSW;
+
+/**
+	Read-only copy of the shapes of a space, taken after a physics step.
+
+	Each entry holds everything the space queries need (bounds, global transform,
+	filtering data), so nothing in it points back to the collision objects. The
+	entries are kept in a static bounding volume tree built once per snapshot.
+*/
+
+class Space2DSnapshotSW {
+public:
+	struct Shape {
+		Rect2 aabb;
+		Transform2D xform;
+		Transform2D inv_xform;
+		const Shape2DSW *shape; // Copy owned by the server, never modified, see Physics2DServerSW::_get_snapshot_shape().
+		RID rid;
+		ObjectID instance_id;
+		ObjectID canvas_instance_id;
+		uint32_t collision_layer;
+		int shape_index;
+		CollisionObject2DSW::Type type;
+		bool pickable;
+
+		// Bodies only, to report the velocity at the contact point in rest_info().
+		Vector2 origin;
+		Vector2 linear_velocity;
+		real_t angular_velocity;
+
+		Variant metadata;
+	};
+
+private:
+	struct TreeNode {
+		Rect2 aabb;
+		uint32_t first; // First shape for leaves, right child for internal nodes (the left one follows its parent).
+		uint32_t count; // Zero for internal nodes.
+	};
+
+	struct BuildEntry {
+		Vector2 center;
+		uint32_t shape;
+	};
+
+	struct BuildEntryComparator {
+		int axis = 0;
+		_FORCE_INLINE_ bool operator()(const BuildEntry &p_a, const BuildEntry &p_b) const { return p_a.center[axis] < p_b.center[axis]; }
+	};
+
+	enum {
+		LEAF_SIZE_MAX = 4,
+		TREE_DEPTH_MAX = 64,
+	};
+
+	LocalVector<Shape> shapes;
+	LocalVector<TreeNode> nodes;
+	LocalVector<BuildEntry> build_entries;
+	LocalVector<Shape> build_shapes;
+
+	uint64_t pass;
+
+	void _build_tree(uint32_t p_first, uint32_t p_count, uint32_t p_depth);
+
+public:
+	// Cull functions return indices into the snapshot shapes.
+	int cull_aabb(const Rect2 &p_aabb, uint32_t *r_results, int p_result_max) const;
+	int cull_segment(const Vector2 &p_from, const Vector2 &p_to, uint32_t *r_results, int p_result_max) const;
+
+	_FORCE_INLINE_ const Shape &get_shape(uint32_t p_index) const { return shapes[p_index]; }
+	_FORCE_INLINE_ uint32_t get_shape_count() const { return shapes.size(); }
+
+	// Physics step the snapshot was taken on.
+	_FORCE_INLINE_ uint64_t get_pass() const { return pass; }
+
+	void build(const Space2DSW *p_space, uint64_t p_pass);
+	void clear();
+
+	Space2DSnapshotSW();
+};
+
+class Physics2DDirectSpaceStateSnapshotSW : public Physics2DDirectSpaceState {
+	GDCLASS(Physics2DDirectSpaceStateSnapshotSW, Physics2DDirectSpaceState);
+
+	enum {
+		INTERSECTION_QUERY_MAX = 2048
+	};
+
+	int _intersect_point_impl(const Space2DSnapshotSW *p_snapshot, const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point, bool p_filter_by_canvas = false, ObjectID p_canvas_instance_id = 0);
+
+public:
+	Space2DSW *space;
+
+	virtual int intersect_point(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_point = false);
+	virtual int intersect_point_on_canvas(const Vector2 &p_point, ObjectID p_canvas_instance_id, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_point = false);
+	virtual bool intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual bool cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual bool collide_shape(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual bool rest_info(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, ShapeRestInfo *r_info, const RBSet<RID> &p_exclude = RBSet<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+
+	Physics2DDirectSpaceStateSnapshotSW();
+};
+
+#endif // SPACE_2D_SNAPSHOT_SW_H
@@ -1379,8 +1379,69 @@ Physics2DDirectSpaceStateSW *Space2DSW::get_direct_state() {
 	return direct_access;
 }
 
+Physics2DDirectSpaceStateSnapshotSW *Space2DSW::get_snapshot_state() {
+	// Snapshots are only taken for spaces that are queried this way, starting with the next step.
+	snapshot_requested.set();
+	return snapshot_access;
+}
+
+// The front switch and the reader counts form a store / load pair on each side (see lock_snapshot()),
+// the full fences make sure a reader and the publisher can't both miss the other's write.
+
+bool Space2DSW::publish_snapshot(uint64_t p_pass) {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	uint32_t back = 1 - snapshot_front.get();
+	if (snapshot_readers[back].get() > 0) {
+		return false; // Still read by a query that started before the last publish, keep the current snapshot one more step.
+	}
+
+	snapshots[back].build(this, p_pass);
+	snapshot_front.set(back);
+	return true;
+}
+
+void Space2DSW::reset_snapshots() {
+	// Empties both buffers in turn, waiting for the queries still reading them.
+	for (int i = 0; i < 2; i++) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		uint32_t back = 1 - snapshot_front.get();
+		while (snapshot_readers[back].get() > 0) {
+			OS::get_singleton()->delay_usec(1);
+		}
+
+		snapshots[back].clear();
+		snapshot_front.set(back);
+	}
+}
+
+uint64_t Space2DSW::get_snapshot_oldest_pass() const {
+	return MIN(snapshots[0].get_pass(), snapshots[1].get_pass());
+}
+
+const Space2DSnapshotSW *Space2DSW::lock_snapshot(uint32_t &r_index) {
+	while (true) {
+		uint32_t index = snapshot_front.get();
+		snapshot_readers[index].increment();
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// If the front changed meanwhile, the buffer may be getting rebuilt, try again with the new front.
+		if (snapshot_front.get() == index) {
+			r_index = index;
+			return &snapshots[index];
+		}
+
+		snapshot_readers[index].decrement();
+	}
+}
+
+void Space2DSW::unlock_snapshot(uint32_t p_index) {
+	snapshot_readers[p_index].decrement();
+}
+
 Space2DSW::Space2DSW() {
 	collision_pairs = 0;
+	narrowphase_solved = 0;
+	narrowphase_cached = 0;
 	active_objects = 0;
 	island_count = 0;
 
@@ -1405,6 +1466,9 @@ Space2DSW::Space2DSW() {
 	direct_access = memnew(Physics2DDirectSpaceStateSW);
 	direct_access->space = this;
 
+	snapshot_access = memnew(Physics2DDirectSpaceStateSnapshotSW);
+	snapshot_access->space = this;
+
 	for (int i = 0; i < ELAPSED_TIME_MAX; i++) {
 		elapsed_time[i] = 0;
 	}
@@ -1413,4 +1477,5 @@ Space2DSW::Space2DSW() {
 Space2DSW::~Space2DSW() {
 	memdelete(broadphase);
 	memdelete(direct_access);
+	memdelete(snapshot_access);
 }
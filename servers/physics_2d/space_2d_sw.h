@@ -12,7 +12,9 @@
 #include "collision_object_2d_sw.h"
 #include "core/containers/hash_map.h"
 #include "core/config/project_settings.h"
+#include "core/os/safe_refcount.h"
 #include "core/typedefs.h"
+#include "space_2d_snapshot_sw.h"
 
 class Physics2DDirectSpaceStateSW : public Physics2DDirectSpaceState {
 	GDCLASS(Physics2DDirectSpaceStateSW, Physics2DDirectSpaceState);
@@ -57,6 +59,13 @@ private:
 	Physics2DDirectSpaceStateSW *direct_access;
 	RID self;
 
+	// Published after each step for queries from other threads, see publish_snapshot().
+	Physics2DDirectSpaceStateSnapshotSW *snapshot_access;
+	Space2DSnapshotSW snapshots[2];
+	SafeNumeric<uint32_t> snapshot_readers[2];
+	SafeNumeric<uint32_t> snapshot_front;
+	SafeFlag snapshot_requested;
+
 	BroadPhase2DSW *broadphase;
 	SelfList<Body2DSW>::List active_list;
 	SelfList<Body2DSW>::List inertia_update_list;
@@ -94,6 +103,8 @@ private:
 	int island_count;
 	int active_objects;
 	int collision_pairs;
+	int narrowphase_solved;
+	int narrowphase_cached;
 
 	int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb);
 
@@ -160,6 +171,16 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	// Body pairs that ran the narrowphase this step, and the ones that reused their previous result.
+	void reset_narrowphase_counters() {
+		narrowphase_solved = 0;
+		narrowphase_cached = 0;
+	}
+	_FORCE_INLINE_ void add_narrowphase_solved() { narrowphase_solved++; }
+	_FORCE_INLINE_ void add_narrowphase_cached() { narrowphase_cached++; }
+	int get_narrowphase_solved() const { return narrowphase_solved; }
+	int get_narrowphase_cached() const { return narrowphase_cached; }
+
 	bool test_body_motion(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes = true, const RBSet<RID> &p_exclude = RBSet<RID>());
 	int test_body_ray_separation(Body2DSW *p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, Physics2DServer::SeparationResult *r_results, int p_result_max, real_t p_margin);
 
@@ -175,6 +196,14 @@ public:
 
 	Physics2DDirectSpaceStateSW *get_direct_state();
 
+	Physics2DDirectSpaceStateSnapshotSW *get_snapshot_state();
+	_FORCE_INLINE_ bool is_snapshot_requested() const { return snapshot_requested.is_set(); }
+	bool publish_snapshot(uint64_t p_pass);
+	void reset_snapshots();
+	uint64_t get_snapshot_oldest_pass() const;
+	const Space2DSnapshotSW *lock_snapshot(uint32_t &r_index);
+	void unlock_snapshot(uint32_t p_index);
+
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
@@ -3,6 +3,7 @@
 
 
 #include "step_2d_sw.h"
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
@@ -102,10 +103,42 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 	}
 }
 
+void Step2DSW::_integrate_forces_chunk(uint32_t p_chunk, real_t p_delta) {
+	uint32_t from = p_chunk * INTEGRATION_CHUNK_SIZE;
+	uint32_t to = MIN(from + INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t i = from; i < to; i++) {
+		active_bodies[i]->integrate_forces(p_delta);
+	}
+}
+
+void Step2DSW::_integrate_velocities_chunk(uint32_t p_chunk, real_t p_delta) {
+	uint32_t from = p_chunk * INTEGRATION_CHUNK_SIZE;
+	uint32_t to = MIN(from + INTEGRATION_CHUNK_SIZE, active_bodies.size());
+	for (uint32_t i = from; i < to; i++) {
+		active_bodies[i]->integrate_velocities(p_delta);
+	}
+}
+
+void Step2DSW::_integrate(void (Step2DSW::*p_method)(uint32_t, real_t), real_t p_delta) {
+	uint32_t chunk_count = (active_bodies.size() + INTEGRATION_CHUNK_SIZE - 1) / INTEGRATION_CHUNK_SIZE;
+
+	if (active_bodies.size() >= INTEGRATION_THREADING_THRESHOLD && work_pool_size != 0) {
+		if (work_pool.get_thread_count() == 0) {
+			work_pool.init(work_pool_size);
+		}
+		work_pool.do_work(chunk_count, this, p_method, p_delta);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			(this->*p_method)(i, p_delta);
+		}
+	}
+}
+
 void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	p_space->lock(); // can't access space during this
 	p_space->set_step(p_delta);
 	p_space->setup(); //update inertias, etc
+	p_space->reset_narrowphase_counters();
 
 	const SelfList<Body2DSW>::List *body_list = &p_space->get_active_body_list();
 
@@ -114,16 +147,21 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	active_bodies.clear();
 
 	const SelfList<Body2DSW> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
 	}
 
-	p_space->set_active_objects(active_count);
+	_integrate(&Step2DSW::_integrate_forces_chunk, p_delta);
+
+	for (uint32_t i = 0; i < active_bodies.size(); i++) {
+		active_bodies[i]->integrate_forces_finish();
+	}
+
+	p_space->set_active_objects(active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -248,11 +286,18 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* INTEGRATE VELOCITIES */
 
+	// Gathered again, solving may have woken bodies up.
+	active_bodies.clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<Body2DSW> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	_integrate(&Step2DSW::_integrate_velocities_chunk, p_delta);
+
+	for (uint32_t i = 0; i < active_bodies.size(); i++) {
+		active_bodies[i]->integrate_velocities_finish(); // May shut the body down, the array isn't affected.
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -277,4 +322,9 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 Step2DSW::Step2DSW() {
 	_step = 1;
+	work_pool_size = GLOBAL_GET("physics/2d/integration_thread_count");
+}
+
+Step2DSW::~Step2DSW() {
+	work_pool.finish();
 }
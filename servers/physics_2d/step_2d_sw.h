@@ -4,11 +4,28 @@
 /*  step_2d_sw.h                                                         */
 
 
+#include "core/containers/local_vector.h"
+#include "core/os/thread_work_pool.h"
 #include "space_2d_sw.h"
 
 class Step2DSW {
+	enum {
+		INTEGRATION_CHUNK_SIZE = 256,
+		INTEGRATION_THREADING_THRESHOLD = 2048, // Spaces with fewer active bodies are integrated on the calling thread.
+	};
+
 	uint64_t _step;
 
+	// Active bodies of the space being stepped, gathered once so integration can be split in chunks.
+	LocalVector<Body2DSW *> active_bodies;
+
+	ThreadWorkPool work_pool;
+	int work_pool_size;
+
+	void _integrate_forces_chunk(uint32_t p_chunk, real_t p_delta);
+	void _integrate_velocities_chunk(uint32_t p_chunk, real_t p_delta);
+	void _integrate(void (Step2DSW::*p_method)(uint32_t, real_t), real_t p_delta);
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
 	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
 	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
@@ -17,6 +34,7 @@ class Step2DSW {
 public:
 	void step(Space2DSW *p_space, real_t p_delta, int p_iterations);
 	Step2DSW();
+	~Step2DSW();
 };
 
 #endif // STEP_2D_SW_H
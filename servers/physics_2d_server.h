@@ -241,6 +241,8 @@ public:
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual Physics2DDirectSpaceState *space_get_direct_state(RID p_space) = 0;
+	// reads the state published after the last physics step, can be used from any thread
+	virtual Physics2DDirectSpaceState *space_get_snapshot_state(RID p_space) = 0;
 
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) = 0;
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
@@ -538,7 +540,9 @@ public:
 
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_NARROWPHASE_SOLVED,
+		INFO_NARROWPHASE_CACHED
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
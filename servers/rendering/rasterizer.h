@@ -79,6 +79,8 @@ public:
 	virtual void shader_get_custom_defines(RID p_shader, Vector<String> *p_defines) const = 0;
 	virtual void shader_remove_custom_define(RID p_shader, const String &p_define) = 0;
 
+	virtual void shader_warm_up(RID p_shader) = 0;
+
 	virtual void set_shader_async_hidden_forbidden(bool p_forbidden) = 0;
 	virtual bool is_shader_async_hidden_forbidden() = 0;
 
@@ -5,6 +5,7 @@
 #include "core/config/project_settings.h"
 
 #include "core/containers/fixed_array.h"
+#include "core/containers/sort_array.h"
 #include "core/math/transform_interpolator.h"
 
 #include "rendering_server_canvas.h"
@@ -64,6 +65,31 @@ void _collect_ysort_children(RenderingServerCanvas::Item *p_canvas_item, Transfo
 	}
 }
 
+void _refresh_ysort_children(RenderingServerCanvas::Item *p_canvas_item, Transform2D p_transform, RenderingServerCanvas::Item *p_material_owner, const Color p_modulate, int &r_index) {
+	// Same walk as _collect_ysort_children(), for when the set of children is known.
+	int child_item_count = p_canvas_item->child_items.size();
+	RenderingServerCanvas::Item **child_items = p_canvas_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		if (child_items[i]->visible) {
+			child_items[i]->ysort_modulate = p_modulate;
+			child_items[i]->ysort_xform = p_transform;
+			child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform_curr.columns[2]);
+			child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : nullptr;
+			child_items[i]->ysort_index = r_index;
+
+			r_index++;
+
+			if (child_items[i]->sort_y) {
+				_refresh_ysort_children(child_items[i],
+						p_transform * child_items[i]->xform_curr,
+						child_items[i]->use_parent_material ? p_material_owner : child_items[i],
+						p_modulate * child_items[i]->modulate,
+						r_index);
+			}
+		}
+	}
+}
+
 void _mark_ysort_dirty(RenderingServerCanvas::Item *ysort_owner, RID_Owner<RenderingServerCanvas::Item> &canvas_item_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
@@ -71,6 +97,79 @@ void _mark_ysort_dirty(RenderingServerCanvas::Item *ysort_owner, RID_Owner<Rende
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void RenderingServerCanvas::_update_ysort_children(Item *p_canvas_item, Item *p_material_owner) {
+	LocalVector<Item *> &children = p_canvas_item->ysort_children;
+
+	if (p_canvas_item->ysort_children_count != -1) {
+		// Same children as last frame, refresh their positions and fix up the previous order.
+		// Things rarely move past more than a few neighbours per frame, so it's almost sorted.
+		int count = 0;
+		_refresh_ysort_children(p_canvas_item, Transform2D(), p_material_owner, Color(1, 1, 1, 1), count);
+
+		if (count == (int)children.size()) {
+			ItemPtrSort compare;
+			Item **items = children.ptr();
+			uint32_t shifts_max = children.size() * YSORT_SHIFTS_PER_ITEM_MAX;
+			uint32_t shifts = 0;
+			uint32_t moved = 0;
+
+			for (uint32_t i = 1; i < children.size() && shifts <= shifts_max; i++) {
+				Item *item = items[i];
+				uint32_t j = i;
+				while (j > 0 && compare(item, items[j - 1])) {
+					items[j] = items[j - 1];
+					j--;
+				}
+				if (j != i) {
+					items[j] = item;
+					shifts += i - j;
+					moved++;
+				}
+			}
+
+			if (shifts > shifts_max) {
+				SortArray<Item *, ItemPtrSort> sorter;
+				sorter.sort(items, children.size());
+				moved = children.size();
+			}
+
+			ysort_info.items_sorted += children.size();
+			ysort_info.items_moved += moved;
+			return;
+		}
+	}
+
+	p_canvas_item->ysort_children_count = 0;
+	_collect_ysort_children(p_canvas_item, Transform2D(), p_material_owner, Color(1, 1, 1, 1), nullptr, p_canvas_item->ysort_children_count);
+
+	children.resize(p_canvas_item->ysort_children_count);
+
+	int i = 0;
+	_collect_ysort_children(p_canvas_item, Transform2D(), p_material_owner, Color(1, 1, 1, 1), children.ptr(), i);
+
+	SortArray<Item *, ItemPtrSort> sorter;
+	sorter.sort(children.ptr(), children.size());
+
+	ysort_info.items_sorted += children.size();
+	ysort_info.items_moved += children.size();
+}
+
+void RenderingServerCanvas::ysort_info_end_frame() {
+	ysort_info_final = ysort_info;
+	ysort_info = YSortInfo();
+}
+
+uint64_t RenderingServerCanvas::get_ysort_info(RS::RenderInfo p_info) const {
+	switch (p_info) {
+		case RS::INFO_2D_YSORT_ITEMS_SORTED_IN_FRAME:
+			return ysort_info_final.items_sorted;
+		case RS::INFO_2D_YSORT_ITEMS_MOVED_IN_FRAME:
+			return ysort_info_final.items_moved;
+		default:
+			return 0;
+	}
+}
+
 void RenderingServerCanvas::_make_bound_dirty_reparent(Item *p_item) {
 	MutexLock lock(_bound_mutex);
 	DEV_ASSERT(p_item);
@@ -102,6 +201,11 @@ void RenderingServerCanvas::_make_bound_dirty_reparent(Item *p_item) {
 }
 
 void RenderingServerCanvas::_make_bound_dirty(Item *p_item, bool p_changing_visibility) {
+	if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH) {
+		_cull_index_mark_dirty(p_item);
+		return;
+	}
+
 	if (_canvas_cull_mode != CANVAS_CULL_MODE_NODE) {
 		return;
 	}
@@ -174,6 +278,115 @@ void RenderingServerCanvas::_make_bound_dirty_down(Item *p_item) {
 	}
 }
 
+bool RenderingServerCanvas::_is_cull_index_leaf(const Item *p_item) const {
+	// Items that must be visited even when their own rect is off screen stay out of the tree.
+	return p_item->child_items.empty() && !p_item->clip && !p_item->copy_back_buffer && !p_item->vp_render && !p_item->use_identity_xform && !p_item->update_when_visible;
+}
+
+void RenderingServerCanvas::_cull_index_update_child(ChildCullIndex *p_index, Item *p_child) {
+	if (!_is_cull_index_leaf(p_child)) {
+		if (p_child->cull_handle) {
+			p_index->bvh.erase(p_child->cull_handle - 1);
+			p_child->cull_handle = 0;
+			p_index->indexed_count--;
+		}
+		if (!p_child->cull_unindexed) {
+			p_index->unindexed.push_back(p_child);
+			p_child->cull_unindexed = true;
+		}
+		return;
+	}
+
+	const Rect2 &rect = p_child->get_rect();
+	Rect2 bound = p_child->xform_curr.xform(rect);
+	if (_interpolation_data.interpolation_enabled && p_child->interpolated) {
+		// The previous transform only ever catches up with the current one, so the merged bound stays valid until the next change.
+		bound = bound.merge(p_child->xform_prev.xform(rect));
+	}
+
+	if (p_child->cull_handle) {
+		p_index->bvh.move(p_child->cull_handle - 1, bound);
+		return;
+	}
+
+	if (p_child->cull_unindexed) {
+		p_index->unindexed.remove_unordered(p_index->unindexed.find(p_child));
+		p_child->cull_unindexed = false;
+	}
+
+	p_child->cull_handle = p_index->bvh.create(p_child, true, 0, 1, bound) + 1;
+	p_index->indexed_count++;
+}
+
+void RenderingServerCanvas::_cull_index_mark_dirty(Item *p_item) {
+	if (p_item->cull_dirty) {
+		return;
+	}
+
+	ChildCullIndex *index = nullptr;
+	if (canvas_item_owner.owns(p_item->parent)) {
+		index = canvas_item_owner.get(p_item->parent)->child_cull_index;
+	} else if (canvas_owner.owns(p_item->parent)) {
+		index = canvas_owner.get(p_item->parent)->child_cull_index;
+	}
+
+	if (index) {
+		index->dirty.push_back(p_item);
+		p_item->cull_dirty = true;
+	}
+}
+
+void RenderingServerCanvas::_cull_index_remove_child(ChildCullIndex *p_index, Item *p_child) {
+	if (p_child->cull_handle) {
+		p_index->bvh.erase(p_child->cull_handle - 1);
+		p_child->cull_handle = 0;
+		p_index->indexed_count--;
+	}
+	if (p_child->cull_unindexed) {
+		p_index->unindexed.remove_unordered(p_index->unindexed.find(p_child));
+		p_child->cull_unindexed = false;
+	}
+	if (p_child->cull_dirty) {
+		p_index->dirty.remove_unordered(p_index->dirty.find(p_child));
+		p_child->cull_dirty = false;
+	}
+}
+
+bool RenderingServerCanvas::_cull_index_query(ChildCullIndex *p_index, const Transform2D &p_xform, const Rect2 &p_clip_rect) {
+	if (p_xform.basis_determinant() == 0) {
+		return false; // The clip rect can't be brought to the space of the children.
+	}
+
+	for (uint32_t i = 0; i < p_index->dirty.size(); i++) {
+		p_index->dirty[i]->cull_dirty = false;
+		_cull_index_update_child(p_index, p_index->dirty[i]);
+	}
+	p_index->dirty.clear();
+	p_index->bvh.update();
+
+	// Items are tested by offsetting their final rect by the clip position,
+	// so in final space the visible area starts at the origin.
+	Rect2 local_clip = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size)).grow(1);
+
+	LocalVector<Item *> &results = p_index->results;
+	results.resize(p_index->indexed_count + p_index->unindexed.size());
+
+	int count = 0;
+	if (p_index->indexed_count) {
+		count = p_index->bvh.cull_aabb(local_clip, results.ptr(), p_index->indexed_count, nullptr);
+	}
+	for (uint32_t i = 0; i < p_index->unindexed.size(); i++) {
+		results[count++] = p_index->unindexed[i];
+	}
+	results.resize(count);
+
+	// Back to the drawing order of the parent.
+	SortArray<Item *, ItemIndexSort> sorter;
+	sorter.sort(results.ptr(), results.size());
+
+	return true;
+}
+
 void RenderingServerCanvas::_prepare_tree_bounds(Item *p_root) {
 	Rect2 root_bound;
 	_calculate_canvas_item_bound(p_root, &root_bound);
@@ -410,19 +623,23 @@ void RenderingServerCanvas::_render_canvas_item_cull_by_item(Item *p_canvas_item
 	}
 
 	if (ci->sort_y) {
-		if (ci->ysort_children_count == -1) {
-			ci->ysort_children_count = 0;
-			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), nullptr, ci->ysort_children_count);
+		_update_ysort_children(ci, p_material_owner);
+
+		child_items = ci->ysort_children.ptr();
+		child_item_count = ci->ysort_children.size();
+	} else if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH && child_item_count >= CULL_INDEX_CHILD_COUNT_MIN) {
+		if (!ci->child_cull_index) {
+			ci->child_cull_index = memnew(ChildCullIndex);
+			for (int i = 0; i < child_item_count; i++) {
+				_cull_index_update_child(ci->child_cull_index, child_items[i]);
+			}
 		}
 
-		child_item_count = ci->ysort_children_count;
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
-
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
-
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+		// Only visit the children that can be on screen.
+		if (_cull_index_query(ci->child_cull_index, final_xform, p_clip_rect)) {
+			child_items = ci->child_cull_index->results.ptr();
+			child_item_count = ci->child_cull_index->results.size();
+		}
 	}
 
 	if (ci->z_relative) {
@@ -591,22 +808,10 @@ void RenderingServerCanvas::_render_canvas_item_cull_by_node(Item *p_canvas_item
 	}
 
 	if (ci->sort_y) {
-		if (ci->ysort_children_count == -1) {
-			ci->ysort_children_count = 0;
-			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), nullptr, ci->ysort_children_count);
-		}
+		_update_ysort_children(ci, p_material_owner);
 
-		child_item_count = ci->ysort_children_count;
-
-		// NOTE : Use of alloca here in a recursive function could make it susceptible to stack overflow.
-		// This was present in the original Item code. Consider changing to make safer.
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
-
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
-
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+		child_items = ci->ysort_children.ptr();
+		child_item_count = ci->ysort_children.size();
 	}
 
 	if (ci->z_relative) {
@@ -736,8 +941,28 @@ void RenderingServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p
 					_render_canvas_item_cull_by_node(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false);
 				}
 			} else {
-				for (int i = 0; i < l; i++) {
-					_render_canvas_item_cull_by_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+				bool culled_by_index = false;
+
+				if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH && l >= CULL_INDEX_CHILD_COUNT_MIN) {
+					if (!p_canvas->child_cull_index) {
+						p_canvas->child_cull_index = memnew(ChildCullIndex);
+						for (int i = 0; i < l; i++) {
+							_cull_index_update_child(p_canvas->child_cull_index, ci[i].item);
+						}
+					}
+
+					culled_by_index = _cull_index_query(p_canvas->child_cull_index, p_transform, p_clip_rect);
+				}
+
+				if (culled_by_index) {
+					const LocalVector<Item *> &results = p_canvas->child_cull_index->results;
+					for (uint32_t i = 0; i < results.size(); i++) {
+						_render_canvas_item_cull_by_item(results[i], p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+					}
+				} else {
+					for (int i = 0; i < l; i++) {
+						_render_canvas_item_cull_by_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
+					}
 				}
 			}
 		} // if not measure
@@ -837,6 +1062,10 @@ void RenderingServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 		if (canvas_owner.owns(canvas_item->parent)) {
 			Canvas *canvas = canvas_owner.get(canvas_item->parent);
 			canvas->erase_item(canvas_item);
+
+			if (canvas->child_cull_index) {
+				_cull_index_remove_child(canvas->child_cull_index, canvas_item);
+			}
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
@@ -844,6 +1073,13 @@ void RenderingServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+
+			if (item_owner->child_cull_index) {
+				_cull_index_remove_child(item_owner->child_cull_index, canvas_item);
+			}
+			if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH) {
+				_cull_index_mark_dirty(item_owner); // May be a leaf now.
+			}
 		}
 
 		canvas_item->parent = RID();
@@ -880,6 +1116,13 @@ void RenderingServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 
 	canvas_item->parent = p_parent;
 
+	if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH && p_parent.is_valid()) {
+		_cull_index_mark_dirty(canvas_item); // Added to the index of the new parent on its next query.
+		if (canvas_item_owner.owns(p_parent)) {
+			_cull_index_mark_dirty(canvas_item_owner.get(p_parent)); // Not a leaf anymore.
+		}
+	}
+
 	_check_bound_integrity(canvas_item);
 }
 void RenderingServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
@@ -927,6 +1170,10 @@ void RenderingServerCanvas::canvas_item_set_transform(RID p_item, const Transfor
 
 	canvas_item->xform_curr = p_transform;
 
+	if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH) {
+		_cull_index_mark_dirty(canvas_item);
+	}
+
 	// Special case!
 	// Modifying the transform DOES NOT affect the local bound.
 	// It only affects the local bound of the PARENT node (if there is one).
@@ -1637,7 +1884,15 @@ bool RenderingServerCanvas::free(RID p_rid) {
 		}
 
 		for (int i = 0; i < canvas->child_items.size(); i++) {
-			canvas->child_items[i].item->parent = RID();
+			Item *child = canvas->child_items[i].item;
+			child->parent = RID();
+			child->cull_handle = 0;
+			child->cull_unindexed = false;
+			child->cull_dirty = false;
+		}
+
+		if (canvas->child_cull_index) {
+			memdelete(canvas->child_cull_index);
 		}
 
 		canvas_owner.free(p_rid);
@@ -1653,6 +1908,10 @@ bool RenderingServerCanvas::free(RID p_rid) {
 			if (canvas_owner.owns(canvas_item->parent)) {
 				Canvas *canvas = canvas_owner.get(canvas_item->parent);
 				canvas->erase_item(canvas_item);
+
+				if (canvas->child_cull_index) {
+					_cull_index_remove_child(canvas->child_cull_index, canvas_item);
+				}
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
@@ -1660,12 +1919,27 @@ bool RenderingServerCanvas::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
 				}
+
+				if (item_owner->child_cull_index) {
+					_cull_index_remove_child(item_owner->child_cull_index, canvas_item);
+				}
+				if (_canvas_cull_mode == CANVAS_CULL_MODE_BVH) {
+					_cull_index_mark_dirty(item_owner); // May be a leaf now.
+				}
 				_check_bound_integrity(item_owner);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
-			canvas_item->child_items[i]->parent = RID();
+			Item *child = canvas_item->child_items[i];
+			child->parent = RID();
+			child->cull_handle = 0;
+			child->cull_unindexed = false;
+			child->cull_dirty = false;
+		}
+
+		if (canvas_item->child_cull_index) {
+			memdelete(canvas_item->child_cull_index);
 		}
 
 		/*
@@ -1828,7 +2102,7 @@ RenderingServerCanvas::RenderingServerCanvas() {
 	disable_scale = false;
 
 	int mode = GLOBAL_DEF("rendering/2d/options/culling_mode", 1);
-	ProjectSettings::get_singleton()->set_custom_property_info("rendering/2d/options/culling_mode", PropertyInfo(Variant::INT, "rendering/2d/options/culling_mode", PROPERTY_HINT_ENUM, "Item,Node"));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/2d/options/culling_mode", PropertyInfo(Variant::INT, "rendering/2d/options/culling_mode", PROPERTY_HINT_ENUM, "Item,Node,BVH"));
 
 	switch (mode) {
 		default: {
@@ -1837,6 +2111,9 @@ RenderingServerCanvas::RenderingServerCanvas() {
 		case 0: {
 			_canvas_cull_mode = CANVAS_CULL_MODE_ITEM;
 		} break;
+		case 2: {
+			_canvas_cull_mode = CANVAS_CULL_MODE_BVH;
+		} break;
 	}
 }
 
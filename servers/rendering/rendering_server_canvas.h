@@ -5,12 +5,16 @@
 /*  rendering_server_canvas.h                                               */
 
 
+#include "core/containers/local_vector.h"
+#include "core/math/bvh.h"
 #include "rasterizer.h"
 #include "rendering_server_constants.h"
 #include "rendering_server_viewport.h"
 
 class RenderingServerCanvas {
 public:
+	struct ChildCullIndex;
+
 	struct Item : public RasterizerCanvas::Item {
 		RID parent; // canvas it belongs to
 		List<Item *>::Element *E;
@@ -27,12 +31,19 @@ public:
 		Transform2D ysort_xform;
 		Vector2 ysort_pos;
 		int ysort_index;
+		LocalVector<Item *> ysort_children; // Sorted order of the last frame, only valid while ysort_children_count isn't -1.
 #ifdef RENDERING_SERVER_CANVAS_DEBUG_ITEM_NAMES
 		String name;
 #endif
 
 		Vector<Item *> child_items;
 
+		// BVH culling mode only.
+		ChildCullIndex *child_cull_index; // Created once the item has enough children.
+		uint32_t cull_handle; // Handle in the index of the parent plus one, zero when not in its tree.
+		bool cull_unindexed; // In the unindexed list of the parent.
+		bool cull_dirty; // In the dirty list of the parent.
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -47,9 +58,40 @@ public:
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
 			ysort_index = 0;
+			child_cull_index = nullptr;
+			cull_handle = 0;
+			cull_unindexed = false;
+			cull_dirty = false;
+		}
+	};
+
+	template <class T>
+	class CullIndexPairTestFunction {
+	public:
+		static bool user_pair_check(const T *p_a, const T *p_b) {
+			return false; // Never paired.
 		}
 	};
 
+	template <class T>
+	class CullIndexCullTestFunction {
+	public:
+		static bool user_cull_check(const T *p_a, const T *p_b) {
+			return true;
+		}
+	};
+
+	// Spatial index of the children of an item or a canvas, using their bounds in the space of the parent.
+	// Children that can't be culled by their own rect (they have children, clip, copy the back buffer...)
+	// are kept aside and always traversed.
+	struct ChildCullIndex {
+		BVH_Manager<Item, 1, false, 256, CullIndexPairTestFunction<Item>, CullIndexCullTestFunction<Item>, Rect2, Vector2, false> bvh;
+		uint32_t indexed_count = 0;
+		LocalVector<Item *> unindexed;
+		LocalVector<Item *> dirty;
+		LocalVector<Item *> results; // Children that passed the last query, in drawing order.
+	};
+
 	struct ItemIndexSort {
 		_FORCE_INLINE_ bool operator()(const Item *p_left, const Item *p_right) const {
 			return p_left->index < p_right->index;
@@ -81,6 +123,7 @@ public:
 		Color modulate;
 		RID parent;
 		float parent_scale;
+		ChildCullIndex *child_cull_index; // BVH culling mode only.
 
 		int find_item(Item *p_item) {
 			for (int i = 0; i < child_items.size(); i++) {
@@ -101,6 +144,7 @@ public:
 			modulate = Color(1, 1, 1, 1);
 			children_order_dirty = true;
 			parent_scale = 1.0;
+			child_cull_index = nullptr;
 		}
 	};
 
@@ -113,6 +157,12 @@ private:
 	enum CanvasCullMode {
 		CANVAS_CULL_MODE_ITEM,
 		CANVAS_CULL_MODE_NODE,
+		CANVAS_CULL_MODE_BVH,
+	};
+
+	enum {
+		CULL_INDEX_CHILD_COUNT_MIN = 128, // Parents with fewer children just test all of them.
+		YSORT_SHIFTS_PER_ITEM_MAX = 8, // Past this the order changed too much for an insertion sort, sort it from scratch.
 	};
 	CanvasCullMode _canvas_cull_mode;
 
@@ -130,6 +180,23 @@ private:
 	// Hierarchical culling by scene tree node ///////////////////////////////////
 	void _render_canvas_item_cull_by_node(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_enclosed);
 
+	// Y sorting ///////////////////////////////////////////////////////////////
+	struct YSortInfo {
+		uint64_t items_sorted = 0;
+		uint64_t items_moved = 0;
+	};
+	YSortInfo ysort_info;
+	YSortInfo ysort_info_final; // Last complete frame.
+
+	void _update_ysort_children(Item *p_canvas_item, Item *p_material_owner);
+
+	// Culling with a spatial index of the children //////////////////////////////
+	bool _is_cull_index_leaf(const Item *p_item) const;
+	void _cull_index_update_child(ChildCullIndex *p_index, Item *p_child);
+	void _cull_index_mark_dirty(Item *p_item);
+	void _cull_index_remove_child(ChildCullIndex *p_index, Item *p_child);
+	bool _cull_index_query(ChildCullIndex *p_index, const Transform2D &p_xform, const Rect2 &p_clip_rect);
+
 	void _prepare_tree_bounds(Item *p_root);
 	void _calculate_canvas_item_bound(Item *p_canvas_item, Rect2 *r_branch_bound);
 
@@ -157,6 +224,9 @@ private:
 	//////////////////////////////////////////////////////////////////////////////
 
 public:
+	void ysort_info_end_frame();
+	uint64_t get_ysort_info(RS::RenderInfo p_info) const;
+
 	void render_canvas(Canvas *p_canvas, const Transform2D &p_transform, const Rect2 &p_clip_rect, int p_canvas_layer_id);
 
 	RID canvas_create();
@@ -78,6 +78,7 @@ void RenderingServerRaster::draw(bool p_swap_buffers, double frame_step) {
 	RSG::rasterizer->begin_frame(frame_step);
 
 	RSG::viewport->draw_viewports();
+	RSG::canvas->ysort_info_end_frame();
 	_draw_margins();
 	RSG::rasterizer->end_frame(p_swap_buffers);
 
@@ -134,7 +135,13 @@ void RenderingServerRaster::finish() {
 /* STATUS INFORMATION */
 
 uint64_t RenderingServerRaster::get_render_info(RenderInfo p_info) {
-	return RSG::storage->get_render_info(p_info);
+	switch (p_info) {
+		case INFO_2D_YSORT_ITEMS_SORTED_IN_FRAME:
+		case INFO_2D_YSORT_ITEMS_MOVED_IN_FRAME:
+			return RSG::canvas->get_ysort_info(p_info);
+		default:
+			return RSG::storage->get_render_info(p_info);
+	}
 }
 
 String RenderingServerRaster::get_video_adapter_name() const {
@@ -170,6 +170,8 @@ public:
 	BIND2C(shader_get_custom_defines, RID, Vector<String> *)
 	BIND2(shader_remove_custom_define, RID, const String &)
 
+	BIND1(shader_warm_up, RID)
+
 	BIND1(set_shader_async_hidden_forbidden, bool)
 
 	/* COMMON MATERIAL API */
@@ -1401,6 +1401,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("shader_get_param_list", "shader"), &RenderingServer::_shader_get_param_list_bind);
 	ClassDB::bind_method(D_METHOD("shader_set_default_texture_param", "shader", "name", "texture"), &RenderingServer::shader_set_default_texture_param);
 	ClassDB::bind_method(D_METHOD("shader_get_default_texture_param", "shader", "name"), &RenderingServer::shader_get_default_texture_param);
+	ClassDB::bind_method(D_METHOD("shader_warm_up", "shader"), &RenderingServer::shader_warm_up);
 	ClassDB::bind_method(D_METHOD("set_shader_async_hidden_forbidden", "forbidden"), &RenderingServer::set_shader_async_hidden_forbidden);
 
 	ClassDB::bind_method(D_METHOD("material_create"), &RenderingServer::material_create);
@@ -1693,6 +1694,8 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_2D_YSORT_ITEMS_SORTED_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_YSORT_ITEMS_MOVED_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -1839,6 +1842,10 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF_RST("rendering/batching/options/use_batching_in_editor", true);
 	GLOBAL_DEF("rendering/batching/options/single_rect_fallback", false);
 	GLOBAL_DEF("rendering/batching/options/use_multirect", true);
+	GLOBAL_DEF_RST("rendering/batching/options/use_texture_atlas", false);
+	GLOBAL_DEF_RST("rendering/batching/texture_atlas/page_size", 1024);
+	GLOBAL_DEF_RST("rendering/batching/texture_atlas/max_pages", 4);
+	GLOBAL_DEF_RST("rendering/batching/texture_atlas/max_texture_size", 128);
 	GLOBAL_DEF("rendering/batching/parameters/max_join_item_commands", 16);
 	GLOBAL_DEF("rendering/batching/parameters/colored_vertex_format_threshold", 0.25f);
 	GLOBAL_DEF("rendering/batching/lights/scissor_area_threshold", 1.0f);
@@ -1850,6 +1857,10 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/gles2/compatibility/disable_half_float", false);
 	GLOBAL_DEF("rendering/gles2/compatibility/disable_half_float.iOS", true);
 	GLOBAL_DEF("rendering/gles2/compatibility/enable_high_float.Android", false);
+	GLOBAL_DEF_RST("rendering/gles2/shader_cache/enabled", true);
+	GLOBAL_DEF_RST("rendering/gles2/shader_cache/use_program_binaries", true);
+	GLOBAL_DEF_RST("rendering/gles2/shader_cache/max_size_mb", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/gles2/shader_cache/max_size_mb", PropertyInfo(Variant::INT, "rendering/gles2/shader_cache/max_size_mb", PROPERTY_HINT_RANGE, "8,1024,8,or_greater"));
 	GLOBAL_DEF("rendering/batching/precision/uv_contract", false);
 	GLOBAL_DEF("rendering/batching/precision/uv_contract_amount", 100);
 
@@ -1859,6 +1870,9 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/lights/scissor_area_threshold", PropertyInfo(Variant::REAL, "rendering/batching/lights/scissor_area_threshold", PROPERTY_HINT_RANGE, "0.0,1.0"));
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/lights/max_join_items", PropertyInfo(Variant::INT, "rendering/batching/lights/max_join_items", PROPERTY_HINT_RANGE, "0,512"));
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/parameters/item_reordering_lookahead", PropertyInfo(Variant::INT, "rendering/batching/parameters/item_reordering_lookahead", PROPERTY_HINT_RANGE, "0,256"));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/texture_atlas/page_size", PropertyInfo(Variant::INT, "rendering/batching/texture_atlas/page_size", PROPERTY_HINT_RANGE, "256,4096"));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/texture_atlas/max_pages", PropertyInfo(Variant::INT, "rendering/batching/texture_atlas/max_pages", PROPERTY_HINT_RANGE, "1,64"));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/texture_atlas/max_texture_size", PropertyInfo(Variant::INT, "rendering/batching/texture_atlas/max_texture_size", PROPERTY_HINT_RANGE, "8,1024"));
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/batching/precision/uv_contract_amount", PropertyInfo(Variant::INT, "rendering/batching/precision/uv_contract_amount", PROPERTY_HINT_RANGE, "0,10000"));
 
 	// Portal rendering settings